@@ -0,0 +1,314 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  config.c - Persistent configuration & calibration.
+//
+//
+//  DESCRIPTION
+//
+//      The console configuration (the freq. set, the modulator, GPS receiver,
+//  UBX, PPS estimator & GPSDO) is saved by SAVE; the calibration (GPSDO
+//  correction, the temperature it's of & the temperature model) is saved too, &
+//  once per eCfgAutoSaveMs while GPSDO is locked if SAVE AUTO ON. It's off by
+//  default: unless the worker of core1 runs from RAM only, the flash write
+//  parks core1, so the output stalls. SAVE AUTO is itself kept by the next
+//  save. All is kept by the key/value store of lib/kvstore.h in the top sectors
+//  of flash.
+//      At boot the store is loaded ere core1 is launched; core1 restores the freq.
+//  & the modulator ere its worker runs, then core0 restores GPS & warm starts
+//  GPSDO of the calibration, so the output is corrected at once.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//      Rev 0.2   17 Oct 2026   No park of core1 running from RAM, SAVE AUTO deferred.
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "./lib/assert.h"
+#include "./lib/kvstore.h"
+#include "./lib/kvflash.h"
+#include "piodco/piodco.h"
+#include "protos.h"
+
+enum
+{
+    eCfgKeyFreq = 1,            /* CfgFreq. */
+    eCfgKeyModulator = 2,       /* uint8_t, enum PioDcoModulator. */
+    eCfgKeyGpsRec = 3,          /* CfgGpsRec. */
+    eCfgKeyGpsUbx = 4,          /* uint8_t. */
+    eCfgKeyGpsEst = 5,          /* uint8_t, PPSestKind. */
+    eCfgKeyGpsdo = 6,           /* uint8_t. */
+    eCfgKeyAutoSave = 7,        /* uint8_t. */
+    eCfgKeyCalPPB = 16,         /* CfgCal. */
+    eCfgKeyCalTemp = 17,        /* The bins of temperature model. */
+
+    eCfgAutoSaveMs = 3600000    /* Calibration save period while locked. */
+};
+
+typedef struct
+{
+    uint32_t _ui32_frq_hz;      /* Working freq, Hz. */
+    int32_t _i32_frq_millihz;   /* Its additive shift, mHz. */
+    int32_t _harmonic;          /* The harmonic it's meant for. */
+
+} CfgFreq;
+
+typedef struct
+{
+    int32_t _uart_id;
+    int32_t _pps_gpio;
+    int32_t _uart_baudrate;
+
+} CfgGpsRec;
+
+typedef struct
+{
+    int64_t _i64_ppb;           /* GPSDO correction, ppb. */
+    int32_t _i32_mdeg;          /* The temperature of it, mC. */
+    int32_t _i32_reserved;
+
+} CfgCal;
+
+static KVstore sKV;
+static int siIsLoaded;
+static uint64_t su64SavedUs;
+
+/// @brief Loads the configuration of flash.
+/// @return 0 if it's there, 1 if none.
+/// @attention It's to be called ere core1 is launched.
+int ConfigLoad(void)
+{
+    KVflash flash;
+    KVflashPico(&flash);
+
+    const int ires = KVstoreOpen(&sKV, &flash);
+    siIsLoaded = 1;
+
+    return ires;
+}
+
+/// @brief Restores the freq. & the modulator saved, by the core of DCO worker.
+/// @param pdco Ptr to DCO context.
+void ConfigRestoreDCO(PioDco *pdco)
+{
+    assert_(pdco);
+
+    uint8_t u8v;
+    if(!KVstoreGet(&sKV, eCfgKeyModulator, &u8v, sizeof(u8v)))
+    {
+        PioDCOSetModulator(pdco, (enum PioDcoModulator)u8v);
+    }
+
+    CfgFreq frq;
+    if(KVstoreGet(&sKV, eCfgKeyFreq, &frq, sizeof(frq)))
+    {
+        return;
+    }
+    if(frq._harmonic > 1)
+    {
+        const uint64_t u64target = (1000ULL * frq._ui32_frq_hz + frq._i32_frq_millihz) * frq._harmonic;
+        PioDCOSetFreqHarmonic(pdco, (uint32_t)(u64target / 1000U), (int32_t)(u64target % 1000U), NULL);
+    }
+    else
+    {
+        PioDCOSetFreq(pdco, frq._ui32_frq_hz, frq._i32_frq_millihz);
+    }
+}
+
+/// @brief Restores GPS & GPSDO saved, by core0, and warm starts GPSDO of the calibration.
+/// @param pdco Ptr to DCO context.
+void ConfigRestore(PioDco *pdco)
+{
+    assert_(pdco);
+
+    CfgGpsRec rec;
+    if(!KVstoreGet(&sKV, eCfgKeyGpsRec, &rec, sizeof(rec)))
+    {
+        pdco->_pGPStime = GPStimeInit(rec._uart_id, rec._uart_baudrate, rec._pps_gpio);
+        uint8_t u8v;
+        if(pdco->_pGPStime && !KVstoreGet(&sKV, eCfgKeyGpsEst, &u8v, sizeof(u8v)))
+        {
+            GPStimeSetEstimator(pdco->_pGPStime, (PPSestKind)u8v);
+        }
+        if(pdco->_pGPStime && !KVstoreGet(&sKV, eCfgKeyGpsUbx, &u8v, sizeof(u8v)) && u8v)
+        {
+            GPStimeConfigUBX(pdco->_pGPStime, 1);
+        }
+    }
+
+    uint8_t u8gpsdo;
+    if(KVstoreGet(&sKV, eCfgKeyGpsdo, &u8gpsdo, sizeof(u8gpsdo)) || !u8gpsdo)
+    {
+        return;
+    }
+    PioDCOSetMode(pdco, eDCOMODE_GPS_COMPENSATED);
+
+    PioDcoTempModel *pm = &pdco->_gpsdo._temp;
+    KVstoreGet(&sKV, eCfgKeyCalTemp, pm->_bins, sizeof(pm->_bins));
+
+    CfgCal cal;
+    if(!KVstoreGet(&sKV, eCfgKeyCalPPB, &cal, sizeof(cal)))
+    {
+        PioDCOGpsdoWarmStart(pdco, cal._i64_ppb, cal._i32_mdeg);
+        printf("\nGPSDO warm start %lld ppb at %ld mC", cal._i64_ppb, (long)cal._i32_mdeg);
+    }
+}
+
+/// @brief Takes the calibration to the store, if GPSDO is locked.
+static void ConfigSetCal(const PioDco *pdco)
+{
+    const PioDcoGpsdo *pg = &pdco->_gpsdo;
+    if(eDCOGPSDO_LOCKED != pg->_state)
+    {
+        return;
+    }
+
+    CfgCal cal = { pg->_i64_ppb, PioDCOTempNow(&pg->_temp), 0 };
+    KVstoreSet(&sKV, eCfgKeyCalPPB, &cal, sizeof(cal));
+    if(PioDCOTempBinsUsed(&pg->_temp))
+    {
+        KVstoreSet(&sKV, eCfgKeyCalTemp, pg->_temp._bins, sizeof(pg->_temp._bins));
+    }
+}
+
+/// @brief Writes the store, core1 is parked meanwhile unless its worker runs from
+/// @brief RAM only.
+/// @param pdco Ptr to DCO context.
+/// @return 0 if written, 1 if nothing has changed, -1 flash error.
+static int ConfigCommit(const PioDco *pdco)
+{
+    KVflashPicoParkOther(!pdco->_is_in_ram);
+
+    return KVstoreCommit(&sKV);
+}
+
+/// @brief Saves the configuration & the calibration, SAVE AUTO too.
+/// @param pdco Ptr to DCO context.
+/// @return 0 if written, 1 if nothing has changed, -1 flash error.
+/// @attention Unless the worker runs from RAM only, the DCO output stalls for a few
+/// @attention ms, or ~50 ms if a sector is erased.
+int ConfigSave(const PioDco *pdco)
+{
+    assert_(pdco);
+    assert_(siIsLoaded);
+
+    const CfgFreq frq = { pdco->_ui32_frq_hz, pdco->_ui32_frq_millihz, pdco->_harmonic };
+    KVstoreSet(&sKV, eCfgKeyFreq, &frq, sizeof(frq));
+    const uint8_t u8mod = pdco->_ctl._modulator;
+    KVstoreSet(&sKV, eCfgKeyModulator, &u8mod, sizeof(u8mod));
+    const uint8_t u8gpsdo = eDCOMODE_GPS_COMPENSATED == pdco->_mode;
+    KVstoreSet(&sKV, eCfgKeyGpsdo, &u8gpsdo, sizeof(u8gpsdo));
+
+    const GPStimeContext *pgps = pdco->_pGPStime;
+    if(pgps)
+    {
+        const CfgGpsRec rec = { pgps->_uart_id, pgps->_pps_gpio, pgps->_uart_baudrate };
+        KVstoreSet(&sKV, eCfgKeyGpsRec, &rec, sizeof(rec));
+        const uint8_t u8ubx = pgps->_u8_is_ubx;
+        KVstoreSet(&sKV, eCfgKeyGpsUbx, &u8ubx, sizeof(u8ubx));
+        const uint8_t u8est = pgps->_pps_est._kind;
+        KVstoreSet(&sKV, eCfgKeyGpsEst, &u8est, sizeof(u8est));
+    }
+    else
+    {
+        KVstoreDelete(&sKV, eCfgKeyGpsRec);
+    }
+
+    ConfigSetCal(pdco);
+    su64SavedUs = time_us_64();
+
+    return ConfigCommit(pdco);
+}
+
+/// @brief Switches the periodic save of the calibration. It's in effect at once &
+/// @brief is kept by the next save, no flash is written here.
+/// @param is_on 1 to switch it on.
+void ConfigSetAutoSave(int is_on)
+{
+    const uint8_t u8v = is_on ? 1 : 0;
+    KVstoreSet(&sKV, eCfgKeyAutoSave, &u8v, sizeof(u8v));
+}
+
+/// @brief Checks the periodic save of the calibration is on. It's off by default,
+/// @brief as the flash write may stall the output.
+/// @return 1 if it's on.
+int ConfigIsAutoSave(void)
+{
+    uint8_t u8v = 0;
+    KVstoreGet(&sKV, eCfgKeyAutoSave, &u8v, sizeof(u8v));
+
+    return u8v;
+}
+
+/// @brief Wipes the configuration & the calibration, the defaults are used at boot.
+/// @return 0 if OK. -1 flash error.
+int ConfigClear(void)
+{
+    KVstoreClear(&sKV);
+
+    return KVstoreCommit(&sKV) < 0 ? -1 : 0;
+}
+
+/// @brief Saves the calibration once per eCfgAutoSaveMs while GPSDO is locked, if
+/// @brief SAVE AUTO ON.
+/// @param pdco Ptr to DCO context.
+/// @attention It ought to be called periodically by core0.
+void ConfigPoll(const PioDco *pdco)
+{
+    assert_(pdco);
+
+    const uint64_t u64now = time_us_64();
+    if(!siIsLoaded || eDCOGPSDO_LOCKED != pdco->_gpsdo._state
+       || u64now - su64SavedUs < eCfgAutoSaveMs * 1000ULL || !ConfigIsAutoSave())
+    {
+        return;
+    }
+
+    su64SavedUs = u64now;
+    ConfigSetCal(pdco);
+    ConfigCommit(pdco);
+}
+
+/// @brief Obtains the store, for its telemetry.
+/// @return Ptr to the store.
+const KVstore *ConfigStore(void)
+{
+    return &sKV;
+}
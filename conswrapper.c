@@ -54,10 +54,22 @@
 
 extern PioDco DCO;
 
+static uint32_t sui32MeasureGateMs;     /* The gate of MEASURE in progress, 0 if none. */
+
 /// @brief Console commands manager. Currently available:
 /// @brief HELP             - Usage.
 /// @brief SETFREQ f        - Set oscillator output frequency in Hz.
 /// @brief SWITCH ON/OFF    - Switch output to ON or OFF state.
+/// @brief SETMOD FIRST/MASH/HIRES - Select cycle count modulator.
+/// @brief RAMP f1,f2,ms[,mode]/OFF - Sweep output frequency.
+/// @brief SETHARM f        - Set output frequency to be reached by odd harmonic.
+/// @brief EVENT ms,f        - Switch output frequency at the tick ms ahead.
+/// @brief MEASURE [ms]     - Measure output frequency by counting its edges.
+/// @brief BENCH            - Time the worker loops, cycles per word & top freq.
+/// @brief GPSUBX ON/OFF    - Switch UBX binary messages of u-blox receiver.
+/// @brief GPSEST KALMAN/WINDOW - Select the estimator of CPU CLK error of PPS.
+/// @brief GPSDO ON/OFF     - Switch GPS disciplining of output frequency.
+/// @brief SAVE [AUTO ON/OFF/CLEAR] - Save configuration & calibration to flash.
 /// @param cmd Ptr to command.
 /// @param narg Argument count.
 /// @param params Command params, full string.
@@ -84,9 +96,43 @@ void ConsoleCommandsWrapper(char *cmd, int narg, char *params)
         printf("  SWITCH s - enable/disable generation.\n");
         printf("  example: SWITCH ON - enable generation.\n");
         printf("-\n");
+        printf("  SETMOD m - select cycle count modulator, FIRST, MASH or HIRES.\n");
+        printf("  example: SETMOD MASH - MASH 1-1-1 with low close-in spurs.\n");
+        printf("  example: SETMOD HIRES - first order of sub-millihertz resolution.\n");
+        printf("-\n");
+        printf("  SETHARM f - set frequency f in Hz to be reached by 1st, 3rd, 5th or 7th harmonic.\n");
+        printf("  example: SETHARM 144174000 - 2m FT8 by the 5th harmonic of 28834800 Hz.\n");
+        printf("-\n");
+        printf("  RAMP OFF/f1,f2,ms[,mode] - sweep output frequency from f1 to f2 Hz in ms, mode ONCE, REPEAT or TRI.\n");
+        printf("  example: RAMP 7000000,7200000,10000,TRI - sweep 40m band up & down, 10 s each way.\n");
+        printf("  example: RAMP OFF - stop the sweep at the frequency reached.\n");
+        printf("-\n");
+        printf("  EVENT ms,f - switch output frequency to f Hz in ms, at a PIO word boundary.\n");
+        printf("  example: EVENT 1000,7040000 - up to 1 output cycle early, ~1.3 late at 20 MHz, ~2.1 with MASH.\n");
+        printf("-\n");
+        printf("  MEASURE [ms] - measure output frequency over the gate of ms, 1000 by default.\n");
+        printf("  example: MEASURE 10000 - 10 s gate, 0.1 Hz resolution, printed when the gate closes.\n");
+        printf("-\n");
+        printf("  BENCH - time every worker loop at the frequency set, CPU CLK cycles per word & the top frequency.\n");
+        printf("-\n");
         printf("  GPSREC OFF/uart_id,pps_pin,baud - enable/disable GPS receiver connection.\n");
         printf("  example: GPSREC 0,3,9600 - enable GPS receiver connection with UART0 & PPS on gpio3, 9600 baud port speed.\n");
         printf("  example: GPSREC OFF - disable GPS receiver connection.\n");
+        printf("-\n");
+        printf("  GPSUBX ON/OFF - switch UBX timing messages of u-blox receiver on & bulky NMEA off, or back.\n");
+        printf("  example: GPSUBX ON - PPS is corrected by TIM-TP qErr.\n");
+        printf("-\n");
+        printf("  GPSEST e - select the estimator of CPU CLK error of PPS, KALMAN or WINDOW, it restarts.\n");
+        printf("  example: GPSEST KALMAN - phase & frequency filter, the first estimate at the second pulse.\n");
+        printf("  example: GPSEST WINDOW - the legacy 32 s window & low pass.\n");
+        printf("-\n");
+        printf("  GPSDO ON/OFF - correct output frequency by CPU CLK error of GPS, or not.\n");
+        printf("  example: GPSDO ON - slewed to the estimate, held over if PPS or fix is lost.\n");
+        printf("-\n");
+        printf("  SAVE [AUTO ON/OFF/CLEAR] - save configuration & GPSDO calibration to flash, restored at boot.\n");
+        printf("  example: SAVE - the output stalls for up to 50 ms, unless the worker runs from RAM.\n");
+        printf("  example: SAVE AUTO ON - save calibration hourly while GPSDO is locked, off by default, kept by SAVE.\n");
+        printf("  example: SAVE CLEAR - the defaults at boot.\n");
         return;
     } else if(strstr(cmd, "SETFREQ"))
     {
@@ -129,6 +175,263 @@ void ConsoleCommandsWrapper(char *cmd, int narg, char *params)
             printf("\nOutput is disabled");
             return;
         }
+    } else if(strstr(cmd, "SETMOD"))
+    {
+        if(2 != narg)
+        {
+            PushErrorMessage(-1);
+            return;
+        }
+        if(strstr(params, "MASH"))
+        {
+            PioDCOSetModulator(&DCO, eDCOMOD_MASH111);
+            printf("\nModulator is MASH 1-1-1");
+            return;
+        } else if(strstr(params, "HIRES"))
+        {
+            PioDCOSetModulator(&DCO, eDCOMOD_HIRES);
+            printf("\nModulator is first order of high resolution");
+            return;
+        } else if(strstr(params, "FIRST"))
+        {
+            PioDCOSetModulator(&DCO, eDCOMOD_FIRST_ORDER);
+            printf("\nModulator is first order");
+            return;
+        }
+
+        PushErrorMessage(-1);
+        return;
+
+    } else if(strstr(cmd, "SETHARM"))
+    {
+        if(2 != narg)
+        {
+            PushErrorMessage(-1);
+            return;
+        }
+
+        PioDcoPlan plan;
+        const uint32_t ui32frq = atol(params);
+        if(PioDCOSetFreqHarmonic(&DCO, ui32frq, 0, &plan))
+        {
+            PushErrorMessage(-11);
+            return;
+        }
+
+        printf("\nFrequency is set to %lu Hz by harmonic %d of %lu Hz + %ld milliHz",
+               ui32frq, plan._harmonic, plan._ui32_fund_hz, plan._i32_fund_millihz);
+        printf("\nStep %lu uHz, TIE %lu ps, phase jitter %lu mdeg p-p, level %d.%d dB",
+               plan._ui32_step_uhz, plan._ui32_tie_ps, plan._ui32_phase_pp_mdeg,
+               plan._level_db10 / 10, (plan._level_db10 < 0 ? -plan._level_db10 : plan._level_db10) % 10);
+        return;
+
+    } else if(strstr(cmd, "RAMP"))
+    {
+        if(2 == narg && strstr(params, "OFF"))
+        {
+            PioDCORampStop(&DCO);
+            printf("\nRamp is stopped");
+            return;
+        }
+        if(4 != narg && 5 != narg)
+        {
+            PushErrorMessage(-1);
+            return;
+        }
+
+        char *p = params;
+        const uint32_t ui32frq1 = atol(p);
+        p += strlen(p) + 1;
+        const uint32_t ui32frq2 = atol(p);
+        p += strlen(p) + 1;
+        const uint32_t ui32ms = atol(p);
+
+        enum PioDcoRampMode emode = eDCORAMP_ONCE;
+        if(5 == narg)
+        {
+            p += strlen(p) + 1;
+            if(strstr(p, "REPEAT"))
+            {
+                emode = eDCORAMP_REPEAT;
+            } else if(strstr(p, "TRI"))
+            {
+                emode = eDCORAMP_TRIANGLE;
+            } else if(!strstr(p, "ONCE"))
+            {
+                PushErrorMessage(-1);
+                return;
+            }
+        }
+
+        if(ui32frq1 < 1000000L || ui32frq1 > 32333333 || ui32frq2 < 1000000L || ui32frq2 > 32333333)
+        {
+            PushErrorMessage(-11);
+            return;
+        }
+
+        if(PioDCORampStart(&DCO, ui32frq1, ui32frq2, ui32ms, emode))
+        {
+            PushErrorMessage(-1);
+            return;
+        }
+        printf("\nRamp %lu to %lu Hz in %lu ms is started", ui32frq1, ui32frq2, ui32ms);
+        return;
+
+    } else if(strstr(cmd, "EVENT"))
+    {
+        if(3 != narg)
+        {
+            PushErrorMessage(-1);
+            return;
+        }
+
+        char *p = params;
+        const uint32_t ui32ms = atol(p);
+        p += strlen(p) + 1;
+        const uint32_t ui32frq = atol(p);
+        if(ui32frq < 1000000L || ui32frq > 32333333)
+        {
+            PushErrorMessage(-11);
+            return;
+        }
+
+        const uint64_t u64tick = PioDCOTickFromUs(&DCO, time_us_64() + 1000ULL * ui32ms);
+        if(PioDCOEventPush(&DCO, u64tick, ui32frq, 0))
+        {
+            PushErrorMessage(-1);
+            return;
+        }
+        printf("\nSwitch to %lu Hz in %lu ms is queued", ui32frq, ui32ms);
+        return;
+
+    } else if(strstr(cmd, "MEASURE"))
+    {
+        const uint32_t ui32ms = 2 == narg ? atol(params) : 1000UL;
+        if(PioDCOMeasureStart(&DCO, ui32ms))
+        {
+            PushErrorMessage(-1);
+            return;
+        }
+
+        sui32MeasureGateMs = ui32ms;
+        printf("\nMeasuring over %lu ms", ui32ms);
+        return;
+
+    } else if(strstr(cmd, "BENCH"))
+    {
+        static const char *kloops[] = { "first order", "MASH 1-1-1", "high resolution",
+                                        "generic (ramp)" };
+        for(int i = eDCOLOOP_FIRST_ORDER; i <= eDCOLOOP_GENERIC; ++i)
+        {
+            const uint32_t ui32c100 = PioDCOBench(&DCO, (enum PioDcoLoop)i);
+            const uint32_t ui32top_khz = ui32c100 ? (uint32_t)(2ULL * 100ULL * DCO._clkfreq_hz
+                                                               / 1000ULL / ui32c100) : 0;
+            printf("\nLoop %-16s %3lu.%02lu cycles per word, top %lu.%03lu MHz", kloops[i],
+                   ui32c100 / 100UL, ui32c100 % 100UL, ui32top_khz / 1000UL, ui32top_khz % 1000UL);
+        }
+        return;
+
+    } else if(strstr(cmd, "GPSUBX"))
+    {
+        if(!DCO._pGPStime)
+        {
+            printf("\nGPS subsystem hasn't been initialized.");
+            return;
+        }
+        if(2 != narg || (!strstr(params, "ON") && !strstr(params, "OFF")))
+        {
+            PushErrorMessage(-1);
+            return;
+        }
+
+        GPStimeConfigUBX(DCO._pGPStime, NULL != strstr(params, "ON"));
+        printf("\nGPS UBX messages are switched %s", DCO._pGPStime->_u8_is_ubx ? "ON" : "OFF");
+        return;
+
+    } else if(strstr(cmd, "GPSEST"))
+    {
+        if(!DCO._pGPStime)
+        {
+            printf("\nGPS subsystem hasn't been initialized.");
+            return;
+        }
+
+        if(2 != narg)
+        {
+            PushErrorMessage(-1);
+            return;
+        }
+        if(strstr(params, "KALMAN"))
+        {
+            GPStimeSetEstimator(DCO._pGPStime, ePPSestKalman);
+        } else if(strstr(params, "WINDOW"))
+        {
+            GPStimeSetEstimator(DCO._pGPStime, ePPSestWindow);
+        }
+        else
+        {
+            PushErrorMessage(-1);
+            return;
+        }
+
+        printf("\nGPS PPS estimator is %s", PPSestKindName(DCO._pGPStime->_pps_est._kind));
+        return;
+
+    } else if(strstr(cmd, "GPSDO"))
+    {
+        if(2 != narg)
+        {
+            PushErrorMessage(-1);
+            return;
+        }
+
+        const int is_enabled = DCO._is_enabled;
+        if(strstr(params, "ON"))
+        {
+            PioDCOSetMode(&DCO, eDCOMODE_GPS_COMPENSATED);
+        } else if(strstr(params, "OFF"))
+        {
+            PioDCOSetMode(&DCO, eDCOMODE_RUNNING);
+        }
+        else
+        {
+            PushErrorMessage(-1);
+            return;
+        }
+        if(!is_enabled)
+        {
+            PioDCOStop(&DCO);   /* The mode is switched, the output is not. */
+        }
+
+        printf("\nGPS disciplining is %s%s", eDCOMODE_GPS_COMPENSATED == DCO._mode ? "ON" : "OFF",
+               eDCOMODE_GPS_COMPENSATED == DCO._mode && !DCO._pGPStime ? ", waiting for GPSREC" : "");
+        return;
+
+    } else if(strstr(cmd, "SAVE"))
+    {
+        if(0 == narg)
+        {
+            const int ires = ConfigSave(&DCO);
+            printf("\nConfiguration %s", ires < 0 ? "save FAILED" : ires ? "unchanged" : "saved");
+            return;
+        } else if(3 == narg && strstr(params, "AUTO"))
+        {
+            char *p = params + strlen(params) + 1;
+            if(strstr(p, "ON") || strstr(p, "OFF"))
+            {
+                ConfigSetAutoSave(NULL != strstr(p, "ON"));
+                printf("\nCalibration auto save is %s, SAVE to keep it", ConfigIsAutoSave() ? "ON" : "OFF");
+                return;
+            }
+        } else if(2 == narg && strstr(params, "CLEAR"))
+        {
+            printf("\nConfiguration %s", ConfigClear() ? "clear FAILED" : "cleared");
+            return;
+        }
+
+        PushErrorMessage(-1);
+        return;
+
     } else if(strstr(cmd, "GPSREC"))
     {
         if(4 == narg)
@@ -183,6 +486,23 @@ void ConsoleCommandsWrapper(char *cmd, int narg, char *params)
     PushErrorMessage(-13);
 }
 
+/// @brief Prints the result of MEASURE once its gate is closed. It is polled by the
+/// @brief main loop, so GPS, GPSDO & the rest run while the gate is open.
+void ConsoleMeasurePoll(void)
+{
+    PioDcoMeas meas;
+    if(!sui32MeasureGateMs || PioDCOMeasureResult(&DCO, &meas))
+    {
+        return;
+    }
+
+    printf("\nMeasured %llu.%03llu Hz, error %lld ppb, resolution %lu ppb, gate %lu ms%s",
+           meas._u64_frq_millihz / 1000ULL, meas._u64_frq_millihz % 1000ULL,
+           meas._i64_err_ppb, meas._ui32_res_ppb, sui32MeasureGateMs,
+           DCO._pGPStime && DCO._pGPStime->_time_data._i32_freq_shift_ppb ? " by GPS" : "");
+    sui32MeasureGateMs = 0;
+}
+
 void PushErrorMessage(int id)
 {
     switch(id)
@@ -214,7 +534,61 @@ void PushStatusMessage(void)
     printf("\nPico-hf-oscillator system status\n");
     
     printf("Working freq: %lu Hz + %ld milliHz\n", DCO._ui32_frq_hz, DCO._ui32_frq_millihz);
+    if(DCO._harmonic > 1)
+    {
+        printf("Harmonic: %d\n", DCO._harmonic);
+    }
     
+    printf("Modulator: %s\n", eDCOMOD_MASH111 == DCO._ctl._modulator ? "MASH 1-1-1"
+                             : eDCOMOD_HIRES == DCO._ctl._modulator ? "first order, high resolution"
+                             : "first order");
+    if(DCO._ui32_replay_len)
+    {
+        printf("Replay: %lu words by DMA\n", (unsigned long)DCO._ui32_replay_len);
+    }
+
+    printf("PIO TX stalled polls: %lu\n", (unsigned long)PioDCOStatsPoll(&DCO));
+    if(DCO._dma_chan[0] >= 0)
+    {
+        printf("DMA late refills: %lu\n", (unsigned long)DCO._stats._ui32_dma_late);
+    }
+#if DCO_TELEMETRY
+    const PioDcoStats *pst = &DCO._stats;
+    printf("Worker loops: %lu, max %lu cycles but FIFO wait, word is %ld cycles\n",
+           (unsigned long)pst->_ui32_iterations, (unsigned long)pst->_ui32_max_cycles,
+           (long)(DCO._frq_cycles_per_pi >> 22));
+    printf("Worker loop cycles histogram:");
+    for(int i = 0; i < eDCOStatsHistLen; ++i)
+    {
+        if(pst->_ui32_hist[i])
+        {
+            printf(" %d+: %lu", 1 << i, (unsigned long)pst->_ui32_hist[i]);
+        }
+    }
+    printf("\n");
+#endif
+
+    static const char *spGpsdo[] = { "OFF", "WAIT", "LOCKED", "HOLDOVER" };
+    const PioDcoGpsdo *pgd = &DCO._gpsdo;
+    printf("GPSDO: %s, correction %lld ppb, updates %lu", spGpsdo[pgd->_state], pgd->_i64_ppb,
+           (unsigned long)pgd->_ui32_updates);
+    if(eDCOGPSDO_HOLDOVER == pgd->_state)
+    {
+        printf(", holdover %llu s, by temperature %lld ppb", (time_us_64() - pgd->_u64_holdover_us) / 1000000ULL,
+               pgd->_i64_hold_delta_ppb);
+    }
+    printf("\n");
+    if(pgd->_temp._ui32_samples)
+    {
+        printf("Temperature: %ld mC, model bins %d of %d\n", (long)PioDCOTempNow(&pgd->_temp),
+               PioDCOTempBinsUsed(&pgd->_temp), eDCOTempBins);
+    }
+
+    const KVstore *pkv = ConfigStore();
+    printf("Config store: snapshot %lu, commits %lu, erases %lu, errors %lu, auto save %s\n",
+           (unsigned long)pkv->_u32_seq, (unsigned long)pkv->_u32_commits, (unsigned long)pkv->_u32_erases,
+           (unsigned long)pkv->_u32_errors, ConfigIsAutoSave() ? "ON" : "OFF");
+
     printf("Output is ");
     if(DCO._is_enabled)
     {
@@ -231,10 +605,45 @@ void PushStatusMessage(void)
         printf("\nGPS UART baud %d", DCO._pGPStime->_uart_baudrate);
         printf("\nGPS PPS GPIO pin %d", DCO._pGPStime->_pps_gpio);
         printf("\nGPS error count %ld", DCO._pGPStime->_i32_error_count);
+        printf("\nGPS NMEA sentences %lu, RX overruns %lu", DCO._pGPStime->_rx._u32_sentences,
+               DCO._pGPStime->_rx._u32_overruns);
+        printf("\nGPS UBX %s, frames %lu, errors %lu, TIM-TP %lu, qErr %ld ps",
+               DCO._pGPStime->_u8_is_ubx ? "ON" : "OFF", DCO._pGPStime->_rx._ubx._u32_frames,
+               DCO._pGPStime->_rx._ubx._u32_errors, DCO._pGPStime->_time_data._u32_ubx_timtp_count,
+               DCO._pGPStime->_time_data._i32_qerr_next_ps);
         printf("\nGPS NAV solution flag %u", DCO._pGPStime->_time_data._u8_is_solution_active);
-        printf("\nGPS GPRMC receive count %u", DCO._pGPStime->_time_data._u32_nmea_gprmc_count);
-        printf("\nGPS PPS period %llu", DCO._pGPStime->_time_data._u64_pps_period_1M);
+        printf("\nGPS RMC receive count %u", DCO._pGPStime->_time_data._u32_nmea_gprmc_count);
+        printf("\nGPS fix mode %u, sats used %u, HDOP*100 %u", DCO._pGPStime->_time_data._u8_fix_mode,
+               DCO._pGPStime->_time_data._u8_sats_used, DCO._pGPStime->_time_data._u16_hdop_100);
+        if(DCO._pGPStime->_pps_sm >= 0)
+        {
+            printf("\nGPS PPS captured by PIO%u sm %d, pulses %lu",
+                   pio_get_index(DCO._pGPStime->_pps_pio), DCO._pGPStime->_pps_sm,
+                   DCO._pGPStime->_pps_cap._u32_pulses);
+        }
+        else
+        {
+            printf("\nGPS PPS timestamped by GPIO IRQ, 1 us");
+        }
+        const PPSestimator *pe = &DCO._pGPStime->_pps_est;
+        printf("\nGPS PPS estimator %s, intervals %lu, rejects %lu, sigma %lld.%03lld ppb%s",
+               PPSestKindName(pe->_kind), pe->_u32_intervals, pe->_u32_rejects,
+               pe->_i64_sigma_ppb_1k / 1000, pe->_i64_sigma_ppb_1k % 1000, pe->_u8_is_valid ? "" : ", no estimate yet");
         printf("\nGPS frequency correction %lld ppb", DCO._pGPStime->_time_data._i32_freq_shift_ppb);
+        uint64_t u64utc_us;
+        if(!GPStimeGetUTCus(DCO._pGPStime, &u64utc_us))
+        {
+            NMEAcivil cv;
+            NMEAunix2civil((uint32_t)(u64utc_us / 1000000), &cv);
+            printf("\nGPS UTC %04u-%02u-%02u %02u:%02u:%02u.%06lu of PPS, labels %lu, mismatches %lu",
+                   cv._u16_year, cv._u8_month, cv._u8_day, cv._u8_hour, cv._u8_min, cv._u8_sec,
+                   (uint32_t)(u64utc_us % 1000000), DCO._pGPStime->_utc._u32_labels,
+                   DCO._pGPStime->_utc._u32_mismatches);
+        }
+        else
+        {
+            printf("\nGPS UTC: no PPS labelled yet");
+        }
         printf("\nGPS lat %lld deg1e5", DCO._pGPStime->_time_data._i64_lat_100k);
         printf("\nGPS lon %lld deg1e5", DCO._pGPStime->_time_data._i64_lon_100k);
     }
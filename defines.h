@@ -51,6 +51,7 @@
 #define DEFINES_H
 
 #define DEBUGLOG 1
+#define DCO_TELEMETRY 0      /* Worker loop cycles & histogram, ~10 cycles/word. */
 
 #define FALSE 0                                     /* Something is false. */
 #define TRUE 1                                       /* Something is true. */
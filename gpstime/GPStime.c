@@ -31,6 +31,12 @@
 //  REVISION HISTORY
 // 
 //      Rev 0.1   25 Nov 2023   Initial release
+//      Rev 0.2   16 Oct 2026   NMEA is received by DMA into a ring buffer.
+//      Rev 0.3   16 Oct 2026   Zero-copy NMEA parser with checksum validation.
+//      Rev 0.4   16 Oct 2026   UBX protocol, TIM-TP qErr correction of PPS.
+//      Rev 0.5   16 Oct 2026   PPS timestamps captured by PIO.
+//      Rev 0.6   16 Oct 2026   Pluggable estimator of CPU CLK error, Kalman filter.
+//      Rev 0.7   16 Oct 2026   UTC in us aligned to PPS.
 //
 //  PROJECT PAGE
 //      https://github.com/RPiks/pico-hf-oscillator
@@ -59,10 +65,33 @@
 //  THE SOFTWARE.
 ///////////////////////////////////////////////////////////////////////////////
 #include "GPStime.h"
+#include "hardware/clocks.h"
+#include "dco2.pio.h"
 
 static GPStimeContext *spGPStimeContext = NULL;
 static GPStimeData *spGPStimeData = NULL;
 
+/* The ring of UART RX DMA, the alignment is required by DMA ring wrap. */
+static uint8_t su8GPSrxRing[eGPSrxRingLen] __attribute__((aligned(eGPSrxRingLen)));
+
+/* The transfer count of RX DMA (~6.5 hrs at 115200 baud). The upper bits of the
+   register are the mode on RP2350, so they are kept 0. */
+#define GPS_RX_DMA_COUNT 0x0FFFFFFFu
+
+static int GPStimeOnSentence(void *pctx, uint8_t *pline, uint32_t u32len);
+static int GPStimeOnUBX(void *pctx, const UBXparser *pu);
+static void GPStimeDrainPPS(GPStimeContext *pg);
+static void GPStimeTakePPS(GPStimeContext *pg);
+static void GPStimeEstimate(GPStimeContext *pg, int64_t i64dt_ps);
+static void GPStimeSnapshotPPS(const GPStimeData *pd, uint32_t *pu32count, uint64_t *pu64tm, int32_t *pi32qerr_ps);
+static void GPStimeLabelPPS(GPStimeContext *pg, uint32_t u32unix, uint32_t u32frac_us, uint64_t u64tm);
+
+/// @brief Converts degrees * 1e7 to degrees * 1e5, rounded.
+static inline int64_t GPStimeDeg1e7to1e5(int32_t i32deg_1e7)
+{
+    return (i32deg_1e7 + (i32deg_1e7 < 0 ? -50 : 50)) / 100;
+}
+
 /// @brief Initializes GPS time module Context.
 /// @param uart_id UART id to which GPS receiver is connected, 0 OR 1.
 /// @param uart_baud UART baudrate, 115200 max.
@@ -93,12 +122,34 @@ GPStimeContext *GPStimeInit(int uart_id, int uart_baud, int pps_gpio)
     gpio_set_dir(pps_gpio, GPIO_IN);
     gpio_set_irq_enabled_with_callback(pps_gpio, GPIO_IRQ_EDGE_RISE, true, &GPStimePPScallback);
 
+    /* PPS is timestamped by PIO if there's a spare state machine, by the ISR otherwise. */
+    uint sm;
+    pgt->_pps_sm = -1;
+    if(pio_claim_free_sm_and_add_program(&pps_capture_program, &pgt->_pps_pio, &sm, &pgt->_pps_offset))
+    {
+        PPScapInit(&pgt->_pps_cap, clock_get_hz(clk_sys));
+        pps_capture_program_init(pgt->_pps_pio, sm, pgt->_pps_offset, pps_gpio);
+        pgt->_pps_sm = sm;
+    }
+    GPStimeSetEstimator(pgt, ePPSestKalman);
+    UTCppsInit(&pgt->_utc);
+
     uart_set_hw_flow(uart_id ? uart1 : uart0, false, false);
     uart_set_format(uart_id ? uart1 : uart0, 8, 1, UART_PARITY_NONE);
-    uart_set_fifo_enabled(uart_id ? uart1 : uart0, false);
-    irq_set_exclusive_handler(uart_id ? UART1_IRQ : UART0_IRQ, GPStimeUartRxIsr);
-    irq_set_enabled(uart_id ? UART1_IRQ : UART0_IRQ, true);
-    uart_set_irq_enables(uart_id ? uart1 : uart0, true, false);
+    uart_set_fifo_enabled(uart_id ? uart1 : uart0, true);
+
+    /* UART RX is drained into the ring by DMA, no CPU attention per char. */
+    pgt->_rx_dma_chan = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(pgt->_rx_dma_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, eGPSrxRingBits);
+    channel_config_set_dreq(&c, uart_id ? DREQ_UART1_RX : DREQ_UART0_RX);
+
+    GPSrxInit(&pgt->_rx, su8GPSrxRing, 0);
+    dma_channel_configure(pgt->_rx_dma_chan, &c, su8GPSrxRing, 
+                          &uart_get_hw(uart_id ? uart1 : uart0)->dr, GPS_RX_DMA_COUNT, true);
 
     return pgt;
 }
@@ -113,6 +164,16 @@ void GPStimeDestroy(GPStimeContext **pp)
     spGPStimeContext = NULL;    /* Detach global context Ptr. */
     spGPStimeData = NULL;
 
+    gpio_set_irq_enabled((*pp)->_pps_gpio, GPIO_IRQ_EDGE_RISE, false);
+    if((*pp)->_pps_sm >= 0)
+    {
+        pio_sm_set_enabled((*pp)->_pps_pio, (*pp)->_pps_sm, false);
+        pio_remove_program_and_unclaim_sm(&pps_capture_program, (*pp)->_pps_pio, 
+                                          (*pp)->_pps_sm, (*pp)->_pps_offset);
+    }
+
+    dma_channel_abort((*pp)->_rx_dma_chan);
+    dma_channel_unclaim((*pp)->_rx_dma_chan);
     uart_deinit((*pp)->_uart_id ? uart1 : uart0);
     free(*pp);
     *pp = NULL;
@@ -126,36 +187,40 @@ void RAM (GPStimePPScallback)(uint gpio, uint32_t events)
     if(spGPStimeData)
     {
         spGPStimeData->_u64_sysclk_pps_last = tm64;   
-        ++spGPStimeData->_ix_last;
-        spGPStimeData->_ix_last %= eSlidingLen;
-
-        const int64_t dt_per_window = tm64 - spGPStimeData->_pu64_sliding_pps_tm[spGPStimeData->_ix_last];
-        spGPStimeData->_pu64_sliding_pps_tm[spGPStimeData->_ix_last] = tm64;
 
-        if(ABS(dt_per_window - eCLKperTimeMark * eSlidingLen) < eMaxCLKdevPPM * eSlidingLen)
+        /* qErr of TIM-TP which has preceded the pulse, if any. */
+        int32_t i32qerr_ps = 0;
+        if(spGPStimeData->_u8_qerr_is_fresh)
         {
-            if(spGPStimeData->_u64_pps_period_1M)
-            {
-                spGPStimeData->_u64_pps_period_1M += iSAR64((int64_t)eDtUpscale * dt_per_window 
-                                                            - spGPStimeData->_u64_pps_period_1M + 2, 2);
-                spGPStimeData->_i32_freq_shift_ppb = (spGPStimeData->_u64_pps_period_1M
-                                                      - (int64_t)eDtUpscale * eCLKperTimeMark * eSlidingLen
-                                                      + (eSlidingLen >> 1)) / eSlidingLen;
-            }
-            else
-            {
-                spGPStimeData->_u64_pps_period_1M = (int64_t)eDtUpscale * dt_per_window;
-            }
+            i32qerr_ps = spGPStimeData->_i32_qerr_next_ps;
+            spGPStimeData->_u8_qerr_is_fresh = 0;
         }
+        spGPStimeData->_i32_qerr_pps_ps = i32qerr_ps;
+        __compiler_memory_barrier();
+        ++spGPStimeData->_u32_pps_count;        /* The pulse is estimated by GPStimeProcess. */
+    }
+}
+
+/// @brief Obtains current UTC aligned to PPS: the second of the last pulse, as
+/// @brief labelled by NMEA or UBX, plus the time elapsed since it corrected by
+/// @brief the CPU CLK error of GPS.
+/// @param pg Ptr to the context.
+/// @param pu64utc_us Ptr to destination UTC, us since the unix epoch.
+/// @return 0 if OK.
+/// @return -1 No PPS has been labelled yet.
+/// @return -2 The last PPS has come 24 hrs or more ago.
+int GPStimeGetUTCus(const GPStimeContext *pg, uint64_t *pu64utc_us)
+{
+    assert_(pg);
+    assert_(pu64utc_us);
 
-#ifdef NOP
-        const int64_t dt_1M = (dt_per_window + (eSlidingLen >> 1)) / eSlidingLen;
-        const uint64_t tmp = (spGPStimeData->_u64_pps_period_1M + (eSlidingLen >> 1)) / eSlidingLen;
-        printf("%llu %lld %llu %lld\n", spGPStimeData->_u64_sysclk_pps_last, dt_1M, tmp, 
-               spGPStimeData->_i32_freq_shift_ppb);
-#endif
+    uint32_t u32count;
+    uint64_t u64pps;
+    int32_t i32qerr_ps;
+    GPStimeSnapshotPPS(&pg->_time_data, &u32count, &u64pps, &i32qerr_ps);
 
-    }
+    return UTCppsGet(&pg->_utc, u32count ? u64pps : 0, (int32_t)pg->_time_data._i32_freq_shift_ppb,
+                     GetUptime64(), pu64utc_us);
 }
 
 /// @brief Calculates current unixtime using data available.
@@ -164,11 +229,20 @@ void RAM (GPStimePPScallback)(uint gpio, uint32_t events)
 /// @return 0 if OK.
 /// @return -1 There was NO historical GPS fixes.
 /// @return -2 The fix was expired (24hrs or more time ago).
+/// @attention The second is that of PPS once a pulse is labelled, of the NMEA
+/// @attention arrival otherwise, which lags.
 int GPStimeGetTime(const GPStimeContext *pg, uint32_t *u32_tmdst)
 {
     assert_(pg);
     assert(u32_tmdst);
 
+    uint64_t u64utc_us;
+    if(!GPStimeGetUTCus(pg, &u64utc_us))
+    {
+        *u32_tmdst = (uint32_t)(u64utc_us / UTCPPS_SECOND_US);
+        return 0;
+    }
+
     /* If there has been no fix, it's no way to get any time data... */
     if(!pg->_time_data._u32_utime_nmea_last)
     {
@@ -190,97 +264,281 @@ int GPStimeGetTime(const GPStimeContext *pg, uint32_t *u32_tmdst)
     return 0;
 }
 
-/// @brief UART FIFO ISR. Processes another N chars receiver from GPS rec.
-void RAM (GPStimeUartRxIsr)()
+/// @brief The background task. Frames & processes NMEA sentences received by DMA.
+/// @param pg Ptr to Context.
+/// @return The count of sentences framed so far.
+/// @attention It should be called often enough for the ring not to be lapped,
+/// i.e. at least every ~150 ms at 115200 baud, the overruns are counted as errors.
+int GPStimeProcess(GPStimeContext *pg)
+{
+    assert_(pg);
+
+    const uint ch = pg->_rx_dma_chan;
+    const bool is_busy = dma_channel_is_busy(ch);
+    const uint32_t u32rcvd = pg->_u32_rx_base
+                           + (GPS_RX_DMA_COUNT - (dma_channel_hw_addr(ch)->transfer_count & GPS_RX_DMA_COUNT));
+
+    if(!is_busy)
+    {
+        /* The count is exhausted, rearm. The write addr is left where the ring stands. */
+        pg->_u32_rx_base = u32rcvd;
+        dma_channel_set_trans_count(ch, GPS_RX_DMA_COUNT, true);
+    }
+
+    if(pg->_pps_sm >= 0)
+    {
+        GPStimeDrainPPS(pg);
+    }
+    else
+    {
+        GPStimeTakePPS(pg);
+    }
+
+    const uint32_t u32ovr = pg->_rx._u32_overruns;
+    pg->_i32_error_count -= GPSrxFrame(&pg->_rx, u32rcvd, GPStimeOnSentence, GPStimeOnUBX, pg);
+    pg->_i32_error_count += pg->_rx._u32_overruns - u32ovr;
+
+    return pg->_rx._u32_sentences;
+}
+
+/// @brief Feeds the PPS captured by PIO to the estimator.
+/// @param pg Ptr to Context.
+static void GPStimeDrainPPS(GPStimeContext *pg)
 {
-    if(spGPStimeContext)
+    GPStimeData *pd = &pg->_time_data;
+    while(!pio_sm_is_rx_fifo_empty(pg->_pps_pio, pg->_pps_sm))
     {
-        uart_inst_t *puart_id = spGPStimeContext->_uart_id ? uart1 : uart0;
-        for(;;uart_is_readable(puart_id))
+        const uint32_t u32count = pio_sm_get(pg->_pps_pio, pg->_pps_sm);
+
+        /* The qErr taken by ISR belongs to the pulse if the ISR has counted just it. */
+        const int32_t i32diff = pd->_u32_pps_count - ++pg->_u32_pps_capt_count;
+        const int32_t i32qerr_ps = i32diff ? 0 : pd->_i32_qerr_pps_ps;
+        if(i32diff > 0 || i32diff < -1)
         {
-            gpio_put(PICO_DEFAULT_LED_PIN, 1);
-            uint8_t chr = uart_getc(puart_id);
-            spGPStimeContext->_pbytebuff[spGPStimeContext->_u8_ixw++] = chr;
-            spGPStimeContext->_is_sentence_ready = ('\n' == chr);
-            break;
+            pg->_u32_pps_capt_count = pd->_u32_pps_count;   /* Resync. */
         }
 
-        if(spGPStimeContext->_is_sentence_ready)
+        int64_t i64dt_ps;
+        if(PPScapPulse(&pg->_pps_cap, u32count, time_us_64(), i32qerr_ps, &i64dt_ps))
         {
-            spGPStimeContext->_u8_ixw = 0;
-            spGPStimeContext->_i32_error_count -= GPStimeProcNMEAsentence(spGPStimeContext);
+            GPStimeEstimate(pg, i64dt_ps);
         }
     }
 }
 
-/// @brief Processes a NMEA sentence GPRMC.
+/// @brief Takes a consistent snapshot of the last PPS, the ISR might come in between.
+/// @param pd Ptr to the data.
+/// @param pu32count Ptr to the count of PPS.
+/// @param pu64tm Ptr to the uptime of the last one, us.
+/// @param pi32qerr_ps Ptr to its qErr, ps.
+static void GPStimeSnapshotPPS(const GPStimeData *pd, uint32_t *pu32count, uint64_t *pu64tm, int32_t *pi32qerr_ps)
+{
+    do
+    {
+        *pu32count = pd->_u32_pps_count;
+        __compiler_memory_barrier();
+        *pu64tm = pd->_u64_sysclk_pps_last;
+        *pi32qerr_ps = pd->_i32_qerr_pps_ps;
+        __compiler_memory_barrier();
+    } while(*pu32count != pd->_u32_pps_count);
+}
+
+/// @brief Feeds the PPS timestamped by ISR to the estimator.
+/// @param pg Ptr to Context.
+static void GPStimeTakePPS(GPStimeContext *pg)
+{
+    uint32_t u32count;
+    uint64_t u64tm;
+    int32_t i32qerr_ps;
+    GPStimeSnapshotPPS(&pg->_time_data, &u32count, &u64tm, &i32qerr_ps);
+
+    if(u32count == pg->_u32_pps_capt_count)
+    {
+        return;
+    }
+
+    /* Pulses missed by this loop just make the interval longer. */
+    const int is_first = !pg->_u32_pps_capt_count;
+    pg->_u32_pps_capt_count = u32count;
+    const int64_t i64dt_ps = 1000000LL * (int64_t)(u64tm - pg->_u64_pps_tm_prev)
+                           - i32qerr_ps + pg->_i32_qerr_prev_ps;
+    pg->_u64_pps_tm_prev = u64tm;
+    pg->_i32_qerr_prev_ps = i32qerr_ps;
+    if(!is_first)
+    {
+        GPStimeEstimate(pg, i64dt_ps);
+    }
+}
+
+/// @brief Labels the last PPS by the time of a sentence just processed.
 /// @param pg Ptr to Context.
-/// @return 0 OK.
-/// @return -2 Error: bad lat format.
-/// @return -3 Error: bad lon format.
-/// @return -4 Error: no final '*' char ere checksum value.
-/// @attention Checksum validation is not implemented so far. !FIXME!
-int GPStimeProcNMEAsentence(GPStimeContext *pg)
+/// @param u32unix The time of the sentence, s.
+/// @param u32frac_us Its fraction, us.
+/// @param u64tm The uptime it's processed at, us.
+static void GPStimeLabelPPS(GPStimeContext *pg, uint32_t u32unix, uint32_t u32frac_us, uint64_t u64tm)
+{
+    uint32_t u32count;
+    uint64_t u64pps;
+    int32_t i32qerr_ps;
+    GPStimeSnapshotPPS(&pg->_time_data, &u32count, &u64pps, &i32qerr_ps);
+    UTCppsLabel(&pg->_utc, u32unix, u32frac_us, u32count ? u64pps : 0,
+                (int32_t)pg->_time_data._i32_freq_shift_ppb, u64tm);
+}
+
+/// @brief Feeds the interval of PPS to the estimator, updates the correction.
+/// @param pg Ptr to Context.
+/// @param i64dt_ps The interval, ps of nominal CPU CLK.
+static void GPStimeEstimate(GPStimeContext *pg, int64_t i64dt_ps)
+{
+    if(PPSestInterval(&pg->_pps_est, i64dt_ps) > 0)
+    {
+        pg->_time_data._i32_freq_shift_ppb = PPSestPPB(&pg->_pps_est);
+    }
+}
+
+/// @brief Selects the estimator of CPU CLK error of PPS, it restarts.
+/// @param pg Ptr to Context.
+/// @param kind The estimator.
+/// @attention The correction is held until the new one has its first estimate.
+void GPStimeSetEstimator(GPStimeContext *pg, PPSestKind kind)
 {
     assert_(pg);
 
-    uint8_t *prmc = (uint8_t *)strnstr((char *)pg->_pbytebuff, "$GPRMC,", sizeof(pg->_pbytebuff));
-    if(prmc)
+    if(pg->_pps_sm >= 0)
+    {
+        PPSestInit(&pg->_pps_est, kind, eGPSppsSigmaPIOps, eGPSppsMemoryPIO);
+    }
+    else
     {
-        ++pg->_time_data._u32_nmea_gprmc_count;
+        PPSestInit(&pg->_pps_est, kind, eGPSppsSigmaTimerPs, eGPSppsMemoryTimer);
+    }
+}
+
+/// @brief The sink of sentences framed.
+static int GPStimeOnSentence(void *pctx, uint8_t *pline, uint32_t u32len)
+{
+    return GPStimeProcNMEAsentence((GPStimeContext *)pctx, pline, u32len);
+}
+
+/// @brief The sink of UBX frames, NAV-STATUS, NAV-TIMEUTC & TIM-TP are used.
+static int GPStimeOnUBX(void *pctx, const UBXparser *pu)
+{
+    GPStimeContext *pg = (GPStimeContext *)pctx;
+    GPStimeData *pd = &pg->_time_data;
 
-        uint64_t tm_fix = GetUptime64();
-        uint8_t u8ixcollector[16] = {0};
-        uint8_t chksum = 0;
-        for(uint8_t u8ix = 0, i = 0; u8ix != sizeof(pg->_pbytebuff); ++u8ix)
+    UBXnavStatus sts;
+    UBXnavTimeUTC utc;
+    UBXtimTP tp;
+    if(!UBXdecodeTimTP(pu, &tp))
+    {
+        /* It describes the next pulse, PPS ISR takes it. */
+        pd->_i32_qerr_next_ps = tp._i32_qerr_ps;
+        __compiler_memory_barrier();
+        pd->_u8_qerr_is_fresh = 1;
+        ++pd->_u32_ubx_timtp_count;
+    }
+    else if(!UBXdecodeNavTimeUTC(pu, &utc))
+    {
+        const uint32_t u32unix = UBXtimeUTC2UNIX(&utc);
+        if(u32unix)
         {
-            uint8_t *p = pg->_pbytebuff + u8ix;
-            chksum ^= *p;
-            if(',' == *p)
-            {
-                *p = 0;
-                u8ixcollector[i++] = u8ix + 1;
-                if('*' == *p || 12 == i)
-                {
-                    break;
-                }
-            }
+            const uint64_t tm_fix = GetUptime64();
+            pd->_u32_utime_nmea_last = u32unix;
+            pd->_u64_sysclk_nmea_last = tm_fix;
+
+            /* The fraction of the epoch, nano may be negative. */
+            const uint32_t u32frac_us = utc._i32_nano < 0 ? (1000000000 + utc._i32_nano) / 1000
+                                                          : utc._i32_nano / 1000;
+            GPStimeLabelPPS(pg, u32unix - (utc._i32_nano < 0), u32frac_us, tm_fix);
         }
-        
-        pg->_time_data._u8_is_solution_active = 'A' == prmc[u8ixcollector[1]];
+    }
+    else if(!UBXdecodeNavStatus(pu, &sts))
+    {
+        pd->_u8_is_solution_active = (sts._u8_flags & 1) && sts._u8_gps_fix >= 2;
+    }
 
-        if(pg->_time_data._u8_is_solution_active)
-        {
-            pg->_time_data._i64_lat_100k = (int64_t)(.5f + 1e5 * atof((const char *)prmc + u8ixcollector[2]));
-            if('N' == prmc[u8ixcollector[3]]) { }
-            else if('S' == prmc[u8ixcollector[3]])
-            {
-                INVERSE(pg->_time_data._i64_lat_100k);
-            }
-            else
-            {
-                return -2;
-            }
+    return 0;
+}
 
-            pg->_time_data._i64_lon_100k = (int64_t)(.5f + 1e5 * atof((const char *)prmc + u8ixcollector[4]));
-            if('E' == prmc[u8ixcollector[5]]) { }
-            else if('W' == prmc[u8ixcollector[5]])
-            {
-                INVERSE(pg->_time_data._i64_lon_100k);
-            }
-            else
-            {
-                return -3;
-            }
+/// @brief Switches UBX NAV-STATUS, NAV-TIMEUTC & TIM-TP on & the bulky NMEA
+/// @brief sentences (GSV, GLL, VTG) off, or vice versa. u-blox receivers only.
+/// @param pg Ptr to Context.
+/// @param is_on Nonzero to switch UBX on.
+/// @attention The receiver configuration isn't saved, it's lost on its power cycle.
+void GPStimeConfigUBX(GPStimeContext *pg, int is_on)
+{
+    assert_(pg);
+
+    static const uint8_t su8msgs[][2] =
+    {
+        { eUBX_CLS_NAV, eUBX_NAV_STATUS }, { eUBX_CLS_NAV, eUBX_NAV_TIMEUTC }, { eUBX_CLS_TIM, eUBX_TIM_TP },
+        { eUBX_CLS_NMEA, eUBX_NMEA_GSV }, { eUBX_CLS_NMEA, eUBX_NMEA_GLL }, { eUBX_CLS_NMEA, eUBX_NMEA_VTG }
+    };
+
+    uint8_t frame[16];
+    for(uint32_t i = 0; i < sizeof(su8msgs) / sizeof(su8msgs[0]); ++i)
+    {
+        const int is_ubx = eUBX_CLS_NMEA != su8msgs[i][0];
+        const uint8_t u8rate = is_ubx == !!is_on;   /* Every solution or never. */
+        const uint32_t u32len = UBXbuildCfgMsg(su8msgs[i][0], su8msgs[i][1], u8rate, frame);
+        uart_write_blocking(pg->_uart_id ? uart1 : uart0, frame, u32len);
+    }
+
+    pg->_u8_is_ubx = !!is_on;
+}
+
+/// @brief Processes a NMEA sentence, RMC, GGA, GSA & ZDA of any talker are used.
+/// @param pg Ptr to Context.
+/// @param pline Ptr to the sentence, it is not modified.
+/// @param u32len The length of the sentence.
+/// @return 0 OK or the sentence isn't used.
+/// @return -1 Error: bad frame, checksum or field format.
+int GPStimeProcNMEAsentence(GPStimeContext *pg, const uint8_t *pline, uint32_t u32len)
+{
+    assert_(pg);
+    assert_(pline);
 
-            if('*' != prmc[u8ixcollector[11] + 1])
+    const uint64_t tm_fix = GetUptime64();
+    GPStimeData *pd = &pg->_time_data;
+
+    NMEAsentence snt;
+    switch(NMEAparse((const char *)pline, u32len, &snt))
+    {
+        case eNMEA_RMC:
+            ++pd->_u32_nmea_gprmc_count;
+            pd->_u8_is_solution_active = snt._u8_is_valid;
+            if(snt._u8_is_valid && snt._u8_has_pos)
             {
-                return -4;
+                pd->_i64_lat_100k = GPStimeDeg1e7to1e5(snt._i32_lat_1e7);
+                pd->_i64_lon_100k = GPStimeDeg1e7to1e5(snt._i32_lon_1e7);
             }
+            break;
 
-            pg->_time_data._u32_utime_nmea_last = GPStime2UNIX(prmc + u8ixcollector[8], prmc + u8ixcollector[0]);
-            pg->_time_data._u64_sysclk_nmea_last = tm_fix;
-        }
+        case eNMEA_GGA:
+            pd->_u8_sats_used = snt._u8_sats;
+            pd->_u16_hdop_100 = snt._u16_hdop_100;
+            break;
+
+        case eNMEA_GSA:
+            pd->_u8_fix_mode = snt._u8_fix_mode;
+            break;
+
+        case eNMEA_ZDA:
+            break;
+
+        case eNMEA_UNKNOWN:
+            return 0;
+
+        default:
+            return -1;
+    }
+
+    /* Both RMC & ZDA carry the date. */
+    if(snt._u8_is_valid && snt._u8_has_date)
+    {
+        pd->_u32_utime_nmea_last = snt._u32_unixtime;
+        pd->_u64_sysclk_nmea_last = tm_fix;
+        GPStimeLabelPPS(pg, snt._u32_unixtime, snt._u32_tod_ms % 1000 * 1000, tm_fix);
     }
     
     return 0;
@@ -297,17 +555,11 @@ uint32_t GPStime2UNIX(const char *pdate, const char *ptime)
 
     if(strlen(pdate) == 6 && strlen(ptime) > 5)
     {
-        struct tm ltm = {0};
-
-        ltm.tm_year = 100 + DecimalStr2ToNumber(pdate + 4);
-        ltm.tm_mon  = DecimalStr2ToNumber(pdate + 2) - 1;
-        ltm.tm_mday = DecimalStr2ToNumber(pdate);
-
-        ltm.tm_hour = DecimalStr2ToNumber(ptime);
-        ltm.tm_min = DecimalStr2ToNumber(ptime + 2);
-        ltm.tm_sec = DecimalStr2ToNumber(ptime + 4);
+        const uint32_t tod_s = 3600 * DecimalStr2ToNumber(ptime) 
+                             + 60 * DecimalStr2ToNumber(ptime + 2) + DecimalStr2ToNumber(ptime + 4);
 
-        return mktime(&ltm);
+        return NMEAcivil2UNIX(2000 + DecimalStr2ToNumber(pdate + 4), DecimalStr2ToNumber(pdate + 2),
+                              DecimalStr2ToNumber(pdate), tod_s);
     }
 
     return 0;
@@ -320,11 +572,13 @@ void GPStimeDump(const GPStimeData *pd)
     assert_(pd);
 
     printf("\nGPS solution is active:%u\n", pd->_u8_is_solution_active);
-    printf("GPRMC count:%lu\n", pd->_u32_nmea_gprmc_count);
+    printf("RMC count:%lu\n", pd->_u32_nmea_gprmc_count);
+    printf("Fix mode:%u sats used:%u HDOP*100:%u\n", pd->_u8_fix_mode, pd->_u8_sats_used, pd->_u16_hdop_100);
     printf("NMEA unixtime last:%lu\n", pd->_u32_utime_nmea_last);
     printf("NMEA sysclock last:%llu\n", pd->_u64_sysclk_nmea_last);
     printf("GPS Latitude:%lld Longtitude:%lld\n", pd->_i64_lat_100k, pd->_i64_lon_100k);
     printf("PPS sysclock last:%llu\n", pd->_u64_sysclk_pps_last);
-    printf("PPS period *1e6:%llu\n", (pd->_u64_pps_period_1M + (eSlidingLen>>1)) / eSlidingLen);
+    printf("TIM-TP count:%lu last qErr ps:%ld\n", pd->_u32_ubx_timtp_count, pd->_i32_qerr_next_ps);
+    printf("PPS count:%lu\n", pd->_u32_pps_count);
     printf("FRQ correction ppb:%lld\n\n", pd->_i32_freq_shift_ppb);
 }
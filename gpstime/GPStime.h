@@ -31,6 +31,12 @@
 //  REVISION HISTORY
 // 
 //      Rev 0.1   25 Nov 2023   Initial release
+//      Rev 0.2   16 Oct 2026   NMEA is received by DMA into a ring buffer.
+//      Rev 0.3   16 Oct 2026   Zero-copy NMEA parser with checksum validation.
+//      Rev 0.4   16 Oct 2026   UBX protocol, TIM-TP qErr correction of PPS.
+//      Rev 0.5   16 Oct 2026   PPS timestamps captured by PIO.
+//      Rev 0.6   16 Oct 2026   Pluggable estimator of CPU CLK error, Kalman filter.
+//      Rev 0.7   16 Oct 2026   UTC in us aligned to PPS.
 //
 //  PROJECT PAGE
 //      https://github.com/RPiks/pico-hf-oscillator
@@ -65,22 +71,29 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
 #include "pico/stdlib.h"
 #include "hardware/uart.h"
+#include "hardware/dma.h"
+#include "hardware/pio.h"
 #include "../defines.h"
 #include "../lib/assert.h"
 #include "../lib/utility.h"
 #include "../lib/thirdparty/strnstr.h"
+#include "gpsrx.h"
+#include "nmea.h"
+#include "ubx.h"
+#include "ppscap.h"
+#include "ppsest.h"
+#include "utcpps.h"
 
 #define ASSERT_(x) assert_(x)
 
 enum
 {
-    eDtUpscale = 1000000,
-    eSlidingLen = 32,
-    eCLKperTimeMark = 1000000,
-    eMaxCLKdevPPM = 250
+    eGPSppsSigmaTimerPs = 500000,               /* PPS timestamp noise of 1 us timer & IRQ, ps. */
+    eGPSppsSigmaPIOps = 3000,                   /* Of PIO capture, 2 CPU CLK cycles & qErr left. */
+    eGPSppsMemoryTimer = 128,                   /* The memory of the estimator, pulses. */
+    eGPSppsMemoryPIO = 24
 };
 
 typedef struct
@@ -89,13 +102,18 @@ typedef struct
     uint32_t _u32_utime_nmea_last;              /* The last unix time received from GPS. */
     uint64_t _u64_sysclk_nmea_last;             /* The sysclk of the last unix time received. */
     int64_t _i64_lat_100k, _i64_lon_100k;       /* The lat, lon, degrees, multiplied by 1e5. */
-    uint32_t _u32_nmea_gprmc_count;             /* The count of $GPRMC sentences received */
+    uint32_t _u32_nmea_gprmc_count;             /* The count of $xxRMC sentences received */
+    uint8_t _u8_fix_mode;                       /* GSA fix mode, 1 none, 2 2D, 3 3D. */
+    uint8_t _u8_sats_used;                      /* GGA sats in use. */
+    uint16_t _u16_hdop_100;                     /* GGA HDOP * 100. */
 
     uint64_t _u64_sysclk_pps_last;              /* The sysclk of the last rising edge of PPS. */
-    uint64_t _u64_pps_period_1M;                /* The PPS avg. period *1e6, filtered. */
 
-    uint64_t _pu64_sliding_pps_tm[eSlidingLen]; /* A sliding window to store PPS periods. */
-    uint8_t _ix_last;                           /* An index of last write to sliding window. */
+    int32_t _i32_qerr_next_ps;                  /* TIM-TP qErr of the next PPS. */
+    uint8_t _u8_qerr_is_fresh;                  /* It's not taken by PPS ISR yet. */
+    uint32_t _u32_ubx_timtp_count;              /* The count of TIM-TP received. */
+    uint32_t _u32_pps_count;                    /* The count of PPS seen by ISR. */
+    int32_t _i32_qerr_pps_ps;                   /* qErr taken by ISR for the last PPS. */
 
     int64_t _i32_freq_shift_ppb;                /* Calcd frequency shift, parts per billion. */
 
@@ -109,9 +127,20 @@ typedef struct
 
     GPStimeData _time_data;
 
-    uint8_t _pbytebuff[256];
-    uint8_t _u8_ixw;
-    uint8_t _is_sentence_ready;
+    GPSrxRing _rx;                              /* The NMEA framer of the DMA ring. */
+    int _rx_dma_chan;                           /* The DMA channel of UART RX. */
+    uint8_t _u8_is_ubx;                         /* UBX messages are switched on. */
+
+    PIO _pps_pio;                               /* PIO of `pps_capture`. */
+    int _pps_sm;                                /* Its state machine, -1 if none. */
+    uint _pps_offset;                           /* Its program offset. */
+    PPScapture _pps_cap;                        /* The PPS captured. */
+    uint32_t _u32_pps_capt_count;               /* The count of PPS taken to estimation. */
+    uint64_t _u64_pps_tm_prev;                  /* The last PPS taken from ISR, us. */
+    int32_t _i32_qerr_prev_ps;                  /* Its qErr. */
+    PPSestimator _pps_est;                      /* The estimator of CPU CLK error. */
+    UTCpps _utc;                                /* UTC of PPS labelled by NMEA or UBX. */
+    uint32_t _u32_rx_base;                      /* The chars received ere the DMA was armed. */
     int32_t _i32_error_count;
 
 } GPStimeContext;
@@ -119,12 +148,15 @@ typedef struct
 GPStimeContext *GPStimeInit(int uart_id, int uart_baud, int pps_gpio);
 void GPStimeDestroy(GPStimeContext **pp);
 
-int GPStimeProcNMEAsentence(GPStimeContext *pg);
+int GPStimeProcess(GPStimeContext *pg);
+void GPStimeConfigUBX(GPStimeContext *pg, int is_on);
+void GPStimeSetEstimator(GPStimeContext *pg, PPSestKind kind);
+int GPStimeProcNMEAsentence(GPStimeContext *pg, const uint8_t *pline, uint32_t u32len);
 
 void RAM (GPStimePPScallback)(uint gpio, uint32_t events);
-void RAM (GPStimeUartRxIsr)();
 
 int GPStimeGetTime(const GPStimeContext *pg, uint32_t *u32_tmdst);
+int GPStimeGetUTCus(const GPStimeContext *pg, uint64_t *pu64utc_us);
 uint32_t GPStime2UNIX(const char *pdate, const char *ptime);
 
 void GPStimeDump(const GPStimeData *pd);
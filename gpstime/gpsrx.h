@@ -0,0 +1,183 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  gpsrx.h - Framer of NMEA sentences received by DMA into a ring.
+//
+//
+//  DESCRIPTION
+//
+//      The DMA writes the chars received by GPS UART into a ring buffer without
+//  any CPU attention; the background task reads them out from time to time and
+//  frames the NMEA sentences ('$' ... '\n') into the line buffer for parsing.
+//  The writer position is a monotonic count of chars received, so if the task was
+//  late and the DMA has lapped it, the loss is detected and counted as overrun,
+//  the broken sentence is dropped rather than parsed.
+//      The UBX binary frames of u-blox receivers may be interleaved with NMEA,
+//  they are framed by UBXfeed (ubx.h) and never leak into NMEA lines.
+//      It is kept free of any pico SDK dependency, so it's checked off-target.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//      Rev 0.2   16 Oct 2026   UBX frames interleaved.
+//      Rev 0.3   17 Oct 2026   The line is reset by index, not wiped.
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef GPSRX_H_
+#define GPSRX_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include "ubx.h"
+
+enum
+{
+    eGPSrxRingBits = 11,                        /* log2 of the ring length, DMA ring wrap. */
+    eGPSrxRingLen = 1 << eGPSrxRingBits,        /* 2048 chars, >170 ms of 115200 baud. */
+    eGPSrxLineLen = 256,                        /* The longest sentence + 0 terminator. */
+    eGPSrxLagMax = eGPSrxRingLen - eGPSrxLineLen /* The lag which is deemed as overrun. */
+};
+
+typedef struct
+{
+    const volatile uint8_t *_pu8_ring;          /* The ring written by DMA. */
+    uint32_t _u32_read;                         /* The count of chars read out. */
+    uint32_t _u32_ixl;                          /* The count of chars in the line. */
+    uint32_t _u32_overruns;                     /* The count of overruns detected. */
+    uint32_t _u32_sentences;                    /* The count of sentences framed. */
+    uint8_t _pu8_line[eGPSrxLineLen];           /* The sentence being framed, 0 terminated. */
+    UBXparser _ubx;                             /* The UBX frame being framed. */
+
+} GPSrxRing;
+
+/// @brief The sink of a framed sentence, it may modify the line in place.
+typedef int (*GPSrxSentenceFn)(void *pctx, uint8_t *pline, uint32_t u32len);
+
+/// @brief The sink of a UBX frame received.
+typedef int (*GPSrxUBXFn)(void *pctx, const UBXparser *pu);
+
+/// @brief Attaches the framer to the ring.
+/// @param pr Ptr to the framer.
+/// @param pu8ring Ptr to the ring of eGPSrxRingLen chars.
+/// @param u32_received The count of chars the ring was written so far.
+static inline void GPSrxInit(GPSrxRing *pr, const volatile uint8_t *pu8ring, uint32_t u32_received)
+{
+    memset(pr, 0, sizeof(GPSrxRing));
+    pr->_pu8_ring = pu8ring;
+    pr->_u32_read = u32_received;
+    pr->_u32_ixl = eGPSrxLineLen;               /* Wait for the first '$'. */
+}
+
+/// @brief Drops the sentence being framed, only the index is reset.
+static inline void GPSrxDropLine(GPSrxRing *pr)
+{
+    pr->_u32_ixl = eGPSrxLineLen;
+}
+
+/// @brief Frames the sentences received so far and feeds them to the sink.
+/// @param pr Ptr to the framer.
+/// @param u32_received The count of chars the DMA has written so far, mod 2^32.
+/// @param pfn The sink of sentences.
+/// @param pfn_ubx The sink of UBX frames, NULL if UBX isn't used.
+/// @param pctx The context of the sinks.
+/// @return The sum of sink returns, -1 is added per broken UBX frame.
+/// @attention The line is 0 terminated for the sink, the chars past it are stale.
+static inline int GPSrxFrame(GPSrxRing *pr, uint32_t u32_received, GPSrxSentenceFn pfn,
+                             GPSrxUBXFn pfn_ubx, void *pctx)
+{
+    if(u32_received - pr->_u32_read > eGPSrxLagMax)
+    {
+        /* The DMA has lapped us or it's about to overwrite the chars being read. */
+        pr->_u32_read = u32_received - eGPSrxLagMax;
+        ++pr->_u32_overruns;
+        GPSrxDropLine(pr);
+        pr->_ubx._u8_state = 0;
+    }
+
+    int isum = 0;
+    while(pr->_u32_read != u32_received)
+    {
+        const uint8_t chr = pr->_pu8_ring[pr->_u32_read++ & (eGPSrxRingLen - 1)];
+        if(pfn_ubx && (pr->_ubx._u8_state || eUBXsync1 == chr))
+        {
+            const int iubx = UBXfeed(&pr->_ubx, chr);
+            if(iubx)
+            {
+                isum += iubx > 0 ? pfn_ubx(pctx, &pr->_ubx) : -1;
+            }
+            continue;
+        }
+
+        if('$' == chr)
+        {
+            if(pr->_u32_ixl != eGPSrxLineLen)
+            {
+                GPSrxDropLine(pr);              /* The previous one was cut. */
+            }
+            pr->_u32_ixl = 0;
+        }
+        else if(pr->_u32_ixl >= eGPSrxLineLen - 1)
+        {
+            if(pr->_u32_ixl != eGPSrxLineLen)
+            {
+                GPSrxDropLine(pr);              /* Too long, it's garbage. */
+            }
+            continue;
+        }
+        else if('\n' == chr)
+        {
+            if(pr->_u32_ixl)
+            {
+                pr->_pu8_line[pr->_u32_ixl] = 0;
+                ++pr->_u32_sentences;
+                isum += pfn(pctx, pr->_pu8_line, pr->_u32_ixl);
+            }
+            GPSrxDropLine(pr);
+            continue;
+        }
+        else if('\r' == chr)
+        {
+            continue;
+        }
+
+        pr->_pu8_line[pr->_u32_ixl++] = chr;
+    }
+
+    return isum;
+}
+
+#endif
@@ -0,0 +1,547 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  nmea.c - Zero-copy NMEA 0183 sentence parser.
+//
+//
+//  DESCRIPTION
+//
+//      See nmea.h.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//      Rev 0.2   16 Oct 2026   Unix time to civil date & time.
+//      Rev 0.3   17 Oct 2026   ZDA valid only with both time & date.
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <string.h>
+
+#include "nmea.h"
+
+typedef int (*NMEAdecoder)(const NMEAtokens *pt, NMEAsentence *ps);
+
+static int NMEAdecodeRMC(const NMEAtokens *pt, NMEAsentence *ps);
+static int NMEAdecodeGGA(const NMEAtokens *pt, NMEAsentence *ps);
+static int NMEAdecodeGSA(const NMEAtokens *pt, NMEAsentence *ps);
+static int NMEAdecodeZDA(const NMEAtokens *pt, NMEAsentence *ps);
+
+/* The decoders by sentence formatter. */
+static const struct
+{
+    char _fmt[3];
+    uint8_t _u8_min_fields;                     /* Address included. */
+    NMEAtype _type;
+    NMEAdecoder _pfn;
+
+} sNMEAdecoders[] =
+{
+    { {'R', 'M', 'C'}, 10, eNMEA_RMC, NMEAdecodeRMC },
+    { {'G', 'G', 'A'}, 10, eNMEA_GGA, NMEAdecodeGGA },
+    { {'G', 'S', 'A'}, 18, eNMEA_GSA, NMEAdecodeGSA },
+    { {'Z', 'D', 'A'},  5, eNMEA_ZDA, NMEAdecodeZDA }
+};
+
+/// @brief Converts a hex digit.
+/// @return Its value, -1 if it's not a hex digit.
+static inline int NMEAhex(char c)
+{
+    if(c >= '0' && c <= '9') return c - '0';
+    if(c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if(c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+/// @brief Tokenizes the sentence in a single pass, validates its frame & checksum.
+/// @param pline Ptr to the sentence, '$' ... '*hh', line ending is optional.
+/// @param u32len The length of the sentence.
+/// @param pt Ptr to the tokens.
+/// @return 0 if OK.
+/// @return eNMEA_ERR_FRAME if no '$', too long or a non printable char met.
+/// @return eNMEA_ERR_CHECKSUM if no '*hh' or the checksum mismatches.
+int NMEAtokenize(const char *pline, uint32_t u32len, NMEAtokens *pt)
+{
+    if(u32len < 4 || u32len > eNMEAmaxLen || '$' != pline[0])
+    {
+        return eNMEA_ERR_FRAME;
+    }
+
+    pt->_psz = pline;
+    pt->_pu8_ofs[0] = 1;
+
+    uint8_t chksum = 0;
+    uint32_t nf = 0, i = 1;
+    for(; i < u32len; ++i)
+    {
+        const char c = pline[i];
+        if('*' == c)
+        {
+            break;
+        }
+        if(c < 0x20 || c > 0x7E)
+        {
+            return eNMEA_ERR_FRAME;
+        }
+        chksum ^= c;
+        if(',' == c && ++nf <= eNMEAmaxFields)
+        {
+            pt->_pu8_ofs[nf] = i + 1;
+        }
+    }
+
+    if(i + 3 > u32len)
+    {
+        return eNMEA_ERR_CHECKSUM;
+    }
+    const int hi = NMEAhex(pline[i + 1]);
+    const int lo = NMEAhex(pline[i + 2]);
+    if(hi < 0 || lo < 0 || chksum != ((hi << 4) | lo))
+    {
+        return eNMEA_ERR_CHECKSUM;
+    }
+
+    if(++nf <= eNMEAmaxFields)
+    {
+        pt->_pu8_ofs[nf] = i + 1;
+    }
+    pt->_u8_nfields = nf;
+
+    return 0;
+}
+
+/// @brief Tokenizes & decodes the sentence.
+/// @param pline Ptr to the sentence, it is not modified.
+/// @param u32len The length of the sentence.
+/// @param ps Ptr to the sentence decoded.
+/// @return The type of the sentence, eNMEA_UNKNOWN if there's no decoder of it.
+/// @return eNMEA_ERR_xxx (negative) on error.
+int NMEAparse(const char *pline, uint32_t u32len, NMEAsentence *ps)
+{
+    memset(ps, 0, sizeof(NMEAsentence));
+
+    NMEAtokens tok;
+    const int ierr = NMEAtokenize(pline, u32len, &tok);
+    if(ierr)
+    {
+        return ps->_type = ierr;
+    }
+
+    uint32_t u32alen;
+    const char *paddr = NMEAfield(&tok, 0, &u32alen);
+    if(5 != u32alen)
+    {
+        return eNMEA_UNKNOWN;                   /* Proprietary or malformed address. */
+    }
+    ps->_talker[0] = paddr[0];
+    ps->_talker[1] = paddr[1];
+
+    for(uint32_t i = 0; i < sizeof(sNMEAdecoders) / sizeof(sNMEAdecoders[0]); ++i)
+    {
+        if(!memcmp(paddr + 2, sNMEAdecoders[i]._fmt, 3))
+        {
+            if(tok._u8_nfields < sNMEAdecoders[i]._u8_min_fields
+               || sNMEAdecoders[i]._pfn(&tok, ps))
+            {
+                return ps->_type = eNMEA_ERR_FIELD;
+            }
+
+            return ps->_type = sNMEAdecoders[i]._type;
+        }
+    }
+
+    return eNMEA_UNKNOWN;
+}
+
+/// @brief Parses a decimal fixed point number.
+/// @param p Ptr to the number, [-]digits[.digits].
+/// @param u32len The length of the number.
+/// @param u32decimals Decimals to keep, the rest are truncated.
+/// @param pi64val Ptr to the value * 10^u32decimals.
+/// @return 0 if OK, 1 if the field is empty, -1 on bad format.
+int NMEAparseFixed(const char *p, uint32_t u32len, uint32_t u32decimals, int64_t *pi64val)
+{
+    if(!u32len)
+    {
+        return 1;
+    }
+
+    const int is_neg = '-' == *p;
+    uint32_t i = is_neg;
+    int64_t i64v = 0;
+    int idec = -1;                              /* Decimals taken, -1 before '.'. */
+    int is_digit = 0;
+    for(; i < u32len; ++i)
+    {
+        const char c = p[i];
+        if('.' == c && idec < 0)
+        {
+            idec = 0;
+        }
+        else if(c >= '0' && c <= '9')
+        {
+            is_digit = 1;
+            if(idec < 0)
+            {
+                i64v = i64v * 10 + (c - '0');
+            }
+            else if(idec < (int)u32decimals)
+            {
+                i64v = i64v * 10 + (c - '0');
+                ++idec;
+            }
+        }
+        else
+        {
+            return -1;
+        }
+
+        if(i64v > 100000000000000000LL)
+        {
+            return -1;                          /* Far too long. */
+        }
+    }
+
+    if(!is_digit)
+    {
+        return -1;
+    }
+
+    for(idec = idec < 0 ? 0 : idec; idec < (int)u32decimals; ++idec)
+    {
+        i64v *= 10;
+    }
+    *pi64val = is_neg ? -i64v : i64v;
+
+    return 0;
+}
+
+/// @brief Parses NMEA lat or lon, [d]ddmm.mmmm, by integer math.
+/// @param p Ptr to the field.
+/// @param u32len The length of the field.
+/// @param hemi Hemisphere, 'N', 'S', 'E' or 'W'.
+/// @param pi32deg_1e7 Ptr to degrees * 1e7, S & W negative.
+/// @return 0 if OK, 1 if the field is empty, -1 on bad format.
+int NMEAparseLatLon(const char *p, uint32_t u32len, char hemi, int32_t *pi32deg_1e7)
+{
+    int64_t i64v;
+    const int ir = NMEAparseFixed(p, u32len, 6, &i64v);
+    if(ir)
+    {
+        return ir;
+    }
+
+    const int64_t i64deg = i64v / 100000000LL;
+    const int64_t i64min_1e6 = i64v % 100000000LL;
+    if(i64v < 0 || i64deg > 180 || i64min_1e6 >= 60000000LL)
+    {
+        return -1;
+    }
+
+    /* minutes / 60 * 1e7 == minutes * 1e6 / 6. */
+    const int32_t i32deg_1e7 = (int32_t)(i64deg * 10000000LL + (i64min_1e6 + 3) / 6);
+    switch(hemi)
+    {
+        case 'N': case 'E': *pi32deg_1e7 = i32deg_1e7; break;
+        case 'S': case 'W': *pi32deg_1e7 = -i32deg_1e7; break;
+        default: return -1;
+    }
+
+    return 0;
+}
+
+/// @brief Converts the civil date & time of day to unix time, no libc involved.
+/// @param u32year The year, 1970...2105.
+/// @param u32month The month, 1...12.
+/// @param u32day The day of month, 1...31.
+/// @param u32tod_s The time of day, s.
+/// @return Unix time, s.
+uint32_t NMEAcivil2UNIX(uint32_t u32year, uint32_t u32month, uint32_t u32day, uint32_t u32tod_s)
+{
+    /* The days from civil of H.Hinnant, the year starting from March. */
+    const uint32_t y = u32year - (u32month <= 2);
+    const uint32_t era = y / 400;
+    const uint32_t yoe = y - era * 400;
+    const uint32_t doy = (153 * (u32month > 2 ? u32month - 3 : u32month + 9) + 2) / 5 + u32day - 1;
+    const uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+    return (era * 146097 + doe - 719468) * 86400 + u32tod_s;
+}
+
+/// @brief Converts unix time to the civil date & time of day, no libc involved.
+/// @param u32unix Unix time, s.
+/// @param pc Ptr to the date & time.
+void NMEAunix2civil(uint32_t u32unix, NMEAcivil *pc)
+{
+    /* The civil from days of H.Hinnant, the inverse of the above. */
+    const uint32_t days = u32unix / 86400 + 719468;
+    const uint32_t era = days / 146097;
+    const uint32_t doe = days - era * 146097;
+    const uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const uint32_t mp = (5 * doy + 2) / 153;
+    const uint32_t month = mp < 10 ? mp + 3 : mp - 9;
+
+    pc->_u16_year = (uint16_t)(yoe + era * 400 + (month <= 2));
+    pc->_u8_month = (uint8_t)month;
+    pc->_u8_day = (uint8_t)(doy - (153 * mp + 2) / 5 + 1);
+
+    const uint32_t tod_s = u32unix % 86400;
+    pc->_u8_hour = (uint8_t)(tod_s / 3600);
+    pc->_u8_min = (uint8_t)(tod_s / 60 % 60);
+    pc->_u8_sec = (uint8_t)(tod_s % 60);
+}
+
+/// @brief Parses an unsigned integer field of exactly n digits, n = 0 is any.
+/// @return 0 if OK, 1 if the field is empty, -1 on bad format.
+static int NMEAparseUint(const char *p, uint32_t u32len, uint32_t u32digits, uint32_t *pu32val)
+{
+    if(!u32len)
+    {
+        return 1;
+    }
+    if((u32digits && u32len != u32digits) || u32len > 9)
+    {
+        return -1;
+    }
+
+    uint32_t u32v = 0;
+    for(uint32_t i = 0; i < u32len; ++i)
+    {
+        if(p[i] < '0' || p[i] > '9')
+        {
+            return -1;
+        }
+        u32v = u32v * 10 + (p[i] - '0');
+    }
+    *pu32val = u32v;
+
+    return 0;
+}
+
+/// @brief Decodes the field of time of day, hhmmss[.sss].
+/// @return 0 if OK or the field is empty, -1 on bad format.
+static int NMEAdecodeTime(const NMEAtokens *pt, uint32_t ix, NMEAsentence *ps)
+{
+    uint32_t u32len;
+    const char *p = NMEAfield(pt, ix, &u32len);
+
+    int64_t i64v;
+    const int ir = NMEAparseFixed(p, u32len, 3, &i64v);
+    if(ir)
+    {
+        return ir > 0 ? 0 : -1;
+    }
+
+    const uint32_t hhmmss = (uint32_t)(i64v / 1000);
+    const uint32_t hh = hhmmss / 10000, mm = hhmmss / 100 % 100, ss = hhmmss % 100;
+    if(i64v < 0 || hh > 23 || mm > 59 || ss > 60)
+    {
+        return -1;
+    }
+
+    ps->_u32_tod_ms = ((hh * 60 + mm) * 60 + ss) * 1000 + (uint32_t)(i64v % 1000);
+    ps->_u8_has_time = 1;
+
+    return 0;
+}
+
+/// @brief Decodes the pair of lat, N/S, lon, E/W fields.
+/// @return 0 if OK or the fields are empty, -1 on bad format.
+static int NMEAdecodePos(const NMEAtokens *pt, uint32_t ix, NMEAsentence *ps)
+{
+    uint32_t u32lat_len, u32ns_len, u32lon_len, u32ew_len;
+    const char *plat = NMEAfield(pt, ix, &u32lat_len);
+    const char *pns = NMEAfield(pt, ix + 1, &u32ns_len);
+    const char *plon = NMEAfield(pt, ix + 2, &u32lon_len);
+    const char *pew = NMEAfield(pt, ix + 3, &u32ew_len);
+    if(!u32lat_len && !u32lon_len)
+    {
+        return 0;
+    }
+
+    if(1 != u32ns_len || 1 != u32ew_len
+       || NMEAparseLatLon(plat, u32lat_len, *pns, &ps->_i32_lat_1e7)
+       || NMEAparseLatLon(plon, u32lon_len, *pew, &ps->_i32_lon_1e7)
+       || ps->_i32_lat_1e7 > 900000000 || ps->_i32_lat_1e7 < -900000000)
+    {
+        return -1;
+    }
+    ps->_u8_has_pos = 1;
+
+    return 0;
+}
+
+/// @brief Decodes a DOP field to DOP * 100.
+/// @return 0 if OK or the field is empty, -1 on bad format.
+static int NMEAdecodeDOP(const NMEAtokens *pt, uint32_t ix, uint16_t *pu16dop_100)
+{
+    uint32_t u32len;
+    const char *p = NMEAfield(pt, ix, &u32len);
+
+    int64_t i64v;
+    const int ir = NMEAparseFixed(p, u32len, 2, &i64v);
+    if(ir)
+    {
+        return ir > 0 ? 0 : -1;
+    }
+    *pu16dop_100 = i64v < 0 ? 0 : (i64v > 0xFFFF ? 0xFFFF : (uint16_t)i64v);
+
+    return 0;
+}
+
+/// @brief RMC: time, status, lat, N/S, lon, E/W, speed, course, date, ...
+static int NMEAdecodeRMC(const NMEAtokens *pt, NMEAsentence *ps)
+{
+    uint32_t u32len, u32date;
+    const char *pstatus = NMEAfield(pt, 2, &u32len);
+    ps->_u8_is_valid = 1 == u32len && 'A' == *pstatus;
+
+    if(NMEAdecodeTime(pt, 1, ps) || NMEAdecodePos(pt, 3, ps))
+    {
+        return -1;
+    }
+
+    const char *pdate = NMEAfield(pt, 9, &u32len);
+    const int ir = NMEAparseUint(pdate, u32len, 6, &u32date);
+    if(ir < 0)
+    {
+        return -1;
+    }
+    if(!ir && ps->_u8_has_time)
+    {
+        const uint32_t dd = u32date / 10000, mm = u32date / 100 % 100, yy = u32date % 100;
+        if(dd < 1 || dd > 31 || mm < 1 || mm > 12)
+        {
+            return -1;
+        }
+        ps->_u32_unixtime = NMEAcivil2UNIX(2000 + yy, mm, dd, ps->_u32_tod_ms / 1000);
+        ps->_u8_has_date = 1;
+    }
+
+    return 0;
+}
+
+/// @brief GGA: time, lat, N/S, lon, E/W, quality, sats, HDOP, alt, M, ...
+static int NMEAdecodeGGA(const NMEAtokens *pt, NMEAsentence *ps)
+{
+    if(NMEAdecodeTime(pt, 1, ps) || NMEAdecodePos(pt, 2, ps))
+    {
+        return -1;
+    }
+
+    uint32_t u32len, u32v = 0;
+    const char *p = NMEAfield(pt, 6, &u32len);
+    if(NMEAparseUint(p, u32len, 1, &u32v) < 0)
+    {
+        return -1;
+    }
+    ps->_u8_quality = u32v;
+    ps->_u8_is_valid = u32v > 0;
+
+    u32v = 0;
+    p = NMEAfield(pt, 7, &u32len);
+    if(NMEAparseUint(p, u32len, 0, &u32v) < 0 || u32v > 255)
+    {
+        return -1;
+    }
+    ps->_u8_sats = u32v;
+
+    int64_t i64alt_cm = 0;
+    p = NMEAfield(pt, 9, &u32len);
+    if(NMEAdecodeDOP(pt, 8, &ps->_u16_hdop_100) || NMEAparseFixed(p, u32len, 2, &i64alt_cm) < 0)
+    {
+        return -1;
+    }
+    ps->_i32_alt_cm = (int32_t)i64alt_cm;
+
+    return 0;
+}
+
+/// @brief GSA: mode, fix, 12 x PRN, PDOP, HDOP, VDOP[, system id].
+static int NMEAdecodeGSA(const NMEAtokens *pt, NMEAsentence *ps)
+{
+    uint32_t u32len, u32v = 1;
+    const char *p = NMEAfield(pt, 2, &u32len);
+    if(NMEAparseUint(p, u32len, 1, &u32v) < 0 || u32v < 1 || u32v > 3)
+    {
+        return -1;
+    }
+    ps->_u8_fix_mode = u32v;
+    ps->_u8_is_valid = u32v > 1;
+
+    for(uint32_t ix = 3; ix < 15; ++ix)
+    {
+        NMEAfield(pt, ix, &u32len);
+        ps->_u8_sats += 0 != u32len;
+    }
+
+    return NMEAdecodeDOP(pt, 15, &ps->_u16_pdop_100) || NMEAdecodeDOP(pt, 16, &ps->_u16_hdop_100)
+        || NMEAdecodeDOP(pt, 17, &ps->_u16_vdop_100) ? -1 : 0;
+}
+
+/// @brief ZDA: time, day, month, year, tz hours, tz minutes. It has no status, it is
+/// @brief valid when both the time and the date parse.
+static int NMEAdecodeZDA(const NMEAtokens *pt, NMEAsentence *ps)
+{
+    if(NMEAdecodeTime(pt, 1, ps))
+    {
+        return -1;
+    }
+
+    uint32_t u32len, dd = 0, mm = 0, yyyy = 0;
+    const char *p = NMEAfield(pt, 2, &u32len);
+    const int ird = NMEAparseUint(p, u32len, 2, &dd);
+    p = NMEAfield(pt, 3, &u32len);
+    const int irm = NMEAparseUint(p, u32len, 2, &mm);
+    p = NMEAfield(pt, 4, &u32len);
+    const int iry = NMEAparseUint(p, u32len, 4, &yyyy);
+    if(ird < 0 || irm < 0 || iry < 0)
+    {
+        return -1;
+    }
+    if(!ird && !irm && !iry && ps->_u8_has_time)
+    {
+        if(dd < 1 || dd > 31 || mm < 1 || mm > 12 || yyyy < 1970 || yyyy > 2105)
+        {
+            return -1;
+        }
+        ps->_u32_unixtime = NMEAcivil2UNIX(yyyy, mm, dd, ps->_u32_tod_ms / 1000);
+        ps->_u8_has_date = 1;
+    }
+    ps->_u8_is_valid = ps->_u8_has_time && ps->_u8_has_date;
+
+    return 0;
+}
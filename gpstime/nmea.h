@@ -0,0 +1,146 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  nmea.h - Zero-copy NMEA 0183 sentence parser.
+//
+//
+//  DESCRIPTION
+//
+//      The tokenizer makes a single pass over the sentence: it checks the frame,
+//  accumulates the checksum and records the offset of every field, the sentence
+//  is not modified nor copied. Then the decoder of the sentence type is looked up
+//  by the table and it picks the fields it needs by their offsets. Any talker is
+//  accepted (GP, GN, GL, GA, GB...), RMC, GGA, GSA & ZDA are decoded. Lat & lon
+//  are converted by integer math to degrees * 1e7.
+//      It is kept free of any pico SDK dependency, so it's checked off-target.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//      Rev 0.2   16 Oct 2026   Unix time to civil date & time.
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef NMEA_H_
+#define NMEA_H_
+
+#include <stdint.h>
+
+enum
+{
+    eNMEAmaxFields = 24,                        /* Fields stored, the rest are ignored. */
+    eNMEAmaxLen = 255                           /* The longest sentence. */
+};
+
+typedef enum
+{
+    eNMEA_UNKNOWN = 0,                          /* A valid sentence w/o decoder. */
+    eNMEA_RMC,
+    eNMEA_GGA,
+    eNMEA_GSA,
+    eNMEA_ZDA,
+
+    eNMEA_ERR_FRAME = -1,                       /* No '$', too short or too long. */
+    eNMEA_ERR_CHECKSUM = -2,                    /* No '*hh' or a mismatch. */
+    eNMEA_ERR_FIELD = -3                        /* A field of bad format or too few fields. */
+
+} NMEAtype;
+
+typedef struct
+{
+    const char *_psz;                           /* The sentence, it is not modified. */
+    uint8_t _u8_nfields;                        /* Fields in the sentence, address is #0. */
+    uint8_t _pu8_ofs[eNMEAmaxFields + 1];       /* Field offsets, +1 is past the last one. */
+
+} NMEAtokens;
+
+typedef struct
+{
+    NMEAtype _type;
+    char _talker[2];                            /* GP, GN, GL... */
+
+    uint8_t _u8_is_valid;                       /* RMC 'A', GGA quality > 0, GSA 2D/3D fix. */
+    uint8_t _u8_has_time;                       /* The time of day is set. */
+    uint8_t _u8_has_date;                       /* The date is set, unix time is valid. */
+    uint8_t _u8_has_pos;                        /* The lat & lon are set. */
+
+    uint32_t _u32_tod_ms;                       /* Time of day, ms. */
+    uint32_t _u32_unixtime;                     /* Unix time, s, if the date is set. */
+    int32_t _i32_lat_1e7, _i32_lon_1e7;         /* Degrees * 1e7, N & E positive. */
+
+    uint8_t _u8_quality;                        /* GGA fix quality. */
+    uint8_t _u8_sats;                           /* GGA sats in use, GSA sats listed. */
+    uint8_t _u8_fix_mode;                       /* GSA 1 none, 2 2D, 3 3D. */
+    uint16_t _u16_pdop_100;                     /* GSA PDOP * 100. */
+    uint16_t _u16_hdop_100;                     /* GGA & GSA HDOP * 100. */
+    uint16_t _u16_vdop_100;                     /* GSA VDOP * 100. */
+    int32_t _i32_alt_cm;                        /* GGA altitude above MSL, cm. */
+
+} NMEAsentence;
+
+typedef struct
+{
+    uint16_t _u16_year;
+    uint8_t _u8_month, _u8_day;                 /* 1...12, 1...31. */
+    uint8_t _u8_hour, _u8_min, _u8_sec;
+
+} NMEAcivil;
+
+int NMEAtokenize(const char *pline, uint32_t u32len, NMEAtokens *pt);
+int NMEAparse(const char *pline, uint32_t u32len, NMEAsentence *ps);
+
+int NMEAparseFixed(const char *p, uint32_t u32len, uint32_t u32decimals, int64_t *pi64val);
+int NMEAparseLatLon(const char *p, uint32_t u32len, char hemi, int32_t *pi32deg_1e7);
+uint32_t NMEAcivil2UNIX(uint32_t u32year, uint32_t u32month, uint32_t u32day, uint32_t u32tod_s);
+void NMEAunix2civil(uint32_t u32unix, NMEAcivil *pc);
+
+/// @brief Obtains the field of the sentence tokenized.
+/// @param pt Ptr to tokens.
+/// @param ix The index of the field, the address is #0.
+/// @param pu32len Ptr to the length of the field, 0 if it is empty or absent.
+/// @return Ptr to the field in the sentence.
+static inline const char *NMEAfield(const NMEAtokens *pt, uint32_t ix, uint32_t *pu32len)
+{
+    if(ix >= pt->_u8_nfields || ix >= eNMEAmaxFields)
+    {
+        *pu32len = 0;
+        return pt->_psz;
+    }
+
+    *pu32len = pt->_pu8_ofs[ix + 1] - pt->_pu8_ofs[ix] - 1;
+    return pt->_psz + pt->_pu8_ofs[ix];
+}
+
+#endif
@@ -0,0 +1,99 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  ppscap.c - PPS timestamps captured by PIO.
+//
+//
+//  DESCRIPTION
+//
+//      See ppscap.h.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//      Rev 0.2   16 Oct 2026   The estimation is moved to ppsest.h.
+//      Rev 0.3   17 Oct 2026   The interval longer than the wrap of count is dropped.
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <string.h>
+
+#include "ppscap.h"
+
+/// @brief Initializes the capture.
+/// @param pc Ptr to the capture.
+/// @param u32clk_hz The nominal CPU CLK freq., Hz.
+void PPScapInit(PPScapture *pc, uint32_t u32clk_hz)
+{
+    memset(pc, 0, sizeof(PPScapture));
+    pc->_u32_clk_hz = u32clk_hz;
+    pc->_u64_wrap_us = (1000000ULL << 32) * ePPScapCyclesPerCount / u32clk_hz;
+}
+
+/// @brief Feeds the count of the pulse captured.
+/// @param pc Ptr to the capture.
+/// @param u32count The count `pps_capture` has pushed.
+/// @param u64now_us The uptime it's taken at, us, the coarse check of the wrap.
+/// @param i32qerr_ps TIM-TP qErr of the pulse, ps, 0 if unknown.
+/// @param pi64dt_ps Ptr to the interval since the last pulse, ps of nominal CPU CLK.
+/// @return 1 if the interval is obtained, 0 if it's the first pulse or the last one
+/// @return is that long ago the count might have wrapped since.
+int PPScapPulse(PPScapture *pc, uint32_t u32count, uint64_t u64now_us, int32_t i32qerr_ps,
+                int64_t *pi64dt_ps)
+{
+    const uint64_t u64gap_us = u64now_us - pc->_u64_us_last;
+    pc->_u64_us_last = u64now_us;
+
+    const uint32_t u32dcount = pc->_u32_count_last - u32count;   /* It runs down. */
+    pc->_u32_count_last = u32count;
+    const uint64_t u64dcycles = (uint64_t)u32dcount * ePPScapCyclesPerCount;
+    pc->_u64_cycles += u64dcycles;
+
+    const int32_t i32qerr_last_ps = pc->_i32_qerr_last_ps;
+    pc->_i32_qerr_last_ps = i32qerr_ps;
+    if(!pc->_u32_pulses++ || u64gap_us + ePPScapMarginUs >= pc->_u64_wrap_us)
+    {
+        return 0;
+    }
+
+    /* cycles * 1e12 / clk in two steps against overflow; qErr = actual - ideal. */
+    const uint64_t u64clk = pc->_u32_clk_hz;
+    const uint64_t u64q = u64dcycles * 1000000u / u64clk;
+    const uint64_t u64r = u64dcycles * 1000000u - u64q * u64clk;
+    *pi64dt_ps = (int64_t)(u64q * 1000000u + (u64r * 1000000u + (u64clk >> 1)) / u64clk)
+               - i32qerr_ps + i32qerr_last_ps;
+
+    return 1;
+}
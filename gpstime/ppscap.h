@@ -0,0 +1,85 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  ppscap.h - PPS timestamps captured by PIO.
+//
+//
+//  DESCRIPTION
+//
+//      `pps_capture` PIO program (dco2.pio) latches a free running count on the
+//  rising edge of PPS, 2 CPU CLK cycles per count, so the timestamps are ~7.4 ns
+//  fine at 270 MHz instead of 1 us of the timer & the jitter of GPIO IRQ. The
+//  count is extended to 64-bit timeline of CPU CLK cycles and TIM-TP qErr of the
+//  pulse is subtracted, the interval between pulses is passed to the estimator
+//  of CPU CLK error (ppsest.h). The count wraps every 2^33 cycles, ~31.8 s at
+//  270 MHz, so the interval of the pulses further apart by the uptime is dropped.
+//      It is kept free of any pico SDK dependency, so it's checked off-target.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//      Rev 0.2   16 Oct 2026   The estimation is moved to ppsest.h.
+//      Rev 0.3   17 Oct 2026   The interval longer than the wrap of count is dropped.
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef PPSCAP_H_
+#define PPSCAP_H_
+
+#include <stdint.h>
+
+enum
+{
+    ePPScapCyclesPerCount = 2,                  /* Must match the loop of `pps_capture`. */
+    ePPScapMarginUs = 1000000                   /* The uptime is of the drain, not of the pulse. */
+};
+
+typedef struct
+{
+    uint32_t _u32_clk_hz;                       /* The nominal CPU CLK freq., Hz. */
+    uint64_t _u64_wrap_us;                      /* The wrap period of the count, us. */
+    uint64_t _u64_us_last;                      /* The uptime of the last pulse, us. */
+    uint32_t _u32_count_last;                   /* The count of the last pulse. */
+    uint64_t _u64_cycles;                       /* CPU CLK cycles of the last pulse. */
+    int32_t _i32_qerr_last_ps;                  /* qErr of the last pulse. */
+    uint32_t _u32_pulses;                       /* Pulses seen. */
+
+} PPScapture;
+
+void PPScapInit(PPScapture *pc, uint32_t u32clk_hz);
+int PPScapPulse(PPScapture *pc, uint32_t u32count, uint64_t u64now_us, int32_t i32qerr_ps,
+                int64_t *pi64dt_ps);
+
+#endif
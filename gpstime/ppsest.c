@@ -0,0 +1,236 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  ppsest.c - Estimators of CPU CLK error of PPS intervals.
+//
+//
+//  DESCRIPTION
+//
+//      See ppsest.h.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <string.h>
+
+#include "ppsest.h"
+
+static const char *spKindName[ePPSestKinds] = { "WINDOW", "KALMAN" };
+
+static int PPSestWindowStep(PPSestimator *pe, int64_t i64d_ps, uint32_t u32n);
+static int PPSestKalmanStep(PPSestimator *pe, int64_t i64d_ps, uint32_t u32n);
+static uint64_t PPSestSqrt(uint64_t u64x);
+
+/// @brief Initializes the estimator.
+/// @param pe Ptr to the estimator.
+/// @param kind The estimator kind.
+/// @param u32sigma_ps 1 sigma noise of a timestamp, ps.
+/// @param u32memory The memory of ePPSestKalman, pulses.
+void PPSestInit(PPSestimator *pe, PPSestKind kind, uint32_t u32sigma_ps, uint32_t u32memory)
+{
+    memset(pe, 0, sizeof(PPSestimator));
+    pe->_kind = kind < ePPSestKinds ? kind : ePPSestKalman;
+    pe->_u32_sigma_ps = u32sigma_ps;
+    pe->_u32_memory = u32memory < 2 ? 2 : u32memory > ePPSestMaxMemory ? ePPSestMaxMemory : u32memory;
+    pe->_u32_k = 1;                             /* The origin. */
+}
+
+/// @brief Feeds the interval between consecutive pulses.
+/// @param pe Ptr to the estimator.
+/// @param i64dt_ps The interval, ps of nominal CPU CLK.
+/// @return 1 if the estimate is updated, 0 if not yet, -1 if the interval is rejected.
+int PPSestInterval(PPSestimator *pe, int64_t i64dt_ps)
+{
+    ++pe->_u32_intervals;
+
+    /* The whole seconds elapsed (pulses may be missed) & the phase step. */
+    const int64_t i64n = (i64dt_ps + PPSEST_SECOND_PS / 2) / PPSEST_SECOND_PS;
+    const int64_t i64d_ps = i64dt_ps - i64n * PPSEST_SECOND_PS;
+    const int64_t i64dmax_ps = (int64_t)ePPSestMaxDevPPM * 1000000LL * i64n;
+    const int is_sane = i64n > 0 && i64n <= ePPSestMaxGap && i64d_ps < i64dmax_ps && -i64d_ps < i64dmax_ps;
+
+    int r;
+    switch(pe->_kind)
+    {
+        case ePPSestWindow:
+            r = is_sane ? PPSestWindowStep(pe, i64d_ps, (uint32_t)i64n) : -1;
+        break;
+
+        default:
+            if(is_sane)
+            {
+                r = PPSestKalmanStep(pe, i64d_ps, (uint32_t)i64n);
+            }
+            else
+            {
+                /* Spurious or missed: the phase predicted is kept against the new timestamp. */
+                pe->_i64_phase_q += pe->_i64_freq_q * (i64n > 0 ? i64n : 0) - (i64d_ps << ePPSestFracBits);
+                if(i64n > ePPSestMaxGap)
+                {
+                    pe->_u32_reject_run = ePPSestResync - 1;    /* Too long to predict over. */
+                }
+                r = -1;
+            }
+        break;
+    }
+
+    if(r < 0)
+    {
+        ++pe->_u32_rejects;
+        if(++pe->_u32_reject_run >= ePPSestResync && ePPSestKalman == pe->_kind)
+        {
+            pe->_u32_k = 1;                     /* This pulse is the new origin. */
+            pe->_i64_phase_q = 0;
+            pe->_u32_reject_run = 0;
+        }
+    }
+    else
+    {
+        pe->_u32_reject_run = 0;
+    }
+
+    return r;
+}
+
+/// @brief Obtains the name of the estimator kind.
+const char *PPSestKindName(PPSestKind kind)
+{
+    return kind < ePPSestKinds ? spKindName[kind] : "?";
+}
+
+/// @brief The legacy window of ePPSestWindowLen pulses & its low pass.
+static int PPSestWindowStep(PPSestimator *pe, int64_t i64d_ps, uint32_t u32n)
+{
+    pe->_i64_phase_ps += i64d_ps;
+    pe->_u32_time_s += u32n;
+
+    pe->_u32_ix = (pe->_u32_ix + 1) % ePPSestWindowLen;
+    const int64_t i64dphase_ps = pe->_i64_phase_ps - pe->_pi64_phase_ps[pe->_u32_ix];
+    const int64_t i64span_s = pe->_u32_time_s - pe->_pu32_time_s[pe->_u32_ix];
+    pe->_pi64_phase_ps[pe->_u32_ix] = pe->_i64_phase_ps;
+    pe->_pu32_time_s[pe->_u32_ix] = pe->_u32_time_s;
+
+    if(++pe->_u32_k <= ePPSestWindowLen)
+    {
+        return 0;                               /* The window isn't full yet. */
+    }
+
+    const int64_t i64ppb_1k = i64dphase_ps / i64span_s;
+    if(i64ppb_1k >= (int64_t)ePPSestMaxDevPPM * 1000000LL || -i64ppb_1k >= (int64_t)ePPSestMaxDevPPM * 1000000LL)
+    {
+        return -1;
+    }
+
+    if(pe->_u8_is_valid)
+    {
+        pe->_i64_ppb_1k += (i64ppb_1k - pe->_i64_ppb_1k) >> ePPSestWindowShift;
+    }
+    else
+    {
+        pe->_i64_ppb_1k = i64ppb_1k;
+        pe->_u8_is_valid = 1;
+    }
+    pe->_i64_sigma_ppb_1k = (int64_t)PPSestSqrt(2ull * pe->_u32_sigma_ps * pe->_u32_sigma_ps) / i64span_s;
+
+    return 1;
+}
+
+/// @brief The 2-state filter of phase & frequency.
+static int PPSestKalmanStep(PPSestimator *pe, int64_t i64d_ps, uint32_t u32n)
+{
+    /* The gains of the k-th timestamp: alpha = 2(2k-1) / k(k+1), beta = 6 / k(k+1). */
+    const int64_t k = pe->_u32_k + 1 < pe->_u32_memory ? pe->_u32_k + 1 : pe->_u32_memory;
+    const int64_t i64den = k * (k + 1);
+    const int64_t i64alpha = 2 * (2 * k - 1);
+
+    const int64_t i64nu_q = (i64d_ps << ePPSestFracBits) - pe->_i64_phase_q - pe->_i64_freq_q * u32n;
+
+    /* The innovation variance is R / (1 - alpha), nothing to gate before the third timestamp. */
+    if(k > 2)
+    {
+        const uint64_t u64r = (uint64_t)pe->_u32_sigma_ps * pe->_u32_sigma_ps;
+        const uint64_t u64g = (uint64_t)ePPSestGateSigma * ePPSestGateSigma * u64r;
+        const int64_t i64gate_ps = PPSestSqrt(u64g + u64g / (i64den - i64alpha) * i64alpha);
+        const int64_t i64nu_ps = i64nu_q >> ePPSestFracBits;
+        if(i64nu_ps > i64gate_ps || -i64nu_ps > i64gate_ps)
+        {
+            pe->_i64_phase_q = -i64nu_q;        /* The phase predicted is kept. */
+            return -1;
+        }
+    }
+
+    pe->_i64_freq_q += i64nu_q * 6 / (i64den * u32n);
+    pe->_i64_phase_q = i64nu_q * (i64alpha - i64den) / i64den;
+    if(pe->_u32_k < pe->_u32_memory)
+    {
+        ++pe->_u32_k;
+    }
+
+    /* The slope of the least squares fit of k timestamps: var = 12 R / k(k^2 - 1). */
+    const uint64_t u64r = (uint64_t)pe->_u32_sigma_ps * pe->_u32_sigma_ps;
+    pe->_i64_sigma_ppb_1k = PPSestSqrt(u64r * 12u / (uint64_t)(k * (k * k - 1)));
+    pe->_i64_ppb_1k = (pe->_i64_freq_q + (1 << (ePPSestFracBits - 1))) >> ePPSestFracBits;
+    pe->_u8_is_valid = 1;
+
+    return 1;
+}
+
+/// @brief Integer square root, floor.
+static uint64_t PPSestSqrt(uint64_t u64x)
+{
+    uint64_t u64r = 0, u64bit = 1ull << 62;
+    while(u64bit > u64x)
+    {
+        u64bit >>= 2;
+    }
+    while(u64bit)
+    {
+        if(u64x >= u64r + u64bit)
+        {
+            u64x -= u64r + u64bit;
+            u64r = (u64r >> 1) + u64bit;
+        }
+        else
+        {
+            u64r >>= 1;
+        }
+        u64bit >>= 2;
+    }
+
+    return u64r;
+}
@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  ppsest.h - Estimators of CPU CLK error of PPS intervals.
+//
+//
+//  DESCRIPTION
+//
+//      The interval between consecutive PPS, as measured by CPU CLK timeline in ps
+//  of nominal CLK (qErr corrected), is fed to one of the estimators selectable at
+//  run time:
+//      ePPSestWindow is the legacy one: the phase over the window of 32 pulses,
+//  its low pass of 1/4 & hard rejection of windows off more than 250 ppm. The first
+//  estimate is there in 32 s & a glitch within the bound stays in the estimate for
+//  32 s more.
+//      ePPSestKalman is a 2-state (phase & frequency) filter. Its gains are the
+//  ones of Kalman filter of the diffuse start, i.e. of the recursive linear fit of
+//  timestamps by least squares, until u32memory pulses, then they're frozen at the
+//  steady state. So the first estimate is ready at the second pulse, it's exact
+//  in the least squares sense while the memory grows and tracks CLK wander after.
+//  The innovation of each pulse is gated at 5 sigma, a glitch is rejected with the
+//  phase predicted kept, several consecutive rejects restart the filter.
+//      Both report the 1 sigma uncertainty of the estimate due to the timestamp
+//  noise given. All is integer, no floating point.
+//      It is kept free of any pico SDK dependency, so it's checked off-target.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef PPSEST_H_
+#define PPSEST_H_
+
+#include <stdint.h>
+
+#define PPSEST_SECOND_PS 1000000000000LL
+
+typedef enum
+{
+    ePPSestWindow = 0,                          /* 32 pulse window & low pass, legacy. */
+    ePPSestKalman,                              /* Phase & frequency filter. */
+
+    ePPSestKinds
+
+} PPSestKind;
+
+enum
+{
+    ePPSestWindowLen = 32,                      /* The window of ePPSestWindow, pulses. */
+    ePPSestWindowShift = 2,                     /* Its low pass of 1/4. */
+    ePPSestMaxDevPPM = 250,                     /* An interval off more than that is rejected. */
+    ePPSestMaxGap = 64,                         /* The longest interval, s. */
+    ePPSestMaxMemory = 1024,                    /* The longest memory of ePPSestKalman. */
+    ePPSestGateSigma = 5,                       /* The innovation gate of ePPSestKalman. */
+    ePPSestResync = 3,                          /* Consecutive rejects to restart it. */
+    ePPSestFracBits = 16                        /* The fraction of its state, bits. */
+};
+
+typedef struct
+{
+    PPSestKind _kind;
+    uint32_t _u32_sigma_ps;                     /* 1 sigma noise of a timestamp, ps. */
+    uint32_t _u32_memory;                       /* The gains of ePPSestKalman freeze there, pulses. */
+
+    uint32_t _u32_intervals;                    /* Intervals fed. */
+    uint32_t _u32_rejects;                      /* Intervals rejected. */
+    uint32_t _u32_reject_run;                   /* Consecutive ones. */
+    uint8_t _u8_is_valid;                       /* There is an estimate. */
+    int64_t _i64_ppb_1k;                        /* CPU CLK error, ppb * 1000, i.e. ps per s. */
+    int64_t _i64_sigma_ppb_1k;                  /* Its 1 sigma uncertainty, ppb * 1000. */
+
+    uint32_t _u32_k;                            /* Timestamps since (re)start. */
+
+    int64_t _pi64_phase_ps[ePPSestWindowLen];   /* ePPSestWindow: phase of the pulses of window. */
+    uint32_t _pu32_time_s[ePPSestWindowLen];    /* Their time, s. */
+    uint32_t _u32_ix;                           /* The last one. */
+    int64_t _i64_phase_ps;                      /* The phase of the last pulse. */
+    uint32_t _u32_time_s;                       /* Its time, s. */
+
+    int64_t _i64_phase_q;                       /* ePPSestKalman: phase less the last timestamp. */
+    int64_t _i64_freq_q;                        /* Its frequency, ps per s. Both << ePPSestFracBits. */
+
+} PPSestimator;
+
+void PPSestInit(PPSestimator *pe, PPSestKind kind, uint32_t u32sigma_ps, uint32_t u32memory);
+int PPSestInterval(PPSestimator *pe, int64_t i64dt_ps);
+const char *PPSestKindName(PPSestKind kind);
+
+/// @brief Obtains the CPU CLK error estimated.
+/// @return ppb, positive if CPU CLK is fast.
+static inline int32_t PPSestPPB(const PPSestimator *pe)
+{
+    return (int32_t)((pe->_i64_ppb_1k + (pe->_i64_ppb_1k < 0 ? -500 : 500)) / 1000);
+}
+
+#endif
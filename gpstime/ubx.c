@@ -0,0 +1,258 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  ubx.c - u-blox UBX binary protocol decoder & configurator.
+//
+//
+//  DESCRIPTION
+//
+//      See ubx.h.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <string.h>
+
+#include "ubx.h"
+#include "nmea.h"
+
+enum
+{
+    eUBXstIdle = 0,
+    eUBXstSync2,
+    eUBXstClass,
+    eUBXstId,
+    eUBXstLenLo,
+    eUBXstLenHi,
+    eUBXstPayload,
+    eUBXstCkA,
+    eUBXstCkB
+};
+
+/// @brief Feeds a char to the framer.
+/// @param pu Ptr to the framer.
+/// @param c The char received.
+/// @return 1 if a frame is received, its payload is in pu.
+/// @return 0 if the frame is incomplete, or it's skipped owing to its length.
+/// @return -1 on checksum or length error.
+int UBXfeed(UBXparser *pu, uint8_t c)
+{
+    switch(pu->_u8_state)
+    {
+        case eUBXstIdle:
+            pu->_u8_state = eUBXsync1 == c ? eUBXstSync2 : eUBXstIdle;
+            return 0;
+
+        case eUBXstSync2:
+            pu->_u8_state = eUBXsync2 == c ? eUBXstClass : eUBXstIdle;
+            pu->_u8_cka = pu->_u8_ckb = 0;
+            return 0;
+
+        case eUBXstCkA:
+            pu->_u8_state = c == pu->_u8_cka ? eUBXstCkB : eUBXstIdle;
+            break;
+
+        case eUBXstCkB:
+            pu->_u8_state = eUBXstIdle;
+            if(c != pu->_u8_ckb)
+            {
+                break;
+            }
+            ++pu->_u32_frames;
+            return pu->_u16_len <= eUBXmaxPayload ? 1 : 0;
+
+        default:
+            pu->_u8_cka += c;
+            pu->_u8_ckb += pu->_u8_cka;
+            switch(pu->_u8_state++)
+            {
+                case eUBXstClass:
+                    pu->_u8_cls = c;
+                    break;
+
+                case eUBXstId:
+                    pu->_u8_id = c;
+                    break;
+
+                case eUBXstLenLo:
+                    pu->_u16_len = c;
+                    break;
+
+                case eUBXstLenHi:
+                    pu->_u16_len |= (uint16_t)c << 8;
+                    pu->_u16_ix = 0;
+                    if(pu->_u16_len > eUBXmaxLen)
+                    {
+                        pu->_u8_state = eUBXstIdle;
+                        ++pu->_u32_errors;
+                        return -1;
+                    }
+                    pu->_u8_state = pu->_u16_len ? eUBXstPayload : eUBXstCkA;
+                    break;
+
+                case eUBXstPayload:
+                    if(pu->_u16_ix < eUBXmaxPayload)
+                    {
+                        pu->_pu8_payload[pu->_u16_ix] = c;
+                    }
+                    pu->_u8_state = ++pu->_u16_ix == pu->_u16_len ? eUBXstCkA : eUBXstPayload;
+                    break;
+            }
+            return 0;
+    }
+
+    if(eUBXstIdle == pu->_u8_state)
+    {
+        ++pu->_u32_errors;
+        return -1;
+    }
+
+    return 0;
+}
+
+/// @brief Decodes NAV-STATUS.
+/// @return 0 if OK, -1 if it's another frame.
+int UBXdecodeNavStatus(const UBXparser *pu, UBXnavStatus *ps)
+{
+    if(eUBX_CLS_NAV != pu->_u8_cls || eUBX_NAV_STATUS != pu->_u8_id || 16 != pu->_u16_len)
+    {
+        return -1;
+    }
+
+    const uint8_t *p = pu->_pu8_payload;
+    ps->_u32_itow_ms = UBXu32(p);
+    ps->_u8_gps_fix = p[4];
+    ps->_u8_flags = p[5];
+    ps->_u32_ttff_ms = UBXu32(p + 8);
+    ps->_u32_msss = UBXu32(p + 12);
+
+    return 0;
+}
+
+/// @brief Decodes NAV-TIMEUTC.
+/// @return 0 if OK, -1 if it's another frame.
+int UBXdecodeNavTimeUTC(const UBXparser *pu, UBXnavTimeUTC *pt)
+{
+    if(eUBX_CLS_NAV != pu->_u8_cls || eUBX_NAV_TIMEUTC != pu->_u8_id || 20 != pu->_u16_len)
+    {
+        return -1;
+    }
+
+    const uint8_t *p = pu->_pu8_payload;
+    pt->_u32_itow_ms = UBXu32(p);
+    pt->_u32_tacc_ns = UBXu32(p + 4);
+    pt->_i32_nano = (int32_t)UBXu32(p + 8);
+    pt->_u16_year = UBXu16(p + 12);
+    pt->_u8_month = p[14];
+    pt->_u8_day = p[15];
+    pt->_u8_hour = p[16];
+    pt->_u8_min = p[17];
+    pt->_u8_sec = p[18];
+    pt->_u8_valid = p[19];
+
+    return 0;
+}
+
+/// @brief Decodes TIM-TP.
+/// @return 0 if OK, -1 if it's another frame.
+int UBXdecodeTimTP(const UBXparser *pu, UBXtimTP *pt)
+{
+    if(eUBX_CLS_TIM != pu->_u8_cls || eUBX_TIM_TP != pu->_u8_id || 16 != pu->_u16_len)
+    {
+        return -1;
+    }
+
+    const uint8_t *p = pu->_pu8_payload;
+    pt->_u32_tow_ms = UBXu32(p);
+    pt->_u32_tow_sub_ms = UBXu32(p + 4);
+    pt->_i32_qerr_ps = (int32_t)UBXu32(p + 8);
+    pt->_u16_week = UBXu16(p + 12);
+    pt->_u8_flags = p[14];
+
+    return 0;
+}
+
+/// @brief Converts NAV-TIMEUTC to unix time, s.
+/// @return Unix time, 0 if UTC isn't valid yet.
+uint32_t UBXtimeUTC2UNIX(const UBXnavTimeUTC *pt)
+{
+    if(!(pt->_u8_valid & 4) || pt->_u16_year < 1970 || pt->_u8_month < 1 || pt->_u8_month > 12
+       || pt->_u8_day < 1 || pt->_u8_day > 31 || pt->_u8_hour > 23 || pt->_u8_min > 59 || pt->_u8_sec > 60)
+    {
+        return 0;
+    }
+
+    return NMEAcivil2UNIX(pt->_u16_year, pt->_u8_month, pt->_u8_day,
+                          (pt->_u8_hour * 60 + pt->_u8_min) * 60 + pt->_u8_sec);
+}
+
+/// @brief Builds UBX frame.
+/// @param pdst Ptr to the frame, u16len + 8 bytes.
+/// @return The length of the frame.
+uint32_t UBXbuild(uint8_t u8cls, uint8_t u8id, const uint8_t *ppayload, uint16_t u16len, uint8_t *pdst)
+{
+    pdst[0] = eUBXsync1;
+    pdst[1] = eUBXsync2;
+    pdst[2] = u8cls;
+    pdst[3] = u8id;
+    pdst[4] = u16len & 0xFF;
+    pdst[5] = u16len >> 8;
+    memcpy(pdst + 6, ppayload, u16len);
+
+    uint8_t cka = 0, ckb = 0;
+    for(uint32_t i = 2; i < 6u + u16len; ++i)
+    {
+        cka += pdst[i];
+        ckb += cka;
+    }
+    pdst[6 + u16len] = cka;
+    pdst[7 + u16len] = ckb;
+
+    return 8u + u16len;
+}
+
+/// @brief Builds CFG-MSG frame which sets the rate of the message on the current port.
+/// @param u8rate Once every u8rate solutions, 0 disables the message.
+/// @param pdst Ptr to the frame, 11 bytes.
+/// @return The length of the frame.
+uint32_t UBXbuildCfgMsg(uint8_t u8cls, uint8_t u8id, uint8_t u8rate, uint8_t *pdst)
+{
+    const uint8_t payload[3] = { u8cls, u8id, u8rate };
+
+    return UBXbuild(eUBX_CLS_CFG, eUBX_CFG_MSG, payload, sizeof(payload), pdst);
+}
@@ -0,0 +1,161 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  ubx.h - u-blox UBX binary protocol decoder & configurator.
+//
+//
+//  DESCRIPTION
+//
+//      The byte-wise framer of UBX frames (0xB5 0x62 class id length payload
+//  ck_a ck_b, 8-bit Fletcher checksum over class...payload), the decoders of
+//  NAV-STATUS, NAV-TIMEUTC & TIM-TP and the builders of CFG-MSG frames which
+//  switch them on. TIM-TP carries the quantization error (qErr) of the next PPS:
+//  the receiver issues the pulse on an edge of its own clock, so the pulse is off
+//  the ideal time by the sawtooth of up to a half period of that clock; it is
+//  subtracted from the PPS timestamp.
+//      It is kept free of any pico SDK dependency, so it's checked off-target.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef UBX_H_
+#define UBX_H_
+
+#include <stdint.h>
+
+enum
+{
+    eUBXsync1 = 0xB5,
+    eUBXsync2 = 0x62,
+    eUBXmaxPayload = 128,                       /* Payload kept, longer frames are skipped. */
+    eUBXmaxLen = 1024,                          /* A longer one is deemed as garbage. */
+
+    eUBX_CLS_NAV = 0x01,
+    eUBX_CLS_ACK = 0x05,
+    eUBX_CLS_CFG = 0x06,
+    eUBX_CLS_TIM = 0x0D,
+    eUBX_CLS_NMEA = 0xF0,
+
+    eUBX_NAV_STATUS = 0x03,
+    eUBX_NAV_TIMEUTC = 0x21,
+    eUBX_TIM_TP = 0x01,
+    eUBX_CFG_MSG = 0x01,
+
+    eUBX_NMEA_GLL = 0x01,
+    eUBX_NMEA_GSV = 0x03,
+    eUBX_NMEA_VTG = 0x05,
+
+    eUBXgpsUTCleapS = 18                        /* GPS - UTC, s, as of 2017. */
+};
+
+typedef struct
+{
+    uint8_t _u8_state;                          /* The framer state, 0 is idle. */
+    uint8_t _u8_cls, _u8_id;
+    uint16_t _u16_len, _u16_ix;
+    uint8_t _u8_cka, _u8_ckb;
+    uint32_t _u32_frames;                       /* Frames received w/o error. */
+    uint32_t _u32_errors;                       /* Checksum or length errors. */
+    uint8_t _pu8_payload[eUBXmaxPayload];
+
+} UBXparser;
+
+typedef struct
+{
+    uint32_t _u32_itow_ms;                      /* GPS time of week of the solution, ms. */
+    uint8_t _u8_gps_fix;                        /* 0 none, 2 2D, 3 3D, 5 time only... */
+    uint8_t _u8_flags;                          /* Bit 0 gpsFixOk, bit 2 wknSet, bit 3 towSet. */
+    uint32_t _u32_ttff_ms;                      /* Time to first fix. */
+    uint32_t _u32_msss;                         /* Since startup, ms. */
+
+} UBXnavStatus;
+
+typedef struct
+{
+    uint32_t _u32_itow_ms;
+    uint32_t _u32_tacc_ns;                      /* Time accuracy estimate. */
+    int32_t _i32_nano;                          /* Fraction of second, -1e9...1e9 ns. */
+    uint16_t _u16_year;
+    uint8_t _u8_month, _u8_day, _u8_hour, _u8_min, _u8_sec;
+    uint8_t _u8_valid;                          /* Bit 0 validTOW, 1 validWKN, 2 validUTC. */
+
+} UBXnavTimeUTC;
+
+typedef struct
+{
+    uint32_t _u32_tow_ms;                       /* GPS time of week of the next pulse, ms. */
+    uint32_t _u32_tow_sub_ms;                   /* Its fraction, ms * 2^-32. */
+    int32_t _i32_qerr_ps;                       /* Its quantization error, ps. */
+    uint16_t _u16_week;
+    uint8_t _u8_flags;                          /* Bit 0 UTC based, bit 1 UTC available. */
+
+} UBXtimTP;
+
+int UBXfeed(UBXparser *pu, uint8_t c);
+
+int UBXdecodeNavStatus(const UBXparser *pu, UBXnavStatus *ps);
+int UBXdecodeNavTimeUTC(const UBXparser *pu, UBXnavTimeUTC *pt);
+int UBXdecodeTimTP(const UBXparser *pu, UBXtimTP *pt);
+uint32_t UBXtimeUTC2UNIX(const UBXnavTimeUTC *pt);
+
+uint32_t UBXbuild(uint8_t u8cls, uint8_t u8id, const uint8_t *ppayload, uint16_t u16len, uint8_t *pdst);
+uint32_t UBXbuildCfgMsg(uint8_t u8cls, uint8_t u8id, uint8_t u8rate, uint8_t *pdst);
+
+/// @brief Reads little endian u16 of the payload.
+static inline uint16_t UBXu16(const uint8_t *p)
+{
+    return p[0] | ((uint16_t)p[1] << 8);
+}
+
+/// @brief Reads little endian u32 of the payload.
+static inline uint32_t UBXu32(const uint8_t *p)
+{
+    return p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/// @brief Applies qErr of TIM-TP to the PPS timestamp.
+/// @param i64pps_ps The PPS timestamp, ps.
+/// @param i32qerr_ps qErr of the pulse, ps.
+/// @return The timestamp of the ideal pulse.
+/// @attention The convention is qErr = actual pulse - ideal one.
+static inline int64_t UBXcorrectPPS(int64_t i64pps_ps, int32_t i32qerr_ps)
+{
+    return i64pps_ps - i32qerr_ps;
+}
+
+#endif
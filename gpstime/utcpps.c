@@ -0,0 +1,179 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  utcpps.c - UTC of PPS edges.
+//
+//
+//  DESCRIPTION
+//
+//      See utcpps.h.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <string.h>
+#include "utcpps.h"
+
+/// @brief Corrects the time elapsed by the CPU CLK error.
+/// @param i64dt_us The time by the timer, us, < 2^37, the product fits with any sane ppb.
+/// @param i32ppb CPU CLK error, ppb, positive if the CLK is fast.
+/// @return The true time, us.
+static inline int64_t UTCppsTrueUs(int64_t i64dt_us, int32_t i32ppb)
+{
+    const int64_t i64corr = i64dt_us * i32ppb;
+    return i64dt_us - (i64corr + (i64corr < 0 ? -500000000 : 500000000)) / 1000000000;
+}
+
+/// @brief Obtains the whole seconds between two pulses.
+/// @param u64from_us The uptime of the earlier pulse, us.
+/// @param u64to_us The uptime of the later one, us.
+/// @param i32ppb CPU CLK error, ppb.
+/// @param pu32s Ptr to the seconds.
+/// @return 0 if OK, -1 if the later pulse is off the whole second.
+static int UTCppsSecondsBetween(uint64_t u64from_us, uint64_t u64to_us, int32_t i32ppb, uint32_t *pu32s)
+{
+    const int64_t i64dt_us = UTCppsTrueUs((int64_t)(u64to_us - u64from_us), i32ppb);
+    const int64_t i64s = (i64dt_us + UTCPPS_SECOND_US / 2) / UTCPPS_SECOND_US;
+    const int64_t i64off_us = i64dt_us - i64s * UTCPPS_SECOND_US;
+    *pu32s = (uint32_t)i64s;
+
+    return i64dt_us >= 0 && i64off_us < eUTCppsSnapUs && i64off_us > -eUTCppsSnapUs ? 0 : -1;
+}
+
+/// @brief Initializes the UTC of PPS, no pulse is labelled.
+/// @param pu Ptr to the context.
+void UTCppsInit(UTCpps *pu)
+{
+    memset(pu, 0, sizeof(UTCpps));
+}
+
+/// @brief Labels the last PPS edge by the time of a sentence.
+/// @param pu Ptr to the context.
+/// @param u32unix The time of the sentence, s.
+/// @param u32frac_us Its fraction of second, us, 0 if it's a whole second.
+/// @param u64pps_us The uptime of the last pulse, us, 0 if none yet.
+/// @param i32ppb CPU CLK error, ppb, positive if the CLK is fast.
+/// @param u64now_us The uptime the sentence is processed at, us.
+/// @return 1 if the pulse is labelled, 0 if the sentence doesn't label it,
+/// @return -1 if the label is new or disagrees, it waits for confirmation by a next pulse.
+int UTCppsLabel(UTCpps *pu, uint32_t u32unix, uint32_t u32frac_us, uint64_t u64pps_us, int32_t i32ppb,
+                uint64_t u64now_us)
+{
+    if(u32frac_us >= UTCPPS_SECOND_US - eUTCppsSnapUs)
+    {
+        ++u32unix;
+    }
+    else if(u32frac_us >= eUTCppsSnapUs)
+    {
+        return 0;                               /* Not a whole second, e.g. 5 Hz rate. */
+    }
+
+    if(!u64pps_us || u64now_us - u64pps_us >= eUTCppsLabelWindowUs)
+    {
+        return 0;                               /* The pulse of the second isn't here. */
+    }
+
+    uint32_t u32s;
+    int is_taken = pu->_u8_is_valid && !UTCppsSecondsBetween(pu->_u64_pps_us, u64pps_us, i32ppb, &u32s)
+                && pu->_u32_unix + u32s == u32unix;
+    if(!is_taken && pu->_u8_is_pending)
+    {
+        if(u64pps_us == pu->_u64_pending_us && u32unix == pu->_u32_pending_unix)
+        {
+            return -1;                          /* The same pulse again, e.g. RMC & ZDA. */
+        }
+        /* By the very next pulse, lest two late sentences confirm each other. */
+        is_taken = !UTCppsSecondsBetween(pu->_u64_pending_us, u64pps_us, i32ppb, &u32s)
+                && 1 == u32s && pu->_u32_pending_unix + 1 == u32unix;
+    }
+
+    if(!is_taken)
+    {
+        pu->_u32_pending_unix = u32unix;
+        pu->_u64_pending_us = u64pps_us;
+        pu->_u8_is_pending = 1;
+        pu->_u32_mismatches += pu->_u8_is_valid;
+
+        return -1;
+    }
+
+    pu->_u32_unix = u32unix;
+    pu->_u64_pps_us = u64pps_us;
+    pu->_u8_is_valid = 1;
+    pu->_u8_is_pending = 0;
+    ++pu->_u32_labels;
+
+    return 1;
+}
+
+/// @brief Obtains UTC of the instant.
+/// @param pu Ptr to the context.
+/// @param u64pps_us The uptime of the last pulse, us.
+/// @param i32ppb CPU CLK error, ppb, positive if the CLK is fast.
+/// @param u64now_us The uptime of the instant, us.
+/// @param pu64utc_us Ptr to UTC, us since the unix epoch.
+/// @return 0 if OK.
+/// @return -1 No pulse has been labelled.
+/// @return -2 The last pulse on the second has come 24 hrs or more ago.
+int UTCppsGet(const UTCpps *pu, uint64_t u64pps_us, int32_t i32ppb, uint64_t u64now_us, uint64_t *pu64utc_us)
+{
+    if(!pu->_u8_is_valid)
+    {
+        return -1;
+    }
+
+    /* The last pulse is the base unless it's a glitch. */
+    uint32_t u32unix = pu->_u32_unix;
+    uint64_t u64base_us = pu->_u64_pps_us;
+    uint32_t u32s;
+    if(u64pps_us > u64base_us && !UTCppsSecondsBetween(u64base_us, u64pps_us, i32ppb, &u32s))
+    {
+        u32unix += u32s;
+        u64base_us = u64pps_us;
+    }
+
+    const int64_t i64dt_us = (int64_t)(u64now_us - u64base_us);
+    if(i64dt_us >= eUTCppsMaxAgeS * UTCPPS_SECOND_US)
+    {
+        return -2;
+    }
+
+    *pu64utc_us = (uint64_t)u32unix * UTCPPS_SECOND_US + UTCppsTrueUs(i64dt_us, i32ppb);
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  utcpps.h - UTC of PPS edges.
+//
+//
+//  DESCRIPTION
+//
+//      The time of NMEA or UBX arrival lags the second it reports by up to hundreds
+//  of ms, the lag depends on the receiver, the baud & the main loop. The sentence
+//  of a whole second labels the PPS edge of that second instead: the label is
+//  taken if the last pulse has come less than 1 s ere the sentence is processed.
+//  A labelled pulse dates the next ones by the time elapsed, corrected by the CPU
+//  CLK error of GPS & rounded to whole seconds, so pulses missed don't matter and
+//  a pulse off the whole second (a glitch) is left out. The first label, or one
+//  which disagrees, is taken only when the label of the very next pulse confirms
+//  it: a leap second is taken ~2 s late, a single sentence late behind the next
+//  pulse is ignored.
+//      The UTC of any instant is then the second of the last pulse plus the time
+//  elapsed since it, in us of the timer corrected by the CPU CLK error.
+//      It is kept free of any pico SDK dependency, so it's checked off-target.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef UTCPPS_H_
+#define UTCPPS_H_
+
+#include <stdint.h>
+
+#define UTCPPS_SECOND_US 1000000LL
+
+enum
+{
+    eUTCppsLabelWindowUs = 1000000,             /* The pulse labelled precedes the sentence by less. */
+    eUTCppsSnapUs = 50000,                      /* Off the whole second by less is on it. */
+    eUTCppsMaxAgeS = 86400                      /* The time is expired since the last pulse. */
+};
+
+typedef struct
+{
+    uint32_t _u32_unix;                         /* UTC of the anchor pulse, s. */
+    uint64_t _u64_pps_us;                       /* Its uptime, us. */
+    uint32_t _u32_pending_unix;                 /* The label waiting for confirmation. */
+    uint64_t _u64_pending_us;
+    uint8_t _u8_is_valid;                       /* The anchor is set. */
+    uint8_t _u8_is_pending;
+    uint32_t _u32_labels;                       /* Labels taken. */
+    uint32_t _u32_mismatches;                   /* Labels disagreed with the anchor. */
+
+} UTCpps;
+
+void UTCppsInit(UTCpps *pu);
+int UTCppsLabel(UTCpps *pu, uint32_t u32unix, uint32_t u32frac_us, uint64_t u64pps_us, int32_t i32ppb,
+                uint64_t u64now_us);
+int UTCppsGet(const UTCpps *pu, uint64_t u64pps_us, int32_t i32ppb, uint64_t u64now_us, uint64_t *pu64utc_us);
+
+#endif
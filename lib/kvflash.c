@@ -0,0 +1,134 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  kvflash.c - Flash access of the key/value store on pico.
+//
+//
+//  DESCRIPTION
+//
+//      See kvflash.h.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//      Rev 0.2   17 Oct 2026   The other core is parked only if it runs from flash.
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+
+#include "kvflash.h"
+
+enum
+{
+    eKVflashOffset = PICO_FLASH_SIZE_BYTES - eKVregionBytes,
+    eKVflashTimeoutMs = 1000
+};
+
+typedef struct
+{
+    uint32_t _u32_offset;
+    const uint8_t *_pdata;
+    uint32_t _u32_len;
+
+} KVflashOp;
+
+static volatile int siParkOther = 1;
+
+static void KVflashDoErase(void *param)
+{
+    const KVflashOp *pop = param;
+    flash_range_erase(eKVflashOffset + pop->_u32_offset, FLASH_SECTOR_SIZE);
+}
+
+static void KVflashDoProgram(void *param)
+{
+    const KVflashOp *pop = param;
+    flash_range_program(eKVflashOffset + pop->_u32_offset, pop->_pdata, pop->_u32_len);
+}
+
+/// @brief Runs the flash operation while XIP is off: the other core is parked by
+/// @brief flash_safe_execute, unless it runs from RAM only; the IRQs of this core
+/// @brief are held off either way.
+static int KVflashRun(void (*pfn)(void *), KVflashOp *pop)
+{
+    if(siParkOther)
+    {
+        return PICO_OK == flash_safe_execute(pfn, pop, eKVflashTimeoutMs) ? 0 : -1;
+    }
+
+    const uint32_t u32irq = save_and_disable_interrupts();
+    pfn(pop);
+    restore_interrupts(u32irq);
+
+    return 0;
+}
+
+static int KVflashErase(void *pctx, uint32_t u32offset)
+{
+    (void)pctx;
+    KVflashOp op = { u32offset, NULL, 0 };
+
+    return KVflashRun(KVflashDoErase, &op);
+}
+
+static int KVflashProgram(void *pctx, uint32_t u32offset, const uint8_t *pdata, uint32_t u32len)
+{
+    (void)pctx;
+    KVflashOp op = { u32offset, pdata, u32len };
+
+    return KVflashRun(KVflashDoProgram, &op);
+}
+
+/// @brief Fills the flash access of the store region on pico.
+/// @param pflash Ptr to the flash access.
+void KVflashPico(KVflash *pflash)
+{
+    pflash->_pbase = (const volatile uint8_t *)(XIP_BASE + eKVflashOffset);
+    pflash->_pfn_erase = KVflashErase;
+    pflash->_pfn_program = KVflashProgram;
+    pflash->_pctx = NULL;
+}
+
+/// @brief Switches the park of the other core for the flash writes. It's on by
+/// @brief default.
+/// @param is_on 0 if the other core runs from RAM only & touches no XIP.
+void KVflashPicoParkOther(int is_on)
+{
+    siParkOther = is_on;
+}
@@ -0,0 +1,353 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  kvstore.c - Wear-leveled key/value store in flash.
+//
+//
+//  DESCRIPTION
+//
+//      See kvstore.h. The image is the header, {magic, seq, used, 0, crc}, and
+//  the entries, {key, 0, len, value padded to 4 bytes}; CRC-32 covers the header
+//  with crc of 0 & the entries.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <string.h>
+#include "kvstore.h"
+
+enum
+{
+    eKVoffMagic = 0,
+    eKVoffSeq = 4,
+    eKVoffUsed = 8,
+    eKVoffCRC = 12
+};
+
+static uint32_t KVget32(const volatile uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void KVput32(uint8_t *p, uint32_t u32v)
+{
+    p[0] = (uint8_t)u32v;
+    p[1] = (uint8_t)(u32v >> 8);
+    p[2] = (uint8_t)(u32v >> 16);
+    p[3] = (uint8_t)(u32v >> 24);
+}
+
+/// @brief Calculates CRC-32 (IEEE 802.3, reflected) of data.
+/// @param pdata Ptr to data.
+/// @param u32len The length, bytes.
+/// @return CRC-32.
+uint32_t KVstoreCRC32(const uint8_t *pdata, uint32_t u32len)
+{
+    uint32_t u32crc = 0xFFFFFFFFU;
+    while(u32len--)
+    {
+        u32crc ^= *pdata++;
+        for(int i = 0; i < 8; ++i)
+        {
+            u32crc = (u32crc >> 1) ^ (0xEDB88320U & -(u32crc & 1U));
+        }
+    }
+
+    return ~u32crc;
+}
+
+/// @brief Validates the snapshot of the slot.
+/// @param pkv Ptr to the store.
+/// @param slot The slot.
+/// @param pu32seq Ptr to its sequence number.
+/// @return 1 if valid, 0 if blank, -1 if bad.
+static int KVstoreCheckSlot(KVstore *pkv, int slot, uint32_t *pu32seq)
+{
+    const volatile uint8_t *ps = pkv->_flash._pbase + (uint32_t)slot * eKVslotBytes;
+    const uint32_t u32magic = KVget32(ps + eKVoffMagic);
+    if(0xFFFFFFFFU == u32magic)
+    {
+        return 0;
+    }
+
+    const uint32_t u32used = KVget32(ps + eKVoffUsed);
+    if(eKVmagic != u32magic || u32used > eKVslotBytes - eKVheaderBytes)
+    {
+        return -1;
+    }
+
+    /* RPix: The image is taken to RAM, the CRC is of it. */
+    uint8_t *pi = pkv->_image;
+    for(uint32_t i = 0; i < eKVheaderBytes + u32used; ++i)
+    {
+        pi[i] = ps[i];
+    }
+    const uint32_t u32crc = KVget32(pi + eKVoffCRC);
+    KVput32(pi + eKVoffCRC, 0);
+    if(u32crc != KVstoreCRC32(pi, eKVheaderBytes + u32used))
+    {
+        return -1;
+    }
+
+    *pu32seq = KVget32(ps + eKVoffSeq);
+    return 1;
+}
+
+/// @brief Opens the store, the last valid snapshot is loaded.
+/// @param pkv Ptr to the store.
+/// @param pflash Ptr to the flash access.
+/// @return 0 if a snapshot is loaded, 1 if the store is empty.
+int KVstoreOpen(KVstore *pkv, const KVflash *pflash)
+{
+    memset(pkv, 0, sizeof(KVstore));
+    pkv->_flash = *pflash;
+    pkv->_slot = -1;
+
+    for(int slot = 0; slot < eKVslots; ++slot)
+    {
+        uint32_t u32seq = 0;
+        const int ires = KVstoreCheckSlot(pkv, slot, &u32seq);
+        if(ires < 0)
+        {
+            ++pkv->_u32_errors;
+        }
+        else if(ires && (pkv->_slot < 0 || (int32_t)(u32seq - pkv->_u32_seq) > 0))
+        {
+            pkv->_slot = slot;
+            pkv->_u32_seq = u32seq;
+        }
+    }
+
+    if(pkv->_slot < 0)
+    {
+        memset(pkv->_image, 0xFF, sizeof(pkv->_image));
+        return 1;
+    }
+
+    uint32_t u32seq;
+    KVstoreCheckSlot(pkv, pkv->_slot, &u32seq);
+    pkv->_u16_used = (uint16_t)KVget32(pkv->_image + eKVoffUsed);
+
+    return 0;
+}
+
+/// @brief Finds the entry of the key.
+/// @return Its offset in the image, -1 if none.
+static int KVstoreFind(const KVstore *pkv, uint8_t u8key)
+{
+    const uint8_t *pi = pkv->_image;
+    for(int off = eKVheaderBytes; off < eKVheaderBytes + pkv->_u16_used; )
+    {
+        if(pi[off] == u8key)
+        {
+            return off;
+        }
+        off += 4 + ((pi[off + 2] | (pi[off + 3] << 8)) + 3) / 4 * 4;
+    }
+
+    return -1;
+}
+
+/// @brief Removes the entry at the offset of the image.
+static void KVstoreRemove(KVstore *pkv, int off)
+{
+    uint8_t *pi = pkv->_image;
+    const int len = 4 + ((pi[off + 2] | (pi[off + 3] << 8)) + 3) / 4 * 4;
+    memmove(pi + off, pi + off + len, eKVheaderBytes + pkv->_u16_used - off - len);
+    pkv->_u16_used -= len;
+    pkv->_u8_is_dirty = 1;
+}
+
+/// @brief Obtains the value of the key.
+/// @param pkv Ptr to the store.
+/// @param u8key The key.
+/// @param pdst Ptr to the value.
+/// @param u16len Its length, it should be the one it was set of.
+/// @return 0 if OK. -1 no such key or it's of another length.
+int KVstoreGet(const KVstore *pkv, uint8_t u8key, void *pdst, uint16_t u16len)
+{
+    const int off = KVstoreFind(pkv, u8key);
+    if(off < 0 || (pkv->_image[off + 2] | (pkv->_image[off + 3] << 8)) != u16len)
+    {
+        return -1;
+    }
+
+    memcpy(pdst, pkv->_image + off + 4, u16len);
+    return 0;
+}
+
+/// @brief Sets the value of the key in RAM, it's written by KVstoreCommit.
+/// @param pkv Ptr to the store.
+/// @param u8key The key.
+/// @param psrc Ptr to the value.
+/// @param u16len Its length.
+/// @return 0 if OK. -1 no room.
+int KVstoreSet(KVstore *pkv, uint8_t u8key, const void *psrc, uint16_t u16len)
+{
+    uint8_t *pi = pkv->_image;
+    const int off = KVstoreFind(pkv, u8key);
+    if(off >= 0)
+    {
+        const uint16_t u16was = pi[off + 2] | (pi[off + 3] << 8);
+        if(u16was == u16len)
+        {
+            if(memcmp(pi + off + 4, psrc, u16len))
+            {
+                memcpy(pi + off + 4, psrc, u16len);
+                pkv->_u8_is_dirty = 1;
+            }
+            return 0;
+        }
+
+        KVstoreRemove(pkv, off);    /* Of another length, it's removed & appended. */
+    }
+
+    const int len = 4 + (u16len + 3) / 4 * 4;
+    if(eKVheaderBytes + pkv->_u16_used + len > eKVslotBytes)
+    {
+        return -1;
+    }
+
+    uint8_t *pe = pi + eKVheaderBytes + pkv->_u16_used;
+    memset(pe, 0, len);
+    pe[0] = u8key;
+    pe[2] = (uint8_t)u16len;
+    pe[3] = (uint8_t)(u16len >> 8);
+    memcpy(pe + 4, psrc, u16len);
+    pkv->_u16_used += len;
+    pkv->_u8_is_dirty = 1;
+
+    return 0;
+}
+
+/// @brief Removes the key, it's written by KVstoreCommit.
+/// @param pkv Ptr to the store.
+/// @param u8key The key.
+void KVstoreDelete(KVstore *pkv, uint8_t u8key)
+{
+    const int off = KVstoreFind(pkv, u8key);
+    if(off >= 0)
+    {
+        KVstoreRemove(pkv, off);
+    }
+}
+
+/// @brief Removes all the keys, the store is wiped by the next commit.
+/// @param pkv Ptr to the store.
+void KVstoreClear(KVstore *pkv)
+{
+    pkv->_u16_used = 0;
+    pkv->_u8_is_dirty = 1;
+}
+
+/// @brief Checks the slot is erased.
+static int KVstoreIsBlank(const KVstore *pkv, int slot)
+{
+    const volatile uint8_t *ps = pkv->_flash._pbase + (uint32_t)slot * eKVslotBytes;
+    for(int i = 0; i < eKVslotBytes; ++i)
+    {
+        if(0xFF != ps[i])
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/// @brief Writes the image to the next slot, if it's changed.
+/// @param pkv Ptr to the store.
+/// @return 0 if written, 1 if nothing to write, -1 flash error.
+/// @attention The flash may be inaccessible for tens of ms while a sector is erased.
+int KVstoreCommit(KVstore *pkv)
+{
+    if(!pkv->_u8_is_dirty)
+    {
+        return 1;
+    }
+
+    enum { eSlotsPerSector = eKVsectorBytes / eKVslotBytes };
+    int slot = (pkv->_slot + 1) % eKVslots;
+    if(slot % eSlotsPerSector && !KVstoreIsBlank(pkv, slot))
+    {
+        /* RPix: A slot torn by power loss, the next sector is older than the last snapshot. */
+        slot = (slot / eSlotsPerSector + 1) * eSlotsPerSector % eKVslots;
+    }
+    if(!(slot % eSlotsPerSector))
+    {
+        ++pkv->_u32_erases;
+        if(pkv->_flash._pfn_erase(pkv->_flash._pctx, (uint32_t)slot * eKVslotBytes))
+        {
+            ++pkv->_u32_errors;
+            return -1;
+        }
+    }
+
+    uint8_t *pi = pkv->_image;
+    const uint32_t u32len = eKVheaderBytes + pkv->_u16_used;
+    KVput32(pi + eKVoffMagic, eKVmagic);
+    KVput32(pi + eKVoffSeq, pkv->_u32_seq + 1U);
+    KVput32(pi + eKVoffUsed, pkv->_u16_used);
+    KVput32(pi + eKVoffCRC, 0);
+    KVput32(pi + eKVoffCRC, KVstoreCRC32(pi, u32len));
+    memset(pi + u32len, 0xFF, eKVslotBytes - u32len);
+
+    const uint32_t u32prog = (u32len + eKVpageBytes - 1) / eKVpageBytes * eKVpageBytes;
+    if(pkv->_flash._pfn_program(pkv->_flash._pctx, (uint32_t)slot * eKVslotBytes, pi, u32prog))
+    {
+        ++pkv->_u32_errors;
+        return -1;
+    }
+
+    const volatile uint8_t *ps = pkv->_flash._pbase + (uint32_t)slot * eKVslotBytes;
+    for(uint32_t i = 0; i < u32len; ++i)
+    {
+        if(ps[i] != pi[i])
+        {
+            ++pkv->_u32_errors;
+            return -1;
+        }
+    }
+
+    pkv->_slot = slot;
+    ++pkv->_u32_seq;
+    pkv->_u8_is_dirty = 0;
+    ++pkv->_u32_commits;
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  kvstore.h - Wear-leveled key/value store in flash.
+//
+//
+//  DESCRIPTION
+//
+//      The store keeps the values of small keys as a snapshot image in RAM;
+//  KVstoreCommit writes the whole image to the next slot of a ring of slots in
+//  flash, with a sequence number & CRC-32. The slots are written in turn, so the
+//  wear is spread evenly, and a sector is erased only ere its first slot is
+//  written, that is when it holds the oldest snapshots. KVstoreOpen takes the
+//  valid snapshot of the highest sequence number.
+//      A power loss while a slot is written or a sector is erased leaves a slot of
+//  bad CRC, which is ignored, so the previous snapshot stands.
+//      The flash is accessed by the callbacks of KVflash, so it's checked off-target
+//  with a RAM-backed stand-in; see kvflash.h for the one of pico.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef KVSTORE_H_
+#define KVSTORE_H_
+
+#include <stdint.h>
+
+enum
+{
+    eKVsectorBytes = 4096,      /* Erase unit. */
+    eKVpageBytes = 256,         /* Program unit. */
+    eKVslotBytes = 1024,        /* Snapshot slot, max image. */
+    eKVsectors = 4,             /* Sectors of the ring. */
+    eKVslots = eKVsectors * eKVsectorBytes / eKVslotBytes,
+    eKVregionBytes = eKVsectors * eKVsectorBytes,
+    eKVheaderBytes = 16,
+    eKVmagic = 0x3153564B       /* `KVS1`. */
+};
+
+/* Flash access. The region is eKVregionBytes long, sector aligned; the offsets
+   are relative to it. The callbacks return 0 if OK. */
+typedef struct
+{
+    const volatile uint8_t *_pbase;      /* The region, memory mapped. */
+    int (*_pfn_erase)(void *pctx, uint32_t u32offset); /* Erases the sector. */
+    int (*_pfn_program)(void *pctx, uint32_t u32offset, const uint8_t *pdata,
+                        uint32_t u32len); /* Programs the pages, len is a multiple of page. */
+    void *_pctx;
+
+} KVflash;
+
+typedef struct
+{
+    KVflash _flash;
+    uint8_t _image[eKVslotBytes];        /* The snapshot, header & entries. */
+    uint16_t _u16_used;                  /* Bytes of entries. */
+    int _slot;                           /* The slot of the last snapshot, -1 if none. */
+    uint32_t _u32_seq;                   /* Its sequence number. */
+    uint8_t _u8_is_dirty;                /* The image differs of it. */
+
+    uint32_t _u32_commits;               /* Snapshots written. */
+    uint32_t _u32_erases;                /* Sectors erased. */
+    uint32_t _u32_errors;                /* Flash errors & bad slots. */
+
+} KVstore;
+
+int KVstoreOpen(KVstore *pkv, const KVflash *pflash);
+int KVstoreGet(const KVstore *pkv, uint8_t u8key, void *pdst, uint16_t u16len);
+int KVstoreSet(KVstore *pkv, uint8_t u8key, const void *psrc, uint16_t u16len);
+void KVstoreDelete(KVstore *pkv, uint8_t u8key);
+void KVstoreClear(KVstore *pkv);
+int KVstoreCommit(KVstore *pkv);
+
+uint32_t KVstoreCRC32(const uint8_t *pdata, uint32_t u32len);
+
+#endif
@@ -0,0 +1,184 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  dcogpsdo.c - GPS disciplining of the PIO based DCO.
+//
+//
+//  DESCRIPTION
+//
+//      See dcogpsdo.h.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//      Rev 0.2   16 Oct 2026   Temperature compensated holdover.
+//      Rev 0.3   16 Oct 2026   Warm start.
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "dcogpsdo.h"
+
+static void PioDCOGpsdoSetPPB(PioDcoGpsdo *pg, int64_t i64ppb);
+static void PioDCOGpsdoSlew(PioDcoGpsdo *pg, int64_t i64ppb);
+static void PioDCOGpsdoHoldover(PioDcoGpsdo *pg, uint64_t u64now_us);
+
+/// @brief Resets GPSDO state, no correction.
+/// @param pg Ptr to GPSDO state.
+/// @param state eDCOGPSDO_OFF or eDCOGPSDO_WAIT.
+void PioDCOGpsdoReset(PioDcoGpsdo *pg, enum PioDcoGpsdoState state)
+{
+    pg->_state = state;
+    pg->_i64_ppb = 0;
+    pg->_i64_scale = 0;
+    pg->_u64_holdover_us = 0;
+    pg->_i64_hold_delta_ppb = 0;
+}
+
+/// @brief Applies the correction saved, the holdover starts as of its save, so
+/// @brief the model follows the temperature since.
+/// @param pg Ptr to GPSDO state, not eDCOGPSDO_OFF.
+/// @param u64now_us Uptime, us.
+/// @param i64ppb The correction saved, ppb.
+/// @param i32mdeg The temperature it was saved at, mC.
+void PioDCOGpsdoWarm(PioDcoGpsdo *pg, uint64_t u64now_us, int64_t i64ppb, int32_t i32mdeg)
+{
+    if(eDCOGPSDO_OFF == pg->_state)
+    {
+        return;
+    }
+
+    PioDCOGpsdoSetPPB(pg, i64ppb);
+    PioDCOGpsdoHoldover(pg, u64now_us);
+    pg->_i32_hold_mdeg = i32mdeg;
+    ++pg->_ui32_updates;
+}
+
+/// @brief Updates the correction of the state of GPS, it's to be called periodically.
+/// @param pg Ptr to GPSDO state.
+/// @param u64now_us Uptime, us.
+/// @param ui32pps_count The count of PPS seen so far.
+/// @param is_valid The estimate is there & the fix is active.
+/// @param i64ppb The estimate of CPU CLK error, ppb.
+/// @return 1 if the correction has changed, 0 otherwise.
+/// @attention The temperature is the one of the model, see PioDCOTempSample.
+int PioDCOGpsdoStep(PioDcoGpsdo *pg, uint64_t u64now_us, uint32_t ui32pps_count,
+                    int is_valid, int64_t i64ppb)
+{
+    if(eDCOGPSDO_OFF == pg->_state)
+    {
+        return 0;
+    }
+
+    const int64_t i64was = pg->_i64_ppb;
+    if(ui32pps_count != pg->_ui32_pps_count)
+    {
+        pg->_ui32_pps_count = ui32pps_count;
+        pg->_u64_pps_us = u64now_us;
+
+        if(is_valid)
+        {
+            if(eDCOGPSDO_WAIT == pg->_state)
+            {
+                PioDCOGpsdoSetPPB(pg, i64ppb);  /* Acquired, the output wasn't right anyway. */
+            }
+            else
+            {
+                PioDCOGpsdoSlew(pg, i64ppb);
+            }
+            pg->_state = eDCOGPSDO_LOCKED;
+            pg->_i64_hold_delta_ppb = 0;
+            if(pg->_temp._ui32_samples)
+            {
+                PioDCOTempLearn(&pg->_temp, PioDCOTempNow(&pg->_temp), i64ppb);
+            }
+        }
+        else if(eDCOGPSDO_LOCKED == pg->_state)
+        {
+            PioDCOGpsdoHoldover(pg, u64now_us); /* The fix is lost, PPS is free running. */
+        }
+    }
+    else if(eDCOGPSDO_LOCKED == pg->_state && u64now_us - pg->_u64_pps_us > eDCOGpsdoTimeoutMs * 1000ULL)
+    {
+        PioDCOGpsdoHoldover(pg, u64now_us);
+    }
+
+    if(eDCOGPSDO_HOLDOVER == pg->_state && u64now_us - pg->_u64_hold_step_us >= eDCOGpsdoHoldStepMs * 1000ULL)
+    {
+        /* RPix: The model predicts the change since the fix was lost, its offset
+           is of no use, the aging is in the last estimate. */
+        pg->_u64_hold_step_us = u64now_us;
+        int64_t i64hold, i64now;
+        if(!PioDCOTempPredict(&pg->_temp, pg->_i32_hold_mdeg, &i64hold)
+           && !PioDCOTempPredict(&pg->_temp, PioDCOTempNow(&pg->_temp), &i64now))
+        {
+            pg->_i64_hold_delta_ppb = i64now - i64hold;
+            PioDCOGpsdoSlew(pg, pg->_i64_hold_ppb + pg->_i64_hold_delta_ppb);
+        }
+    }
+
+    if(pg->_i64_ppb == i64was)
+    {
+        return 0;
+    }
+
+    ++pg->_ui32_updates;
+    return 1;
+}
+
+/// @brief Starts the holdover.
+static void PioDCOGpsdoHoldover(PioDcoGpsdo *pg, uint64_t u64now_us)
+{
+    pg->_state = eDCOGPSDO_HOLDOVER;
+    pg->_u64_holdover_us = pg->_u64_hold_step_us = u64now_us;
+    pg->_i64_hold_ppb = pg->_i64_ppb;
+    pg->_i32_hold_mdeg = PioDCOTempNow(&pg->_temp);
+    pg->_i64_hold_delta_ppb = 0;
+}
+
+/// @brief Moves the correction to the target by eDCOGpsdoSlewPPB at most.
+static void PioDCOGpsdoSlew(PioDcoGpsdo *pg, int64_t i64ppb)
+{
+    const int64_t i64d = i64ppb - pg->_i64_ppb;
+    PioDCOGpsdoSetPPB(pg, pg->_i64_ppb + (i64d > eDCOGpsdoSlewPPB ? eDCOGpsdoSlewPPB
+                                        : i64d < -eDCOGpsdoSlewPPB ? -eDCOGpsdoSlewPPB : i64d));
+}
+
+/// @brief Sets the correction & its scale of cycles.
+static void PioDCOGpsdoSetPPB(PioDcoGpsdo *pg, int64_t i64ppb)
+{
+    pg->_i64_ppb = i64ppb;
+    const int64_t i64num = i64ppb * (1LL << eDCOGpsdoScaleBits);
+    pg->_i64_scale = (i64num + (i64num < 0 ? -500000000LL : 500000000LL)) / 1000000000LL;
+}
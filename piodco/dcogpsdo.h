@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  dcogpsdo.h - GPS disciplining of the PIO based DCO.
+//
+//
+//  DESCRIPTION
+//
+//      In eDCOMODE_GPS_COMPENSATED mode the DCO corrects its working freq. by the
+//  CPU CLK error estimated of GPS PPS by itself, the application sets the nominal
+//  freq. only. The correction is updated once per PPS at most, it is slew limited
+//  to eDCOGpsdoSlewPPB per PPS but the very first one, which is applied at once.
+//  If PPS stops or the fix is lost, the last correction is held (holdover) until
+//  the fix is back, then it is slewed to the fresh estimate. While locked, the
+//  temperature model (dcotemp.h) learns the estimate against the on-chip sensor;
+//  in holdover the correction follows the change of the model since the fix was
+//  lost, once per eDCOGpsdoHoldStepMs. A correction saved ere is applied at boot
+//  by PioDCOGpsdoWarm, as a holdover since it was saved.
+//      The correction is applied to cycles per PI scaled by 2^56, so eDCOMOD_HIRES
+//  renders it in full, the other modulators to 2^-24 cycle.
+//      It is kept free of any pico SDK dependency, so it's checked off-target.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//      Rev 0.2   16 Oct 2026   Temperature compensated holdover.
+//      Rev 0.3   16 Oct 2026   Warm start.
+//      Rev 0.4   17 Oct 2026   The sensor is sampled once per PPS.
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef DCOGPSDO_H_
+#define DCOGPSDO_H_
+
+#include <stdint.h>
+
+#include "dcotemp.h"
+
+enum PioDcoGpsdoState
+{
+    eDCOGPSDO_OFF = 0,          /* Not compensated. */
+    eDCOGPSDO_WAIT = 1,         /* No estimate of GPS yet, not compensated. */
+    eDCOGPSDO_LOCKED = 2,       /* Following the estimate, slew limited. */
+    eDCOGPSDO_HOLDOVER = 3      /* PPS or fix lost, the last correction held. */
+};
+
+enum
+{
+    eDCOGpsdoSlewPPB = 5,       /* Max change of correction per PPS, ppb. */
+    eDCOGpsdoTimeoutMs = 2500,  /* No PPS that long starts holdover. */
+    eDCOGpsdoHoldStepMs = 1000, /* Update period of the correction in holdover. */
+    eDCOGpsdoTempMs = 1500,     /* No PPS that long, the sensor is sampled anyway. */
+    eDCOGpsdoScaleBits = 40     /* Fraction of the scale of cycles. */
+};
+
+typedef struct
+{
+    enum PioDcoGpsdoState _state;
+    int64_t _i64_ppb;           /* Correction applied, ppb, positive if CPU CLK is fast. */
+    int64_t _i64_scale;         /* ppb * 1e-9 scaled by 2^eDCOGpsdoScaleBits. */
+    uint32_t _ui32_pps_count;   /* PPS count of the last update. */
+    uint64_t _u64_pps_us;       /* Uptime of it, us. */
+    uint64_t _u64_holdover_us;  /* Uptime the holdover has started at. */
+    uint64_t _u64_hold_step_us; /* Uptime of the last update in holdover. */
+    int64_t _i64_hold_ppb;      /* The correction when the holdover started. */
+    int32_t _i32_hold_mdeg;     /* The temperature then, mC. */
+    int64_t _i64_hold_delta_ppb;/* The change predicted by the model since, ppb. */
+    uint32_t _ui32_updates;     /* Changes of correction. */
+
+    uint64_t _u64_cycles;       /* Nominal cycles per PI of the freq. set, 2^56, 0 if none. */
+    uint32_t _ui32_frq_hz;      /* The freq. it is of, Hz, 0 if unknown. */
+    int32_t _i32_frq_millihz;   /* The freq. additive shift, mHz. */
+
+    PioDcoTempModel _temp;      /* Temperature model, kept by reset. */
+    uint64_t _u64_temp_us;      /* Uptime of the last sample of the sensor, us. */
+
+} PioDcoGpsdo;
+
+void PioDCOGpsdoReset(PioDcoGpsdo *pg, enum PioDcoGpsdoState state);
+void PioDCOGpsdoWarm(PioDcoGpsdo *pg, uint64_t u64now_us, int64_t i64ppb, int32_t i32mdeg);
+int PioDCOGpsdoStep(PioDcoGpsdo *pg, uint64_t u64now_us, uint32_t ui32pps_count,
+                    int is_valid, int64_t i64ppb);
+
+/// @brief Corrects cycles per PI by the CPU CLK error, no division.
+/// @param pg Ptr to GPSDO state.
+/// @param u64cycles CPU CLK cycles per PI, scaled by 2^56.
+/// @return The cycles per PI which yield the freq. in true time, scaled by 2^56.
+static inline uint64_t PioDCOGpsdoCorrect(const PioDcoGpsdo *pg, uint64_t u64cycles)
+{
+    /* RPix: cycles * (1 + ppb * 1e-9), hi < 2^31 & |scale| < 2^29, so it fits. */
+    const int64_t i64hi = (int64_t)(u64cycles >> 32U);
+    const int64_t i64lo = (int64_t)(u64cycles & 0xFFFFFFFFULL);
+
+    return u64cycles + ((i64hi * pg->_i64_scale) >> (eDCOGpsdoScaleBits - 32))
+                     + ((i64lo * pg->_i64_scale) >> eDCOGpsdoScaleBits);
+}
+
+#endif
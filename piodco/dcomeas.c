@@ -0,0 +1,116 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  dcomeas.c - Output frequency self-measurement of the PIO based DCO.
+//
+//
+//  DESCRIPTION
+//
+//      See dcomeas.h.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "dcomeas.h"
+
+/// @brief Calculates the count of samples of `dco_count` for the gate.
+/// @param ui32clkfreq_hz The CPU CLK freq., Hz.
+/// @param ui32gate_ms The gate, ms.
+/// @return The count of samples, 0 if the gate is out of 32 bits.
+uint32_t PioDCOMeasGateSamples(uint32_t ui32clkfreq_hz, uint32_t ui32gate_ms)
+{
+    const uint64_t u64samples = ((uint64_t)ui32clkfreq_hz * ui32gate_ms
+                                 / 1000ULL + (eDCOMeasCyclesPerSample >> 1))
+                                / eDCOMeasCyclesPerSample;
+
+    return u64samples > 0xFFFFFFFFULL ? 0 : (uint32_t)u64samples;
+}
+
+/// @brief Converts the count of edges to the freq. & its error.
+/// @param ui32clkfreq_hz The CPU CLK freq., Hz.
+/// @param ui32samples The count of samples of the gate.
+/// @param ui32edges The count of rising edges over the gate.
+/// @param i64clk_ppb The error of CPU CLK measured by GPS, ppb, 0 if none.
+/// @param u64cmd_millihz The commanded freq., mHz.
+/// @param pmeas Ptr to the result.
+void PioDCOMeasResult(uint32_t ui32clkfreq_hz, uint32_t ui32samples, uint32_t ui32edges,
+                      int64_t i64clk_ppb, uint64_t u64cmd_millihz, PioDcoMeas *pmeas)
+{
+    const uint64_t u64gate = (uint64_t)ui32samples * eDCOMeasCyclesPerSample;
+
+    pmeas->_ui32_edges = ui32edges;
+    pmeas->_u64_gate_cycles = u64gate;
+    pmeas->_u64_frq_millihz = 0;
+    pmeas->_i64_err_ppb = 0;
+    pmeas->_ui32_res_ppb = ui32edges ? (1000000000U + ui32edges - 1U) / ui32edges : 0xFFFFFFFFU;
+    if(!u64gate)
+    {
+        return;
+    }
+
+    /* RPix: edges * CLK < 2^61, its remainder * 1000 < 2^42. */
+    const uint64_t u64q = (uint64_t)ui32edges * ui32clkfreq_hz;
+    const uint64_t u64hz = u64q / u64gate;
+    const uint64_t u64rem = u64q - u64hz * u64gate;
+    int64_t i64millihz = (int64_t)(u64hz * 1000ULL + (u64rem * 1000ULL + (u64gate >> 1)) / u64gate);
+
+    /* RPix: The CPU CLK running fast by ppb makes the gate that shorter. */
+    if(i64clk_ppb)
+    {
+        const int64_t i64prod = i64clk_ppb * i64millihz;
+        i64millihz += (i64prod + (i64prod < 0 ? -500000000LL : 500000000LL)) / 1000000000LL;
+    }
+    pmeas->_u64_frq_millihz = (uint64_t)i64millihz;
+
+    if(u64cmd_millihz)
+    {
+        /* RPix: diff * 1e9 fits 63 bits below 9 MHz of error, a gross one is
+           reported coarsely. */
+        const int64_t i64diff = i64millihz - (int64_t)u64cmd_millihz;
+        if(i64diff < 9000000000LL && i64diff > -9000000000LL)
+        {
+            const int64_t i64half = (int64_t)(u64cmd_millihz >> 1);
+            pmeas->_i64_err_ppb = (i64diff * 1000000000LL + (i64diff < 0 ? -i64half : i64half))
+                                  / (int64_t)u64cmd_millihz;
+        }
+        else
+        {
+            pmeas->_i64_err_ppb = i64diff / (int64_t)u64cmd_millihz * 1000000000LL;
+        }
+    }
+}
@@ -0,0 +1,79 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  dcomeas.h - Output frequency self-measurement of the PIO based DCO.
+//
+//
+//  DESCRIPTION
+//
+//      The arithmetic of `dco_count` PIO program, which counts the rising edges
+//  of DCO output over the gate of exact number of CPU CLK cycles: it samples the
+//  pin every eDCOMeasCyclesPerSample cycles, so the half period of output should
+//  last at least that long, which is true for the whole range of DCO. The count
+//  is converted to the freq. and to its error against the commanded one; if GPS
+//  is on, its measured CPU CLK error is folded in, so the gate is GPS derived.
+//      It is kept free of any pico SDK dependency, so it's checked off-target.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef DCOMEAS_H_
+#define DCOMEAS_H_
+
+#include <stdint.h>
+
+enum
+{
+    eDCOMeasCyclesPerSample = 3 /* Must match the loop of `dco_count` of dco2.pio. */
+};
+
+typedef struct
+{
+    uint32_t _ui32_edges;       /* Rising edges counted over the gate. */
+    uint64_t _u64_gate_cycles;  /* The gate, CPU CLK cycles. */
+    uint64_t _u64_frq_millihz;  /* Measured freq., mHz. */
+    int64_t _i64_err_ppb;       /* Its error against the commanded freq., ppb. */
+    uint32_t _ui32_res_ppb;     /* Resolution, one edge of the gate, ppb. */
+
+} PioDcoMeas;
+
+uint32_t PioDCOMeasGateSamples(uint32_t ui32clkfreq_hz, uint32_t ui32gate_ms);
+void PioDCOMeasResult(uint32_t ui32clkfreq_hz, uint32_t ui32samples, uint32_t ui32edges,
+                      int64_t i64clk_ppb, uint64_t u64cmd_millihz, PioDcoMeas *pmeas);
+
+#endif
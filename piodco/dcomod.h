@@ -0,0 +1,350 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  dcomod.h - Cycle count modulators of the PIO based DCO.
+//
+//
+//  DESCRIPTION
+//
+//      The arithmetic which converts the precise number of CPU CLK cycles per
+//  half period of DCO (scaled by 2^24) to the integer stream of cycle counts
+//  fed to `dco` PIO program. It is kept free of any pico SDK dependency, so
+//  the very same code is used by the worker loops, by the DMA batch generator
+//  and by off-target tools.
+//      Two modulators are available. The first order error feedback loop is
+//  the classic one, it is the cheapest but its sequence is periodic, which
+//  yields discrete spurs close to the carrier. MASH 1-1-1 is a cascade of
+//  three first order loops, it shapes the quantization noise to the higher
+//  offsets from the carrier at the cost of wider range of cycle counts
+//  (N-3...N+4), so it needs at least 3 cycles of margin in the count.
+//      The period of the first order sequence is set by the denominator of
+//  the fraction of its value, that is 2^(bits - trailing zeros). The short
+//  periods are rendered once and replayed by DMA; so is the exact rational
+//  sequence of CPU CLK to the freq. ratio, if its denominator is small.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//      Rev 0.2   16 Oct 2026   Division free cycles per PI.
+//      Rev 0.3   16 Oct 2026   Duty cycle modulator.
+//      Rev 0.4   16 Oct 2026   High resolution first order modulator.
+//      Rev 0.5   16 Oct 2026   Periods of cycle count sequences, rendering.
+//      Rev 0.6   17 Oct 2026   Division free cycles per PI dropped, not faster.
+//      Rev 0.7   17 Oct 2026   Rounding modulator of legacy worker dropped.
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef DCOMOD_H_
+#define DCOMOD_H_
+
+#include <stdint.h>
+
+/* RPix: The per word code must be inlined into the RAM resident engines, a call
+   per word would miss the FIFO deadline, a call to flash even more so. */
+#define DCO_INLINE static inline __attribute__((always_inline))
+
+enum
+{
+    eDCOModMashMinCycles = 3,   /* Min integer cycles MASH 1-1-1 may work with. */
+    eDCOModDutyMaxCount = 127   /* Max integer cycles of a level of duty cycle variant. */
+};
+
+typedef struct
+{
+    uint32_t _ui32acc[3];       /* Accumulators of three stages, 24 bit each. */
+    int32_t _i32c2_z1;          /* Carry of 2nd stage delayed by 1 word. */
+    int32_t _i32c3_z1;          /* Carry of 3rd stage delayed by 1 word. */
+    int32_t _i32c3_z2;          /* Carry of 3rd stage delayed by 2 words. */
+
+} PioDcoMash;
+
+/// @brief Calculates an accurate value of CPU CLK cycles per half period of DCO
+/// @brief (per PI of phase), scaled by 2^24.
+/// @param ui32clkfreq_hz The CPU CLK freq., Hz.
+/// @param ui32_frq_hz The `coarse` part of frequency [Hz].
+/// @param i32_frq_millihz The `fine` part of frequency [mHz]. Might be negative.
+/// @return CPU CLK cycles per PI scaled by 2^24.
+static inline int32_t PioDCOModCyclesPerPi(uint32_t ui32clkfreq_hz, uint32_t ui32_frq_hz,
+                                           int32_t i32_frq_millihz)
+{
+    const int64_t i64denominator = 2000LL * (int64_t)ui32_frq_hz + 2LL * (int64_t)i32_frq_millihz;
+    return (int32_t)(((int64_t)ui32clkfreq_hz * (int64_t)(1<<24) * 1000LL
+                      +(i64denominator>>1)) / i64denominator);
+}
+
+/// @brief Calculates CPU CLK cycles per half period of DCO in high resolution,
+/// @brief Q8.56: CLK * 2^56 * 1e6 / (2e6 * Hz + 2 * uHz), rounded. The value of
+/// @brief 8.24 format is its upper 32 bits. The dividend overflows 64 bits, so
+/// @brief the long division runs by 14-bit chunks.
+/// @param ui32clkfreq_hz The CPU CLK freq., Hz.
+/// @param ui32_frq_hz The `coarse` part of frequency [Hz].
+/// @param i32_frq_microhz The `fine` part of frequency [uHz]. Might be negative.
+/// @return CPU CLK cycles per PI scaled by 2^56.
+/// @attention The freq. should be above CPU CLK / 512, the value is below 256, and
+/// @attention below 70 MHz, the divisor is below 2^47.
+static inline uint64_t PioDCOModCyclesPerPiHiRes(uint32_t ui32clkfreq_hz, uint32_t ui32_frq_hz,
+                                                 int32_t i32_frq_microhz)
+{
+    const uint64_t u64denominator = 2000000ULL * ui32_frq_hz + 2LL * (int64_t)i32_frq_microhz;
+    const uint64_t u64numerator = (uint64_t)ui32clkfreq_hz * 1000000ULL;
+
+    uint64_t u64q = u64numerator / u64denominator;
+    uint64_t u64rem = u64numerator - u64q * u64denominator;
+    for(int i = 0; i < 4; ++i)
+    {
+        /* RPix: rem < den < 2^47, so rem * 2^14 fits. */
+        u64rem <<= 14U;
+        const uint64_t u64digit = u64rem / u64denominator;
+        u64q = (u64q << 14U) + u64digit;
+        u64rem -= u64digit * u64denominator;
+    }
+
+    return u64q + ((u64rem << 1U) >= u64denominator);
+}
+
+/// @brief Calculates the next cycle count of the first order error feedback loop.
+/// @param ui32reg CPU CLK cycles per half period less PIO delay, scaled by 2^24.
+/// @param pi32acc_error Ptr to the accumulated error (feedback of the PLL).
+/// @return The cycle count for the next PIO word.
+DCO_INLINE uint32_t PioDCOModFirstOrder(uint32_t ui32reg, int32_t *pi32acc_error)
+{
+    /* RPix: The integer part of precise value corrected by accumulated error. */
+    const uint32_t ui32wc = (ui32reg - *pi32acc_error) >> 24U;
+
+    /* RPix: The difference betwixt the value sent and the precise value
+       is fed back, it forms a loop which provides precise freq. */
+    *pi32acc_error += (ui32wc << 24U) - ui32reg;
+
+    return ui32wc;
+}
+
+/// @brief Calculates the next cycle count of the first order loop of high resolution.
+/// @brief The value has 32 more fractional bits, the fraction is accumulated in
+/// @brief 56 bits, its carry is the correction of the integer part.
+/// @param ui32reg CPU CLK cycles per half period less PIO delay, scaled by 2^24.
+/// @param ui32ext The next 32 bits of the fraction (ui32reg is scaled by 2^24).
+/// @param pu64acc Ptr to the accumulated fraction, 56 bits.
+/// @return The cycle count for the next PIO word.
+DCO_INLINE uint32_t PioDCOModFirstOrderHiRes(uint32_t ui32reg, uint32_t ui32ext, uint64_t *pu64acc)
+{
+    const uint64_t u64acc = *pu64acc + ((((uint64_t)ui32reg & 0xFFFFFFU) << 32U) | ui32ext);
+    *pu64acc = u64acc & 0xFFFFFFFFFFFFFFULL;
+
+    return (ui32reg >> 24U) + (uint32_t)(u64acc >> 56U);
+}
+
+/// @brief Calculates log2 of the period of the high resolution first order sequence
+/// @brief in words. Its accumulator returns to zero after 2^56 / gcd(frac, 2^56)
+/// @brief words, so the sequence repeats exactly and the sum over the period is
+/// @brief the exact value times the period.
+/// @param ui32reg CPU CLK cycles per half period less PIO delay, scaled by 2^24.
+/// @param ui32ext The next 32 bits of the fraction.
+/// @return log2 of the period, 0...56.
+static inline int PioDCOModPeriodLog2(uint32_t ui32reg, uint32_t ui32ext)
+{
+    const uint64_t u64frac = (((uint64_t)ui32reg & 0xFFFFFFU) << 32U) | ui32ext;
+
+    return u64frac ? 56 - __builtin_ctzll(u64frac) : 0;
+}
+
+/// @brief Renders the words from...to-1 of the period of the high resolution first
+/// @brief order sequence, so the period can be rendered in chunks.
+/// @param ui32reg CPU CLK cycles per half period less PIO delay, scaled by 2^24.
+/// @param ui32ext The next 32 bits of the fraction.
+/// @param pui32dst Ptr to the buffer of 2^PioDCOModPeriodLog2() words.
+/// @param ui32from The first word to render.
+/// @param ui32to The word past the last one to render.
+static inline void PioDCOModRenderAt(uint32_t ui32reg, uint32_t ui32ext, uint32_t *pui32dst,
+                                     uint32_t ui32from, uint32_t ui32to)
+{
+    /* RPix: The accumulator of word i is i * fraction mod 2^56. */
+    const uint64_t u64frac = (((uint64_t)ui32reg & 0xFFFFFFU) << 32U) | ui32ext;
+    uint64_t u64acc = (u64frac * ui32from) & 0xFFFFFFFFFFFFFFULL;
+    for(uint32_t i = ui32from; i < ui32to; ++i)
+    {
+        pui32dst[i] = PioDCOModFirstOrderHiRes(ui32reg, ui32ext, &u64acc);
+    }
+}
+
+/// @brief Renders the period of the high resolution first order sequence.
+/// @param ui32reg CPU CLK cycles per half period less PIO delay, scaled by 2^24.
+/// @param ui32ext The next 32 bits of the fraction.
+/// @param pui32dst Ptr to the buffer of 2^PioDCOModPeriodLog2() words.
+/// @param ui32len The count of words to render.
+static inline void PioDCOModRender(uint32_t ui32reg, uint32_t ui32ext,
+                                   uint32_t *pui32dst, uint32_t ui32len)
+{
+    PioDCOModRenderAt(ui32reg, ui32ext, pui32dst, 0, ui32len);
+}
+
+/// @brief Calculates the greatest common divisor.
+static inline uint64_t PioDCOModGcd(uint64_t u64a, uint64_t u64b)
+{
+    while(u64b)
+    {
+        const uint64_t u64r = u64a % u64b;
+        u64a = u64b;
+        u64b = u64r;
+    }
+
+    return u64a;
+}
+
+/// @brief Renders the words from...to-1 of the period of the exact rational cycle
+/// @brief count sequence, so the period can be rendered in chunks.
+/// @param ui32wc The integer part of the value less PIO delay.
+/// @param ui32rem The remainder of the value, the numerator of its fraction.
+/// @param ui32den The denominator, reduced; rem * den must fit 32 bits.
+/// @param pui32dst Ptr to the buffer of den words.
+/// @param ui32from The first word to render.
+/// @param ui32to The word past the last one to render.
+static inline void PioDCOModRenderRationalAt(uint32_t ui32wc, uint32_t ui32rem, uint32_t ui32den,
+                                             uint32_t *pui32dst, uint32_t ui32from, uint32_t ui32to)
+{
+    /* RPix: The accumulator of word i is i * rem mod den. */
+    uint32_t ui32acc = ui32from * ui32rem % ui32den;
+    for(uint32_t i = ui32from; i < ui32to; ++i)
+    {
+        ui32acc += ui32rem;
+        const uint32_t ui32carry = ui32acc >= ui32den;
+        ui32acc -= ui32carry ? ui32den : 0;
+        pui32dst[i] = ui32wc + ui32carry;
+    }
+}
+
+/// @brief Renders the period of the exact rational cycle count sequence, the value
+/// @brief is num / den CPU CLK cycles per half period, the period is den words.
+/// @param u64num The numerator, reduced.
+/// @param u64den The denominator, reduced.
+/// @param ui32delay PIO delay cycles subtracted from every count.
+/// @param pui32dst Ptr to the buffer of den words.
+static inline void PioDCOModRenderRational(uint64_t u64num, uint64_t u64den, uint32_t ui32delay,
+                                           uint32_t *pui32dst)
+{
+    PioDCOModRenderRationalAt((uint32_t)(u64num / u64den) - ui32delay, (uint32_t)(u64num % u64den),
+                              (uint32_t)u64den, pui32dst, 0, (uint32_t)u64den);
+}
+
+/// @brief Calculates the next cycle count of MASH 1-1-1 noise shaped modulator.
+/// @param ui32reg CPU CLK cycles per half period less PIO delay, scaled by 2^24.
+/// @param pmash Ptr to modulator state.
+/// @return The cycle count for the next PIO word.
+/// @attention The integer part of ui32reg should be >= eDCOModMashMinCycles.
+DCO_INLINE uint32_t PioDCOModMash111(uint32_t ui32reg, PioDcoMash *pmash)
+{
+    const uint32_t ui32frac = ui32reg & 0xFFFFFFU;
+
+    uint32_t a1 = pmash->_ui32acc[0] + ui32frac;
+    const int32_t c1 = a1 >> 24U;
+    a1 &= 0xFFFFFFU;
+
+    uint32_t a2 = pmash->_ui32acc[1] + a1;
+    const int32_t c2 = a2 >> 24U;
+    a2 &= 0xFFFFFFU;
+
+    uint32_t a3 = pmash->_ui32acc[2] + a2;
+    const int32_t c3 = a3 >> 24U;
+    a3 &= 0xFFFFFFU;
+
+    pmash->_ui32acc[0] = a1;
+    pmash->_ui32acc[1] = a2;
+    pmash->_ui32acc[2] = a3;
+
+    /* RPix: Noise cancellation network: c1 + (1-z^-1)c2 + (1-z^-1)^2 c3. */
+    const int32_t i32d = c1 + c2 - pmash->_i32c2_z1
+                         + c3 - (pmash->_i32c3_z1 << 1) + pmash->_i32c3_z2;
+
+    pmash->_i32c2_z1 = c2;
+    pmash->_i32c3_z2 = pmash->_i32c3_z1;
+    pmash->_i32c3_z1 = c3;
+
+    return (ui32reg >> 24U) + i32d;
+}
+
+/// @brief Splits the period of output into high and low times of the given duty
+/// @brief cycle. Their sum is the period exactly, so the freq. is kept.
+/// @param ui32cpp CPU CLK cycles per PI (half period), scaled by 2^24.
+/// @param ui32duty_q16 Duty cycle, 65536 is 100%.
+/// @param ui32delay PIO delay per level, cycles.
+/// @param pui32regh Ptr to cycles of high level less PIO delay, scaled by 2^24.
+/// @param pui32regl Ptr to cycles of low level less PIO delay, scaled by 2^24.
+static inline void PioDCOModDutySplit(uint32_t ui32cpp, uint32_t ui32duty_q16, uint32_t ui32delay,
+                                      uint32_t *pui32regh, uint32_t *pui32regl)
+{
+    const uint64_t u64period = (uint64_t)ui32cpp << 1U;
+    const uint64_t u64min = (uint64_t)ui32delay << 24U;
+    const uint64_t u64max = (uint64_t)(eDCOModDutyMaxCount + ui32delay) << 24U;
+
+    if(u64period < (u64min << 1U))
+    {
+        *pui32regh = *pui32regl = 0;
+        return;
+    }
+
+    /* RPix: Each level lasts at least PIO delay, the low one takes the rest. */
+    uint64_t u64high = (u64period * ui32duty_q16) >> 16U;
+    if(u64high < u64min)
+    {
+        u64high = u64min;
+    }
+    if(u64high > u64period - u64min)
+    {
+        u64high = u64period - u64min;
+    }
+
+    uint64_t u64low = u64period - u64high;
+    *pui32regh = (uint32_t)((u64high > u64max ? u64max : u64high) - u64min);
+    *pui32regl = (uint32_t)((u64low > u64max ? u64max : u64low) - u64min);
+}
+
+/// @brief Calculates the next word of duty cycle variant of DCO: high, low, high,
+/// @brief low 8-bit counts. Each level has its own first order error feedback,
+/// @brief which runs once per word for the pair of levels to keep the pace.
+/// @param ui32regh Cycles of high level less PIO delay, scaled by 2^24.
+/// @param ui32regl Cycles of low level less PIO delay, scaled by 2^24.
+/// @param pi32acch Ptr to accumulated error of high level.
+/// @param pi32accl Ptr to accumulated error of low level.
+/// @return The word for `dco_duty` PIO program.
+DCO_INLINE uint32_t PioDCOModDutyWord(uint32_t ui32regh, uint32_t ui32regl,
+                                         int32_t *pi32acch, int32_t *pi32accl)
+{
+    const uint32_t ui32wch = PioDCOModFirstOrder(ui32regh << 1U, pi32acch);
+    const uint32_t ui32wcl = PioDCOModFirstOrder(ui32regl << 1U, pi32accl);
+
+    return (ui32wch >> 1U) | ((ui32wcl >> 1U) << 8U)
+           | ((ui32wch - (ui32wch >> 1U)) << 16U) | ((ui32wcl - (ui32wcl >> 1U)) << 24U);
+}
+
+#endif
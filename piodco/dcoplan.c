@@ -0,0 +1,127 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  dcoplan.c - Harmonic frequency planner of the PIO based DCO.
+//
+//
+//  DESCRIPTION
+//
+//      See dcoplan.h.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "dcoplan.h"
+
+/* RPix: Square wave has odd harmonics only, the n-th is 20*log10(n) dB down. */
+static const int sHarmonics[] = { 1, 3, 5, 7 };
+static const int sLevelDb10[] = { 0, -95, -140, -169 };
+
+/// @brief Calculates cycles per PI of the fundamental for the harmonic target:
+/// @brief h * CLK * 2^24 * 1000 / (2000 * Hz + 2 * mHz), rounded. The dividend
+/// @brief overflows 64 bits for h > 1, so the division is done in two steps.
+/// @param ui32clkfreq_hz The CPU CLK freq., Hz.
+/// @param ui32_frq_hz The `coarse` part of target frequency [Hz].
+/// @param i32_frq_millihz The `fine` part of target frequency [mHz]. Might be negative.
+/// @param harmonic The harmonic number.
+/// @return CPU CLK cycles per PI of fundamental scaled by 2^24.
+int32_t PioDCOPlanCyclesPerPi(uint32_t ui32clkfreq_hz, uint32_t ui32_frq_hz,
+                              int32_t i32_frq_millihz, int harmonic)
+{
+    const uint64_t u64denominator = 2000ULL * ui32_frq_hz + 2LL * (int64_t)i32_frq_millihz;
+    const uint64_t u64numerator = (uint64_t)ui32clkfreq_hz * (uint64_t)(1<<24) * 1000ULL;
+
+    /* RPix: h*N = h*q*D + h*r, where h*r < h*D fits 64 bits. */
+    const uint64_t u64q = u64numerator / u64denominator;
+    const uint64_t u64r = u64numerator - u64q * u64denominator;
+
+    return (int32_t)((uint64_t)harmonic * u64q
+                     + ((uint64_t)harmonic * u64r + (u64denominator >> 1)) / u64denominator);
+}
+
+/// @brief Plans the harmonic operation for the target freq: the lowest harmonic
+/// @brief whose fundamental is within CLK/256...CLK/8 is chosen.
+/// @param ui32clkfreq_hz The CPU CLK freq., Hz.
+/// @param ui32_frq_hz The `coarse` part of target frequency [Hz].
+/// @param i32_frq_millihz The `fine` part of target frequency [mHz]. Might be negative.
+/// @param pplan Ptr to the plan, filled on success.
+/// @return 0 if OK. -1 the freq. is out of reach.
+int PioDCOPlanHarmonic(uint32_t ui32clkfreq_hz, uint32_t ui32_frq_hz, int32_t i32_frq_millihz,
+                       PioDcoPlan *pplan)
+{
+    const int64_t i64frq_millihz = 1000LL * ui32_frq_hz + i32_frq_millihz;
+    const int64_t i64min_millihz = 1000LL * (ui32clkfreq_hz >> 8);
+    const int64_t i64max_millihz = 1000LL * (ui32clkfreq_hz >> 3);
+
+    if(!pplan || i64frq_millihz <= i64min_millihz)
+    {
+        return -1;
+    }
+
+    for(unsigned i = 0; i < sizeof(sHarmonics) / sizeof(sHarmonics[0]); ++i)
+    {
+        const int h = sHarmonics[i];
+        if(i64frq_millihz > i64max_millihz * h)
+        {
+            continue;
+        }
+        const int64_t i64fund_millihz = (i64frq_millihz + (h >> 1)) / h;
+        pplan->_harmonic = h;
+        pplan->_ui32_fund_hz = (uint32_t)(i64fund_millihz / 1000);
+        pplan->_i32_fund_millihz = (int32_t)(i64fund_millihz % 1000);
+        pplan->_i32_cycles_per_pi = PioDCOPlanCyclesPerPi(ui32clkfreq_hz, ui32_frq_hz,
+                                                          i32_frq_millihz, h);
+
+        /* RPix: F = h * CLK / (2 * c), so dF/dc = F^2 * 2 / (h * CLK) per cycle;
+           per LSB of 2^24 scaled value, in uHz. */
+        const uint64_t u64f2 = (uint64_t)ui32_frq_hz * ui32_frq_hz;
+        pplan->_ui32_step_uhz = (uint32_t)(((u64f2 / ((uint64_t)h * ui32clkfreq_hz))
+                                            * 2000000ULL) >> 24);
+
+        /* RPix: The TIE is the same in time at any harmonic, but the phase
+           jitter grows with the output freq.; p-p is twice the max TIE. */
+        pplan->_ui32_tie_ps = (uint32_t)(eDCOPlanTieTicks * 1000000000000ULL / ui32clkfreq_hz);
+        pplan->_ui32_phase_pp_mdeg = (uint32_t)(360000ULL * 2 * eDCOPlanTieTicks
+                                                * ui32_frq_hz / ui32clkfreq_hz);
+        pplan->_level_db10 = sLevelDb10[i];
+
+        return 0;
+    }
+
+    return -1;
+}
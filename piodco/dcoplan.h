@@ -0,0 +1,85 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  dcoplan.h - Harmonic frequency planner of the PIO based DCO.
+//
+//
+//  DESCRIPTION
+//
+//      The planner of odd harmonic operation. The DCO output is a square wave,
+//  so its 3rd, 5th and 7th harmonics are strong enough to reach the bands above
+//  the highest fundamental (CPU CLK / 8, about 33.7 MHz at 270 MHz). The planner
+//  picks the lowest harmonic which brings the target within reach, calculates
+//  cycles per PI of the fundamental directly from the target, so no resolution
+//  is lost on rounding of the fundamental, and reports the price: the freq. step
+//  at the output, the timing jitter and the level of the harmonic.
+//      It is kept free of any pico SDK dependency, so it's checked off-target.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef DCOPLAN_H_
+#define DCOPLAN_H_
+
+#include <stdint.h>
+
+enum
+{
+    eDCOPlanTieTicks = 4        /* Max TIE of first order loop, CPU CLK cycles. */
+};
+
+typedef struct
+{
+    int _harmonic;              /* The harmonic used: 1, 3, 5 or 7. */
+    uint32_t _ui32_fund_hz;     /* The fundamental, Hz (rounded, for reference). */
+    int32_t _i32_fund_millihz;  /* The fundamental additive shift, mHz. */
+    int32_t _i32_cycles_per_pi; /* CPU CLK cycles per PI of fundamental, scaled by 2^24. */
+
+    uint32_t _ui32_step_uhz;    /* Output freq. step per LSB of cycles per PI, uHz. */
+    uint32_t _ui32_tie_ps;      /* Max time interval error of output, ps. */
+    uint32_t _ui32_phase_pp_mdeg; /* Phase jitter p-p at the output, millidegrees. */
+    int _level_db10;            /* Level of the harmonic re fundamental, 0.1 dB. */
+
+} PioDcoPlan;
+
+int PioDCOPlanHarmonic(uint32_t ui32clkfreq_hz, uint32_t ui32_frq_hz, int32_t i32_frq_millihz,
+                       PioDcoPlan *pplan);
+int32_t PioDCOPlanCyclesPerPi(uint32_t ui32clkfreq_hz, uint32_t ui32_frq_hz,
+                              int32_t i32_frq_millihz, int harmonic);
+
+#endif
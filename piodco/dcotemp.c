@@ -0,0 +1,191 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  dcotemp.c - Temperature model of CPU CLK error.
+//
+//
+//  DESCRIPTION
+//
+//      See dcotemp.h.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "dcotemp.h"
+
+/// @brief Converts the reading of the on-chip temperature sensor to mC:
+/// @brief T = 27 - (V - 0.706) / 0.001721, V = raw * 3.3 / 4096.
+/// @param ui16raw ADC reading, 12 bits.
+/// @return The temperature, mC.
+int32_t PioDCOTempFromADC(uint16_t ui16raw)
+{
+    const int64_t i64uv = ((int64_t)ui16raw * 3300000LL) >> 12;
+
+    return 27000 - (int32_t)((i64uv - 706000LL) * 1000LL / 1721LL);
+}
+
+/// @brief Takes a sample of the sensor to the low pass of temperature.
+/// @param pm Ptr to the model.
+/// @param ui16raw ADC reading, 12 bits.
+void PioDCOTempSample(PioDcoTempModel *pm, uint16_t ui16raw)
+{
+    const int32_t i32mdeg = PioDCOTempFromADC(ui16raw);
+    if(!pm->_ui32_samples++)
+    {
+        pm->_i32_mdeg_q = i32mdeg * (1 << eDCOTempFilterShift);
+        return;
+    }
+
+    pm->_i32_mdeg_q += i32mdeg - (pm->_i32_mdeg_q >> eDCOTempFilterShift);
+}
+
+/// @brief Obtains the low passed temperature.
+/// @param pm Ptr to the model.
+/// @return The temperature, mC.
+int32_t PioDCOTempNow(const PioDcoTempModel *pm)
+{
+    return pm->_i32_mdeg_q >> eDCOTempFilterShift;
+}
+
+/// @brief Takes the CPU CLK error of GPS at the temperature to the model.
+/// @param pm Ptr to the model.
+/// @param i32mdeg The temperature, mC.
+/// @param i64ppb CPU CLK error, ppb.
+void PioDCOTempLearn(PioDcoTempModel *pm, int32_t i32mdeg, int64_t i64ppb)
+{
+    const int32_t ix = (i32mdeg - eDCOTempMinMdeg) / eDCOTempBinMdeg;
+    if(i32mdeg < eDCOTempMinMdeg || ix >= eDCOTempBins)
+    {
+        return;
+    }
+
+    PioDcoTempBin *pb = &pm->_bins[ix];
+    if(pb->_u16_count < eDCOTempMemory)
+    {
+        ++pb->_u16_count;
+    }
+
+    /* RPix: The running mean, the weight is 1/n up to the memory. */
+    const int32_t n = pb->_u16_count;
+    pb->_i32_mdeg += (i32mdeg - pb->_i32_mdeg) / n;
+    pb->_i32_ppb_q8 += (int32_t)((i64ppb * 256 - pb->_i32_ppb_q8) / n);
+}
+
+/// @brief Predicts CPU CLK error of the temperature.
+/// @param pm Ptr to the model.
+/// @param i32mdeg The temperature, mC.
+/// @param pi64ppb Ptr to the prediction, ppb.
+/// @return 0 if OK. -1 the model knows nothing of the temperature so far.
+int PioDCOTempPredict(const PioDcoTempModel *pm, int32_t i32mdeg, int64_t *pi64ppb)
+{
+    /* RPix: The nearest two bins populated below & above, the next ones outside. */
+    int lo = -1, hi = -1, lo2 = -1, hi2 = -1;
+    for(int i = 0; i < eDCOTempBins; ++i)
+    {
+        const PioDcoTempBin *pb = &pm->_bins[i];
+        if(pb->_u16_count < eDCOTempMinCount)
+        {
+            continue;
+        }
+        if(pb->_i32_mdeg <= i32mdeg)
+        {
+            lo2 = lo;
+            lo = i;
+        }
+        else if(hi < 0)
+        {
+            hi = i;
+        }
+        else if(hi2 < 0)
+        {
+            hi2 = i;
+        }
+    }
+
+    int a, b;
+    int32_t i32t = i32mdeg;
+    if(lo >= 0 && hi >= 0)
+    {
+        a = lo, b = hi;
+    }
+    else if(lo >= 0)
+    {
+        a = lo2 >= 0 ? lo2 : lo, b = lo;
+        if(i32t > pm->_bins[b]._i32_mdeg + eDCOTempBinMdeg)
+        {
+            i32t = pm->_bins[b]._i32_mdeg + eDCOTempBinMdeg;
+        }
+    }
+    else if(hi >= 0)
+    {
+        a = hi, b = hi2 >= 0 ? hi2 : hi;
+        if(i32t < pm->_bins[a]._i32_mdeg - eDCOTempBinMdeg)
+        {
+            i32t = pm->_bins[a]._i32_mdeg - eDCOTempBinMdeg;
+        }
+    }
+    else
+    {
+        return -1;
+    }
+
+    const PioDcoTempBin *pa = &pm->_bins[a], *pb = &pm->_bins[b];
+    int64_t i64q8 = pa->_i32_ppb_q8;
+    const int32_t i32span = pb->_i32_mdeg - pa->_i32_mdeg;
+    if(a != b && i32span > 0)
+    {
+        i64q8 += ((int64_t)(pb->_i32_ppb_q8 - pa->_i32_ppb_q8) * (i32t - pa->_i32_mdeg)) / i32span;
+    }
+
+    *pi64ppb = (i64q8 + (i64q8 < 0 ? -128 : 128)) / 256;
+    return 0;
+}
+
+/// @brief Counts the bins of the model populated enough to be used.
+/// @param pm Ptr to the model.
+/// @return The count of bins.
+int PioDCOTempBinsUsed(const PioDcoTempModel *pm)
+{
+    int n = 0;
+    for(int i = 0; i < eDCOTempBins; ++i)
+    {
+        n += pm->_bins[i]._u16_count >= eDCOTempMinCount;
+    }
+
+    return n;
+}
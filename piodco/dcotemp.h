@@ -0,0 +1,97 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  dcotemp.h - Temperature model of CPU CLK error.
+//
+//
+//  DESCRIPTION
+//
+//      The model learns the CPU CLK error of GPS against the temperature of the
+//  on-chip sensor while GPSDO is locked, so the change of the error is predicted
+//  of the change of temperature in holdover.
+//      The temperature range is cut into eDCOTempBins bins, each keeps the mean
+//  temperature & the mean error of the samples fallen into it; the curve is the
+//  piecewise-linear one through the means of the bins populated, it's extended by
+//  the slope of the outer two at most a bin beyond. The means are running ones of
+//  eDCOTempMemory samples, so the model follows the aging of the crystal.
+//      The sensor is read by ADC; its samples are low passed, the noise is a few
+//  LSB, 0.47 C each.
+//      It is kept free of any pico SDK dependency, so it's checked off-target.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef DCOTEMP_H_
+#define DCOTEMP_H_
+
+#include <stdint.h>
+
+enum
+{
+    eDCOTempBins = 40,          /* Bins of temperature. */
+    eDCOTempMinMdeg = -20000,   /* The low edge of bin 0, mC. */
+    eDCOTempBinMdeg = 2500,     /* The width of a bin, mC. */
+    eDCOTempMinCount = 16,      /* Samples of a bin to use it. */
+    eDCOTempMemory = 256,       /* Samples of the running mean of a bin. */
+    eDCOTempFilterShift = 6     /* Low pass of the sensor, 1/64 per sample, a sample per s. */
+};
+
+typedef struct
+{
+    int32_t _i32_mdeg;          /* Mean temperature of the bin, mC. */
+    int32_t _i32_ppb_q8;        /* Mean CPU CLK error at it, ppb * 256. */
+    uint16_t _u16_count;        /* Samples, up to eDCOTempMemory. */
+
+} PioDcoTempBin;
+
+typedef struct
+{
+    PioDcoTempBin _bins[eDCOTempBins];
+    int32_t _i32_mdeg_q;        /* Low passed temperature, mC * 2^eDCOTempFilterShift. */
+    uint32_t _ui32_samples;     /* Samples of the sensor taken. */
+
+} PioDcoTempModel;
+
+int32_t PioDCOTempFromADC(uint16_t ui16raw);
+void PioDCOTempSample(PioDcoTempModel *pm, uint16_t ui16raw);
+int32_t PioDCOTempNow(const PioDcoTempModel *pm);
+void PioDCOTempLearn(PioDcoTempModel *pm, int32_t i32mdeg, int64_t i64ppb);
+int PioDCOTempPredict(const PioDcoTempModel *pm, int32_t i32mdeg, int64_t *pi64ppb);
+int PioDCOTempBinsUsed(const PioDcoTempModel *pm);
+
+#endif
@@ -0,0 +1,728 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  dcowork.h - The worker loops of the PIO based DCO.
+//
+//
+//  DESCRIPTION
+//
+//      The worker turns the requests to DCO (mailbox, time tagged events, ramps,
+//  phase steps, modulator) into the stream of cycle counts of `dco` PIO program.
+//  The requests are rare, the words are not: at the top freq. a word lasts 16
+//  CPU CLK cycles. So every producer bumps the control sequence number after
+//  its request, and the worker runs the loop specialised for the modulator in
+//  work, which costs the baseline first order loop plus one compare of that
+//  number per word. Once the number changes, or the word budget of the next
+//  event runs out, the slow path fetches the requests and picks the loop anew.
+//  The ramps and the phase steps take the generic loop, which checks all the
+//  requests every word.
+//      The loops are parametrised by the sink of words: PIO TX FIFO for
+//  PioDCOWorker2 & the bank worker, the buffer for DMA engine. The sink is
+//  inlined, so every engine gets the same arithmetic with no call per word.
+//  It is kept free of any pico SDK dependency, so off-target tools run the very
+//  same loops.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//      Rev 0.2   17 Oct 2026   Ramp of freq. linear in time.
+//      Rev 0.3   17 Oct 2026   Phase step in 64 bits, split over words at low freqs.
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef DCOWORK_H_
+#define DCOWORK_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "dcomod.h"
+
+/* RPix: The full barrier, dmb on the target; the simulator is single threaded. */
+#define DCO_DMB() __sync_synchronize()
+
+enum
+{
+    eDCOWorkDelayCycles = 4,    /* Must match PIOASM_DELAY_CYCLES of dco2.pio. */
+    eDCOWorkMaxBatch = 1 << 20, /* Max words of a loop betwixt the slow paths. */
+    eDCOEventQueueLen = 16      /* Length of event queue, power of 2. */
+};
+
+enum PioDcoModulator
+{
+    eDCOMOD_FIRST_ORDER = 0,    /* First order error feedback, the cheapest. */
+    eDCOMOD_MASH111 = 1,        /* MASH 1-1-1, low close-in spurs. */
+    eDCOMOD_HIRES = 2           /* First order of 2^-56 resolution, sub-mHz steps. */
+};
+
+enum PioDcoRampMode
+{
+    eDCORAMP_OFF = 0,           /* No ramp, the freq. is set by requests. */
+    eDCORAMP_ONCE = 1,          /* Sweep start to stop, then stay at stop. */
+    eDCORAMP_REPEAT = 2,        /* Sweep start to stop, then restart from start. */
+    eDCORAMP_TRIANGLE = 3       /* Sweep start to stop and back, endlessly. */
+};
+
+enum PioDcoLoop
+{
+    eDCOLOOP_FIRST_ORDER = 0,   /* Steady freq., first order modulator. */
+    eDCOLOOP_MASH111 = 1,       /* Steady freq., MASH 1-1-1. */
+    eDCOLOOP_HIRES = 2,         /* Steady freq., first order of high resolution. */
+    eDCOLOOP_GENERIC = 3        /* Ramp or phase step, all requests checked every word. */
+};
+
+/* Single producer, single consumer mailbox of frequency requests. The producer
+   makes the sequence number odd while writing the request and even when it's
+   done; the worker picks the request up at the word boundary and reports back
+   the sequence number and the word count at which the request took effect. */
+typedef struct
+{
+    volatile uint32_t _ui32_seq;          /* Sequence number of the last request. */
+    volatile int32_t _i32_cycles;         /* CPU CLK cycles per PI less PIO delay. */
+    volatile uint32_t _ui32_cycles_ext;   /* The next 32 bits of the fraction of it. */
+    volatile uint32_t _ui32_frq_hz;       /* The freq. it is of, 0 if unknown. */
+    volatile int32_t _i32_frq_millihz;    /* The freq. additive shift, mHz. */
+
+    volatile uint32_t _ui32_seq_applied;  /* Sequence number of the request applied. */
+    volatile uint32_t _ui32_word_applied; /* Worker word count it was applied at. */
+
+} PioDcoMailbox;
+
+/* Ramp request, passed to the worker by the sequence number the same way as
+   the mailbox does. The ramp runs in units of cycles per PI scaled by 2^56, its
+   freq. is linear in time, see PioDCORampDelta. */
+typedef struct
+{
+    volatile uint32_t _ui32_seq;          /* Sequence number, odd while writing. */
+    volatile int64_t _i64_start;          /* Cycles per PI less PIO delay at start. */
+    volatile int64_t _i64_stop;           /* Cycles per PI less PIO delay at stop. */
+    volatile uint32_t _ui32_rate;         /* Mantissa of the rate, see PioDCORampRate. */
+    volatile uint32_t _ui32_rate_shift;   /* Its negated exponent. */
+    volatile enum PioDcoRampMode _mode;
+
+} PioDcoRampRequest;
+
+/* Time tagged frequency switch. The time is the tick of output timeline, that
+   is the count of CPU CLK cycles generated by DCO since its worker started. */
+typedef struct
+{
+    uint64_t _u64_tick;         /* Output tick to switch at. */
+    int32_t _i32_cycles;        /* CPU CLK cycles per PI less PIO delay. */
+
+} PioDcoEvent;
+
+/* Single producer, single consumer queue of time tagged frequency switches. */
+typedef struct
+{
+    PioDcoEvent _events[eDCOEventQueueLen];
+
+    volatile uint32_t _ui32_head;         /* Written by producer only. */
+    volatile uint32_t _ui32_tail;         /* Written by worker only. */
+
+    volatile int32_t _i32_last_err_ticks; /* Applied minus requested tick of the last event. */
+    volatile uint32_t _ui32_applied;      /* Count of events applied. */
+
+} PioDcoEventQueue;
+
+/* The requests to the worker. Every producer bumps the sequence number once its
+   request is complete, it's the only thing the steady loops look at. */
+typedef struct
+{
+    volatile uint32_t _ui32_seq;          /* Bumped by every request of any kind. */
+    volatile enum PioDcoModulator _modulator; /* Cycle count modulator. */
+
+    PioDcoMailbox _mbox;                  /* Frequency requests. */
+    PioDcoEventQueue _evq;                /* Time tagged frequency switches. */
+    PioDcoRampRequest _ramp;              /* Linear ramp request. */
+
+    volatile uint32_t _ui32_phase_req;    /* Phase offset commanded, 2^32 per turn. */
+    volatile uint32_t _ui32_phase_applied;/* Phase offset applied by worker. */
+    volatile uint32_t _ui32_phase_word;   /* Worker word count it was applied at. */
+
+} PioDcoCtl;
+
+/* The state of worker. PioDCOWorker2 keeps it on stack, DMA & bank engines
+   keep it in DCO context. */
+typedef struct
+{
+    uint32_t _ui32_seq;         /* Mailbox request in work. */
+    int32_t _i32_cycles;        /* CPU CLK cycles per PI less PIO delay in work. */
+    uint32_t _ui32_cycles_ext;  /* The next 32 bits of the fraction of it. */
+    uint32_t _ui32_frq_hz;      /* The freq. of mailbox request, 0 if unknown. */
+    int32_t _i32_frq_millihz;   /* The freq. additive shift, mHz. */
+    int32_t _i32acc_error;      /* Accumulated error of first order loop. */
+    uint64_t _u64acc_hires;     /* Accumulated fraction of high resolution loop. */
+    PioDcoMash _mash;           /* MASH 1-1-1 state. */
+    uint32_t _ui32_word;        /* Count of words generated. */
+    uint64_t _u64_tick;         /* Output tick the next word starts at. */
+
+    uint32_t _ui32_ctl_seq;     /* Control sequence number the loop runs on. */
+    enum PioDcoLoop _loop;      /* The loop in work. */
+    uint32_t _ui32_budget;      /* Words left ere the slow path is due. */
+
+    uint32_t _ui32_ramp_seq;    /* Ramp request in work. */
+    enum PioDcoRampMode _ramp_mode; /* Ramp in work, eDCORAMP_OFF if none. */
+    int64_t _i64_ramp_acc;      /* Cycles per PI less PIO delay, scaled by 2^56. */
+    int64_t _i64_ramp_start;    /* Ramp start value, scaled by 2^56. */
+    int64_t _i64_ramp_stop;     /* Ramp stop value, scaled by 2^56. */
+    uint32_t _ui32_ramp_rate;   /* Mantissa of the ramp rate. */
+    uint32_t _ui32_ramp_shift;  /* Its negated exponent. */
+
+    uint32_t _ui32_phase;       /* Phase offset applied, 2^32 per turn. */
+
+} PioDcoWork;
+
+/* The sink of words: stores the cycle count to FIFO or buffer. */
+typedef void (*PioDcoPut)(void *pctx, uint32_t ui32wc);
+
+/// @brief Notifies the worker of the request just completed, the producer side.
+/// @param pc Ptr to the requests.
+DCO_INLINE void PioDCOCtlNotify(PioDcoCtl *pc)
+{
+    DCO_DMB();
+    pc->_ui32_seq = pc->_ui32_seq + 1U;
+}
+
+/// @brief Fetches the pending request from the mailbox, the consumer side.
+/// @param pmb Ptr to mailbox.
+/// @param pw Ptr to worker state, the request in work is updated.
+/// @return true if the new request has been fetched.
+DCO_INLINE bool PioDCOMailboxFetch(PioDcoMailbox *pmb, PioDcoWork *pw)
+{
+    const uint32_t ui32seq = pmb->_ui32_seq;
+    if(ui32seq == pw->_ui32_seq || (ui32seq & 1U))
+    {
+        return false;
+    }
+
+    DCO_DMB();
+    const int32_t i32cycles = pmb->_i32_cycles;
+    const uint32_t ui32ext = pmb->_ui32_cycles_ext;
+    const uint32_t ui32hz = pmb->_ui32_frq_hz;
+    const int32_t i32millihz = pmb->_i32_frq_millihz;
+    DCO_DMB();
+
+    /* RPix: The producer has got in the way, its notification comes next. */
+    if(ui32seq != pmb->_ui32_seq)
+    {
+        return false;
+    }
+
+    pw->_i32_cycles = i32cycles;
+    pw->_ui32_cycles_ext = ui32ext;
+    pw->_ui32_frq_hz = ui32hz;
+    pw->_i32_frq_millihz = i32millihz;
+    pw->_ui32_seq = ui32seq;
+    pw->_ramp_mode = eDCORAMP_OFF;
+
+    pmb->_ui32_word_applied = pw->_ui32_word;
+    DCO_DMB();
+    pmb->_ui32_seq_applied = ui32seq;
+
+    return true;
+}
+
+/// @brief Calculates a half of the word of the cycles in work, the ticks.
+/// @param pw Ptr to worker state.
+/// @return 2 half periods of the integer cycle count, PIO delay included.
+DCO_INLINE uint32_t PioDCOHalfWord(const PioDcoWork *pw)
+{
+    return (((uint32_t)pw->_i32_cycles >> 24U) + eDCOWorkDelayCycles) << 1U;
+}
+
+/// @brief Applies the event at the head of queue if the next word starts no earlier
+/// @brief than a half of the word (1 output cycle) ere its tick. A word can't be split,
+/// @brief so it is as exact as the boundaries of 2 output cycles allow.
+/// @param pq Ptr to event queue.
+/// @param pw Ptr to worker state, the cycles in work are updated.
+/// @return true if the event has been applied.
+DCO_INLINE bool PioDCOEventFetch(PioDcoEventQueue *pq, PioDcoWork *pw)
+{
+    const uint32_t ui32tail = pq->_ui32_tail;
+    if(pq->_ui32_head == ui32tail)
+    {
+        return false;
+    }
+
+    DCO_DMB();
+    const PioDcoEvent *pev = &pq->_events[ui32tail & (eDCOEventQueueLen - 1)];
+    if(pw->_u64_tick + PioDCOHalfWord(pw) < pev->_u64_tick)
+    {
+        return false;
+    }
+
+    pw->_i32_cycles = pev->_i32_cycles;
+    pw->_ui32_cycles_ext = 0;
+    pq->_i32_last_err_ticks = (int32_t)(pw->_u64_tick - pev->_u64_tick);
+    ++pq->_ui32_applied;
+
+    DCO_DMB();
+    pq->_ui32_tail = ui32tail + 1U;
+
+    return true;
+}
+
+/// @brief Calculates the words which surely end ere the event at the head of queue
+/// @brief is due, so the loop checks nothing but the control sequence meanwhile.
+/// @param pq Ptr to event queue.
+/// @param pw Ptr to worker state.
+/// @return The word budget, 1 if the event is due at the next word boundary.
+DCO_INLINE uint32_t PioDCOEventBudget(const PioDcoEventQueue *pq, const PioDcoWork *pw)
+{
+    const uint32_t ui32tail = pq->_ui32_tail;
+    if(pq->_ui32_head == ui32tail)
+    {
+        return eDCOWorkMaxBatch;
+    }
+
+    DCO_DMB();
+    const uint64_t u64tick = pq->_events[ui32tail & (eDCOEventQueueLen - 1)]._u64_tick;
+    const uint64_t u64due = pw->_u64_tick + PioDCOHalfWord(pw);
+    if(u64due >= u64tick)
+    {
+        return 1;
+    }
+
+    /* RPix: A word of MASH is 4 cycles per half period longer at most, the
+       others 1 cycle; the boundary of word k is due ere the tick if k-1 of
+       the longest words fit. */
+    const uint32_t ui32max_word = (((uint32_t)pw->_i32_cycles >> 24U) + 4U + eDCOWorkDelayCycles) << 2U;
+    const uint64_t u64room = u64tick - u64due - 1U;
+    if(u64room >= (uint64_t)eDCOWorkMaxBatch * ui32max_word)
+    {
+        return eDCOWorkMaxBatch;
+    }
+
+    return 1U + (uint32_t)u64room / ui32max_word;
+}
+
+/// @brief Calculates the rate of the linear ramp of freq., see PioDCORampDelta: the
+/// @brief value 8 * r * 2^46 / CLK^2, r = span / duration [Hz/s], as the mantissa of
+/// @brief 31 bits & the negated exponent.
+/// @param ui32clk_hz The CPU CLK freq., Hz.
+/// @param ui32span_hz The span of the ramp, Hz.
+/// @param ui32_duration_ms The duration of the ramp, ms.
+/// @param pui32rate Ptr to the mantissa.
+/// @param pui32shift Ptr to the negated exponent.
+/// @return 0 if OK. -1 the rate is out of range.
+static inline int PioDCORampRate(uint32_t ui32clk_hz, uint32_t ui32span_hz,
+                                 uint32_t ui32_duration_ms, uint32_t *pui32rate,
+                                 uint32_t *pui32shift)
+{
+    if(!ui32clk_hz || !ui32span_hz || !ui32_duration_ms)
+    {
+        return -1;
+    }
+
+    /* RPix: The value is x * 2^-e, x is kept of 63 bits ere every division. */
+    const uint32_t ui32divs[3] = { ui32clk_hz, ui32clk_hz, ui32_duration_ms };
+    uint64_t u64x = 8000ULL * ui32span_hz;
+    int e = -46;
+    for(int i = 0; i < 3; ++i)
+    {
+        const int ilz = __builtin_clzll(u64x) - 1;
+        u64x <<= ilz;
+        e += ilz;
+        u64x /= ui32divs[i];
+    }
+
+    const int ilz = __builtin_clzll(u64x) - 1;
+    u64x = (u64x << ilz) >> 32;
+    e += ilz - 32;
+    if(e < 0 || e > 63)
+    {
+        return -1;
+    }
+
+    *pui32rate = (uint32_t)u64x;
+    *pui32shift = (uint32_t)e;
+
+    return 0;
+}
+
+/// @brief Calculates the ramp increment of the next word. The freq. is f = CLK / 2W,
+/// @brief W is the cycles per PI, and a word lasts 4W cycles, so f linear in time,
+/// @brief r [Hz/s], takes W' = W / (1 + e (1 + W'/W) / 2) per word, e = 8 r W^2 / CLK^2,
+/// @brief as every word holds the freq. of its middle. The series is taken to e^2:
+/// @brief W' = W (1 - e + 3 e^2 / 2), the rest is of e^3, below 10^-7 of W for the
+/// @brief sweep of full range in 20 ms. The freq. falls when e is negated.
+/// @param i64acc Cycles per PI less PIO delay, scaled by 2^56, below 128.
+/// @param ui32rate The mantissa of the rate, see PioDCORampRate.
+/// @param ui32shift Its negated exponent.
+/// @param bup true if the cycles per PI grow, that is the freq. falls.
+/// @return The increment, scaled by 2^56.
+DCO_INLINE int64_t PioDCORampDelta(int64_t i64acc, uint32_t ui32rate, uint32_t ui32shift,
+                                   bool bup)
+{
+    /* RPix: Rounded, the bias of truncation would be that of the rate. */
+    const uint32_t ui32w = (uint32_t)(i64acc >> 32) + (eDCOWorkDelayCycles << 24); /* Q24. */
+    const uint32_t ui32w2 = (uint32_t)(((uint64_t)ui32w * ui32w + (1ULL << 31)) >> 32); /* Q16. */
+    const uint32_t ui32w3 = (uint32_t)(((uint64_t)ui32w2 * ui32w + (1ULL << 29)) >> 30); /* Q10. */
+
+    /* RPix: W e & W e^2 scaled by 2^56, e scaled by 2^31. */
+    const uint64_t u64we = ((uint64_t)ui32w3 * ui32rate) >> ui32shift;
+    const uint64_t u64e = (((uint64_t)ui32w2 * ui32rate) >> ui32shift) >> 31;
+    const uint64_t u64we2 = (u64we >> 31) * u64e;
+
+    return (bup ? (int64_t)u64we : -(int64_t)u64we) + (int64_t)(u64we2 + (u64we2 >> 1));
+}
+
+/// @brief Fetches the pending ramp request, the consumer side.
+/// @param pr Ptr to ramp request.
+/// @param pw Ptr to worker state, the ramp in work is updated.
+/// @return true if the new request has been fetched.
+DCO_INLINE bool PioDCORampFetch(PioDcoRampRequest *pr, PioDcoWork *pw)
+{
+    const uint32_t ui32seq = pr->_ui32_seq;
+    if(ui32seq & 1U)
+    {
+        return false;
+    }
+
+    DCO_DMB();
+    const enum PioDcoRampMode emode = pr->_mode;
+    const int64_t i64start = pr->_i64_start;
+    const int64_t i64stop = pr->_i64_stop;
+    const uint32_t ui32rate = pr->_ui32_rate;
+    const uint32_t ui32shift = pr->_ui32_rate_shift;
+    DCO_DMB();
+    if(ui32seq != pr->_ui32_seq)
+    {
+        return false;
+    }
+
+    pw->_ui32_ramp_seq = ui32seq;
+    pw->_ramp_mode = emode;
+    if(eDCORAMP_OFF != emode)
+    {
+        pw->_i64_ramp_start = i64start;
+        pw->_i64_ramp_stop = i64stop;
+        pw->_ui32_ramp_rate = ui32rate;
+        pw->_ui32_ramp_shift = ui32shift;
+
+        /* RPix: Every word holds the freq. of its middle, so the ramp starts a half
+           increment ahead of the start. */
+        pw->_i64_ramp_acc = i64start
+                            - PioDCORampDelta(i64start, ui32rate, ui32shift, i64stop > i64start) / 2;
+    }
+
+    return true;
+}
+
+/// @brief Advances the ramp in work by one word.
+/// @param pw Ptr to worker state, the cycles in work are updated.
+DCO_INLINE void PioDCORampStep(PioDcoWork *pw)
+{
+    const bool bup = pw->_i64_ramp_stop > pw->_i64_ramp_start;
+    pw->_i64_ramp_acc += PioDCORampDelta(pw->_i64_ramp_acc, pw->_ui32_ramp_rate,
+                                         pw->_ui32_ramp_shift, bup);
+
+    const bool bpast = bup ? pw->_i64_ramp_acc >= pw->_i64_ramp_stop
+                           : pw->_i64_ramp_acc <= pw->_i64_ramp_stop;
+    if(bpast)
+    {
+        switch(pw->_ramp_mode)
+        {
+            case eDCORAMP_REPEAT:
+                pw->_i64_ramp_acc = pw->_i64_ramp_start;
+                break;
+
+            case eDCORAMP_TRIANGLE:
+            {
+                /* RPix: Reflect the overshoot and run backwards. */
+                const int64_t i64start = pw->_i64_ramp_start;
+                pw->_i64_ramp_acc = pw->_i64_ramp_stop - (pw->_i64_ramp_acc - pw->_i64_ramp_stop);
+                pw->_i64_ramp_start = pw->_i64_ramp_stop;
+                pw->_i64_ramp_stop = i64start;
+                break;
+            }
+
+            default:
+                pw->_i64_ramp_acc = pw->_i64_ramp_stop;
+                pw->_ramp_mode = eDCORAMP_OFF;
+                break;
+        }
+    }
+
+    pw->_i32_cycles = (int32_t)(pw->_i64_ramp_acc >> 32);
+    pw->_ui32_cycles_ext = (uint32_t)pw->_i64_ramp_acc;
+}
+
+/// @brief Calculates the change of cycles per PI of the next word which applies the
+/// @brief pending phase step. A phase advance is done by shrinking the word if its
+/// @brief cycle count has the margin, by stretching it by the rest of turn otherwise.
+/// @param pc Ptr to the requests.
+/// @param pw Ptr to worker state, the phase applied is updated.
+/// @param ui32reg CPU CLK cycles per PI less PIO delay of the word, scaled by 2^24.
+/// @return The value to add to ui32reg for one word.
+/// @attention At the lowest freqs the stretch may not fit the 32-bit count of word,
+/// @attention then the word takes what fits and the rest goes to the next words.
+DCO_INLINE int64_t PioDCOPhaseFetch(PioDcoCtl *pc, PioDcoWork *pw, uint32_t ui32reg)
+{
+    const uint32_t ui32req = pc->_ui32_phase_req;
+    const uint32_t ui32adv = ui32req - pw->_ui32_phase;
+
+    /* RPix: Every half period of the word changes by 1/4 of the step, that is
+       the fraction of turn times 2 half periods per turn / 4. */
+    const uint64_t u64cpp = ui32reg + ((uint64_t)eDCOWorkDelayCycles << 24U);
+    const uint64_t u64shrink = (u64cpp * ui32adv) >> 33U;
+
+    if(ui32adv <= (1U<<31) && ui32reg >= u64shrink + ((uint64_t)eDCOModMashMinCycles << 24U))
+    {
+        pw->_ui32_phase = ui32req;
+        pc->_ui32_phase_word = pw->_ui32_word;
+        DCO_DMB();
+        pc->_ui32_phase_applied = ui32req;
+
+        return -(int64_t)u64shrink;
+    }
+
+    uint32_t ui32ret = 0U - ui32adv;
+    int64_t i64delta = (int64_t)((u64cpp * ui32ret) >> 33U);
+    /* RPix: The count stays a count below 2^32, the error feedback of the
+       modulator adds up to one. */
+    const int64_t i64room = (int64_t)(UINT32_MAX - (1U<<24)) - ui32reg;
+    if(i64delta > i64room)
+    {
+        /* RPix: The retard the word can carry, 3/128 turn at least as the lowest
+           freq. of PioDCOSetFreq has below 256 cycles per PI. */
+        ui32ret = (uint32_t)(((uint64_t)i64room << 33U) / u64cpp);
+        i64delta = (int64_t)((u64cpp * ui32ret) >> 33U);
+    }
+
+    pw->_ui32_phase -= ui32ret;
+    pc->_ui32_phase_word = pw->_ui32_word;
+    DCO_DMB();
+    pc->_ui32_phase_applied = pw->_ui32_phase;
+
+    return i64delta;
+}
+
+/// @brief The slow path: fetches the requests, applies the due event and picks the
+/// @brief loop and its word budget.
+/// @param pc Ptr to the requests.
+/// @param pw Ptr to worker state.
+DCO_INLINE void PioDCOService(PioDcoCtl *pc, PioDcoWork *pw)
+{
+    /* RPix: The requests completed ere the sequence number is read are seen. */
+    pw->_ui32_ctl_seq = pc->_ui32_seq;
+    DCO_DMB();
+
+    if(pc->_mbox._ui32_seq != pw->_ui32_seq)
+    {
+        PioDCOMailboxFetch(&pc->_mbox, pw);
+    }
+
+    if(pc->_evq._ui32_head != pc->_evq._ui32_tail)
+    {
+        PioDCOEventFetch(&pc->_evq, pw);
+    }
+
+    if(pc->_ramp._ui32_seq != pw->_ui32_ramp_seq)
+    {
+        PioDCORampFetch(&pc->_ramp, pw);
+    }
+
+    if(eDCORAMP_OFF != pw->_ramp_mode || pc->_ui32_phase_req != pw->_ui32_phase)
+    {
+        pw->_loop = eDCOLOOP_GENERIC;
+        pw->_ui32_budget = 1;
+        return;
+    }
+
+    /* RPix: MASH needs the margin of cycles, at the highest freqs the first
+       order loop is used anyway, also it is the cheapest one there. */
+    const enum PioDcoModulator emod = pc->_modulator;
+    if(eDCOMOD_HIRES == emod)
+    {
+        pw->_loop = eDCOLOOP_HIRES;
+    }
+    else if(eDCOMOD_MASH111 == emod
+            && (uint32_t)pw->_i32_cycles >= ((uint32_t)eDCOModMashMinCycles << 24U))
+    {
+        pw->_loop = eDCOLOOP_MASH111;
+    }
+    else
+    {
+        pw->_loop = eDCOLOOP_FIRST_ORDER;
+    }
+
+    pw->_ui32_budget = PioDCOEventBudget(&pc->_evq, pw);
+}
+
+/// @brief Calculates the next word of the generic loop: the ramp advances, the
+/// @brief pending phase step is applied and the selected modulator runs.
+/// @param pc Ptr to the requests.
+/// @param pw Ptr to worker state.
+/// @return The cycle count for the next PIO word.
+DCO_INLINE uint32_t PioDCOStepGeneric(PioDcoCtl *pc, PioDcoWork *pw)
+{
+    if(eDCORAMP_OFF != pw->_ramp_mode)
+    {
+        PioDCORampStep(pw);
+    }
+
+    uint32_t ui32reg = pw->_i32_cycles;
+    if(pc->_ui32_phase_req != pw->_ui32_phase)
+    {
+        ui32reg = (uint32_t)(ui32reg + PioDCOPhaseFetch(pc, pw, ui32reg));
+    }
+
+    const enum PioDcoModulator emod = pc->_modulator;
+    if(eDCOMOD_HIRES == emod)
+    {
+        return PioDCOModFirstOrderHiRes(ui32reg, pw->_ui32_cycles_ext, &pw->_u64acc_hires);
+    }
+    else if(eDCOMOD_MASH111 == emod && ui32reg >= ((uint32_t)eDCOModMashMinCycles << 24U))
+    {
+        return PioDCOModMash111(ui32reg, &pw->_mash);
+    }
+
+    return PioDCOModFirstOrder(ui32reg, &pw->_i32acc_error);
+}
+
+/// @brief Runs the worker loop: the slow path if any request has come or the budget
+/// @brief has run out, then the loop in work, up to the count of words given. The
+/// @brief word count & the output tick are accounted once per run.
+/// @param pc Ptr to the requests.
+/// @param pw Ptr to worker state.
+/// @param ui32max Max words to put, > 0.
+/// @param put The sink of words, it gets inlined.
+/// @param pctx Ptr to the context of sink.
+/// @return The count of words put, 1...ui32max.
+DCO_INLINE uint32_t PioDCORun(PioDcoCtl *pc, PioDcoWork *pw, uint32_t ui32max,
+                              PioDcoPut put, void *pctx)
+{
+    if(!pw->_ui32_budget || pw->_ui32_ctl_seq != pc->_ui32_seq)
+    {
+        PioDCOService(pc, pw);
+    }
+
+    const uint32_t ui32seq = pw->_ui32_ctl_seq;
+    const uint32_t ui32n = ui32max < pw->_ui32_budget ? ui32max : pw->_ui32_budget;
+    uint32_t n = 0;
+    uint32_t ui32sum = 0;
+
+    switch(pw->_loop)
+    {
+        case eDCOLOOP_FIRST_ORDER:
+        {
+            const uint32_t ui32reg = pw->_i32_cycles;
+            const int32_t i32acc0 = pw->_i32acc_error;
+            int32_t i32acc = i32acc0;
+            do
+            {
+                put(pctx, PioDCOModFirstOrder(ui32reg, &i32acc));
+            }
+            while(++n < ui32n && ui32seq == pc->_ui32_seq);
+
+            /* RPix: The error fed back telescopes, so the sum of counts is exact. */
+            ui32sum = (uint32_t)(((int64_t)n * ui32reg + i32acc - i32acc0) >> 24);
+            pw->_i32acc_error = i32acc;
+            break;
+        }
+
+        case eDCOLOOP_MASH111:
+        {
+            const uint32_t ui32reg = pw->_i32_cycles;
+            PioDcoMash mash = pw->_mash;
+            do
+            {
+                const uint32_t ui32wc = PioDCOModMash111(ui32reg, &mash);
+                ui32sum += ui32wc;
+                put(pctx, ui32wc);
+            }
+            while(++n < ui32n && ui32seq == pc->_ui32_seq);
+
+            pw->_mash = mash;
+            break;
+        }
+
+        case eDCOLOOP_HIRES:
+        {
+            const uint32_t ui32reg = pw->_i32_cycles;
+            const uint32_t ui32ext = pw->_ui32_cycles_ext;
+            uint64_t u64acc = pw->_u64acc_hires;
+            do
+            {
+                const uint32_t ui32wc = PioDCOModFirstOrderHiRes(ui32reg, ui32ext, &u64acc);
+                ui32sum += ui32wc;
+                put(pctx, ui32wc);
+            }
+            while(++n < ui32n && ui32seq == pc->_ui32_seq);
+
+            pw->_u64acc_hires = u64acc;
+            break;
+        }
+
+        default:
+        {
+            ui32sum = PioDCOStepGeneric(pc, pw);
+            put(pctx, ui32sum);
+            n = 1;
+            break;
+        }
+    }
+
+    pw->_ui32_budget -= n;
+    pw->_ui32_word += n;
+    pw->_u64_tick += (uint64_t)(ui32sum + n * eDCOWorkDelayCycles) << 2U;
+
+    return n;
+}
+
+/// @brief The sink which stores the word to the buffer.
+/// @param pctx Ptr to the ptr to the buffer, it's advanced.
+/// @param ui32wc The cycle count.
+DCO_INLINE void PioDCOPutBuf(void *pctx, uint32_t ui32wc)
+{
+    uint32_t **ppdst = (uint32_t **)pctx;
+    *(*ppdst)++ = ui32wc;
+}
+
+/// @brief Renders the next words of the worker to the buffer, as DMA engine does.
+/// @param pc Ptr to the requests.
+/// @param pw Ptr to worker state.
+/// @param pui32dst Ptr to the buffer.
+/// @param ui32len The count of words to render.
+DCO_INLINE void PioDCORender(PioDcoCtl *pc, PioDcoWork *pw, uint32_t *pui32dst, uint32_t ui32len)
+{
+    for(uint32_t i = 0; i < ui32len; )
+    {
+        i += PioDCORun(pc, pw, ui32len - i, PioDCOPutBuf, &pui32dst);
+    }
+}
+
+#endif
@@ -40,6 +40,11 @@
 //      Rev 0.1   05 Nov 2023   Initial release
 //      Rev 0.2   18 Nov 2023
 //      Rev 1.0   10 Dec 2023   Improved frequency range (to ~33.333 MHz).
+//      Rev 1.1   16 Oct 2026   DMA fed engine.
+//      Rev 1.2   16 Oct 2026   MASH 1-1-1 modulator.
+//      Rev 1.3   16 Oct 2026   Any free PIO state machine, bank of DCOs.
+//      Rev 1.4   16 Oct 2026   Per instance frequency mailbox.
+//      Rev 1.5   16 Oct 2026   Time tagged frequency event queue.
 //
 //  PROJECT PAGE
 //      https://github.com/RPiks/pico-hf-oscillator
@@ -70,17 +75,157 @@
 #include "piodco.h"
 
 #include <string.h>
+#include "hardware/dma.h"
+#include "hardware/adc.h"
+#include "hardware/irq.h"
+#include "hardware/structs/systick.h"
 #include "../lib/assert.h"
 
-#include "dco2.pio.h"
+_Static_assert(eDCOWorkDelayCycles == PIOASM_DELAY_CYCLES, "dcowork.h is off dco2.pio");
 
-volatile int32_t si32precise_cycles;
+static PioDco *spDmaOwner[NUM_DMA_CHANNELS];    /* DMA channel to DCO map. */
+static int siDcoOffset[NUM_PIOS];               /* `dco` program offset + 1 per PIO. */
+static int siDcoDutyOffset[NUM_PIOS];           /* `dco_duty` program offset + 1 per PIO. */
+static int siDcoCountOffset[NUM_PIOS];          /* `dco_count` program offset + 1 per PIO. */
+
+static uint32_t sui32ReplayBuf[2][eDCOReplayMaxWords]; /* Replayed & next period by DMA. */
+static PioDco *spReplayOwner;                   /* DCO the replay buffers are used by. */
+
+/// @brief Posts the request to the worker, see PioDcoMailbox.
+/// @param pdco Ptr to DCO context.
+/// @param i32cycles CPU CLK cycles per PI less PIO delay, scaled by 2^24.
+/// @param ui32ext The next 32 bits of the fraction.
+/// @param ui32_frq_hz The freq. the value is of, Hz, 0 if unknown.
+/// @param i32_frq_millihz The freq. additive shift, mHz.
+/// @return The sequence number of the request.
+static uint32_t PioDCOPostRequest(PioDco *pdco, int32_t i32cycles, uint32_t ui32ext,
+                                  uint32_t ui32_frq_hz, int32_t i32_frq_millihz)
+{
+    assert_(pdco);
+
+    PioDcoMailbox *pmb = &pdco->_ctl._mbox;
+    const uint32_t ui32seq = pmb->_ui32_seq;
+
+    pmb->_ui32_seq = ui32seq + 1U;
+    __dmb();
+    pmb->_i32_cycles = i32cycles;
+    pmb->_ui32_cycles_ext = ui32ext;
+    pmb->_ui32_frq_hz = ui32_frq_hz;
+    pmb->_i32_frq_millihz = i32_frq_millihz;
+    __dmb();
+    pmb->_ui32_seq = ui32seq + 2U;
+    PioDCOCtlNotify(&pdco->_ctl);
+
+    return ui32seq + 2U;
+}
+
+/// @brief Posts the nominal freq. kept by GPSDO state, corrected by its CPU CLK error.
+/// @param pdco Ptr to DCO context.
+/// @return The sequence number of the request.
+static uint32_t PioDCOPostGpsdo(PioDco *pdco)
+{
+    const PioDcoGpsdo *pg = &pdco->_gpsdo;
+    const uint64_t u64cycles = PioDCOGpsdoCorrect(pg, pg->_u64_cycles)
+                               - ((uint64_t)PIOASM_DELAY_CYCLES << 56U);
+
+    /* RPix: The corrected value has no exact rational form in mHz. */
+    return PioDCOPostRequest(pdco, (int32_t)(u64cycles >> 32U), (uint32_t)u64cycles,
+                             pg->_i64_scale ? 0 : pg->_ui32_frq_hz, pg->_i32_frq_millihz);
+}
+
+/// @brief Reposts the freq. set & MFSK tones of the changed GPSDO correction.
+/// @param pdco Ptr to DCO context.
+static void PioDCOGpsdoRepost(PioDco *pdco)
+{
+    if(pdco->_gpsdo._u64_cycles)
+    {
+        PioDCOPostGpsdo(pdco);
+    }
+    PioDCOTonesRefresh(pdco);
+}
+
+/// @brief Posts the freq. of the setters, it's kept as the nominal one of GPSDO.
+/// @param pdco Ptr to DCO context.
+/// @param u64cycles CPU CLK cycles per PI, scaled by 2^56.
+/// @param ui32_frq_hz The freq. the value is of, Hz, 0 if unknown.
+/// @param i32_frq_millihz The freq. additive shift, mHz.
+static void PioDCOPostFreq(PioDco *pdco, uint64_t u64cycles, uint32_t ui32_frq_hz,
+                           int32_t i32_frq_millihz)
+{
+    PioDcoGpsdo *pg = &pdco->_gpsdo;
+    pg->_u64_cycles = u64cycles;
+    pg->_ui32_frq_hz = ui32_frq_hz;
+    pg->_i32_frq_millihz = i32_frq_millihz;
+    pdco->_tones._ix = -1;      /* The tone is not on air anymore. */
+
+    PioDCOPostGpsdo(pdco);
+}
+
+/// @brief Clears the sticky TX stall flag of DCO state machine.
+/// @param pdco Ptr to DCO context.
+static inline void PioDCOClearStall(PioDco *pdco)
+{
+    pdco->_pio->fdebug = 1U << (PIO_FDEBUG_TXSTALL_LSB + pdco->_ism);
+}
+
+/// @brief Claims a free state machine on any PIO, pio0 first. The program is
+/// @brief loaded once per PIO and shared by all its state machines.
+/// @param pprogram Ptr to PIO program.
+/// @param poffsets Ptr to the program offsets + 1 per PIO, 0 if not loaded.
+/// @param ppio Ptr to the PIO claimed.
+/// @param pism Ptr to the index of state machine claimed.
+/// @param poffset Ptr to the program offset, may be NULL.
+/// @return 0 if OK. -1 no free state machine or instruction memory.
+static int PioDCOClaimAnySM(const pio_program_t *pprogram, int *poffsets,
+                            PIO *ppio, int *pism, int *poffset)
+{
+    for(uint ipio = 0; ipio < NUM_PIOS; ++ipio)
+    {
+        PIO pio = pio_get_instance(ipio);
+        if(!poffsets[ipio] && !pio_can_add_program(pio, pprogram))
+        {
+            continue;
+        }
+
+        const int ism = pio_claim_unused_sm(pio, false);
+        if(ism < 0)
+        {
+            continue;
+        }
+
+        if(!poffsets[ipio])
+        {
+            poffsets[ipio] = 1 + pio_add_program(pio, pprogram);
+        }
+
+        *ppio = pio;
+        *pism = ism;
+        if(poffset)
+        {
+            *poffset = poffsets[ipio] - 1;
+        }
+
+        return 0;
+    }
+
+    return -1;
+}
+
+/// @brief Claims a free state machine of DCO on any PIO, see PioDCOClaimAnySM.
+/// @param pdco Ptr to DCO context.
+/// @param pprogram Ptr to PIO program.
+/// @param poffsets Ptr to the program offsets + 1 per PIO, 0 if not loaded.
+/// @return 0 if OK. -1 no free state machine or instruction memory.
+static int PioDCOClaimSM(PioDco *pdco, const pio_program_t *pprogram, int *poffsets)
+{
+    return PioDCOClaimAnySM(pprogram, poffsets, &pdco->_pio, &pdco->_ism, &pdco->_offset);
+}
 
 /// @brief Initializes DCO context and prepares PIO hardware.
 /// @param pdco Ptr to DCO context.
 /// @param gpio The GPIO of DCO output.
 /// @param cpuclkhz The system CPU clock freq., Hz.
-/// @return 0 if OK.
+/// @return 0 if OK. -1 no free PIO state machine.
 int PioDCOInit(PioDco *pdco, int gpio, int cpuclkhz)
 {
     assert_(pdco);
@@ -88,11 +233,15 @@ int PioDCOInit(PioDco *pdco, int gpio, int cpuclkhz)
 
     memset(pdco, 0, sizeof(PioDco));
 
+    pdco->_dma_chan[0] = pdco->_dma_chan[1] = -1;
+    pdco->_replay_chan[0] = pdco->_replay_chan[1] = -1;
+    pdco->_meas_ism = -1;
     pdco->_clkfreq_hz = cpuclkhz;
-    pdco->_pio = pio0;
     pdco->_gpio = gpio;
-    pdco->_offset = pio_add_program(pdco->_pio, &dco_program);
-    pdco->_ism = pio_claim_unused_sm(pdco->_pio, true);
+    if(PioDCOClaimSM(pdco, &dco_program, siDcoOffset))
+    {
+        return -1;
+    }
 
     gpio_init(pdco->_gpio);
     pio_gpio_init(pdco->_pio, pdco->_gpio);
@@ -109,6 +258,61 @@ int PioDCOInit(PioDco *pdco, int gpio, int cpuclkhz)
     return 0;
 }
 
+/// @brief Initializes DCO context of duty cycle variant and prepares PIO hardware.
+/// @brief The DCO is run by PioDCOWorkerDuty then, the duty cycle is 50% initially.
+/// @param pdco Ptr to DCO context.
+/// @param gpio The GPIO of DCO output.
+/// @param cpuclkhz The system CPU clock freq., Hz.
+/// @return 0 if OK. -1 no free PIO state machine.
+/// @attention The freq. range is CPU CLK / 262 ... CPU CLK / 6, every level lasts
+/// @attention 3...130 cycles; the narrower duty, the lower max freq.
+int PioDCOInitDuty(PioDco *pdco, int gpio, int cpuclkhz)
+{
+    assert_(pdco);
+    assert_(cpuclkhz);
+
+    memset(pdco, 0, sizeof(PioDco));
+
+    pdco->_dma_chan[0] = pdco->_dma_chan[1] = -1;
+    pdco->_replay_chan[0] = pdco->_replay_chan[1] = -1;
+    pdco->_meas_ism = -1;
+    pdco->_clkfreq_hz = cpuclkhz;
+    pdco->_gpio = gpio;
+    pdco->_ui32_duty_q16 = 1U << 15;
+    if(PioDCOClaimSM(pdco, &dco_duty_program, siDcoDutyOffset))
+    {
+        return -1;
+    }
+
+    gpio_init(pdco->_gpio);
+    pio_gpio_init(pdco->_pio, pdco->_gpio);
+
+    dco_duty_program_init(pdco->_pio, pdco->_ism, pdco->_offset, pdco->_gpio);
+    pdco->_pio_sm = dco_duty_program_get_default_config(pdco->_offset);
+
+    sm_config_set_out_shift(&pdco->_pio_sm, true, true, 32);           // Autopull.
+    sm_config_set_fifo_join(&pdco->_pio_sm, PIO_FIFO_JOIN_TX);
+    sm_config_set_set_pins(&pdco->_pio_sm, pdco->_gpio, 1);
+
+    pio_sm_init(pdco->_pio, pdco->_ism, pdco->_offset, &pdco->_pio_sm);
+
+    return 0;
+}
+
+/// @brief Sets the duty cycle of output of duty cycle variant of DCO, e.g. 1/3 for
+/// @brief the strongest 3rd harmonic, 1/5 for the 5th one.
+/// @param pdco Ptr to DCO context.
+/// @param ui32duty_q16 Duty cycle, 65536 is 100%.
+/// @attention The func can be called while DCO running.
+void PioDCOSetDuty(PioDco *pdco, uint32_t ui32duty_q16)
+{
+    assert_(pdco);
+    assert_(ui32duty_q16 <= 65536U);
+
+    pdco->_ui32_duty_q16 = ui32duty_q16;
+    PioDCOCtlNotify(&pdco->_ctl);
+}
+
 /// @brief Sets DCO working frequency in Hz: Fout = ui32_frq_hz + ui32_frq_millihz * 1e-3.
 /// @param pdco Ptr to DCO context.
 /// @param i32_frq_hz The `coarse` part of frequency [Hz]. Might be negative.
@@ -122,150 +326,1425 @@ int PioDCOSetFreq(PioDco *pdco, uint32_t ui32_frq_hz, int32_t ui32_frq_millihz)
 
     /* RPix: Calculate an accurate value of phase increment of the freq
        per 1 tick of CPU clock, here 2^24 is scaling coefficient. */
-    const int64_t i64denominator = 2000LL * (int64_t)ui32_frq_hz + (int64_t)ui32_frq_millihz;
-    pdco->_frq_cycles_per_pi = (int32_t)(((int64_t)pdco->_clkfreq_hz * (int64_t)(1<<24) * 1000LL
-                                         +(i64denominator>>1)) / i64denominator);
+    pdco->_frq_cycles_per_pi = PioDCOModCyclesPerPi(pdco->_clkfreq_hz, ui32_frq_hz, ui32_frq_millihz);
 
-    si32precise_cycles = pdco->_frq_cycles_per_pi - (PIOASM_DELAY_CYCLES<<24);
+    PioDCOPostFreq(pdco, (uint64_t)pdco->_frq_cycles_per_pi << 32U, ui32_frq_hz, ui32_frq_millihz);
 
     pdco->_ui32_frq_hz = ui32_frq_hz;
     pdco->_ui32_frq_millihz = ui32_frq_millihz;
+    pdco->_harmonic = 1;
+
+    return 0;
+}
+
+/// @brief Sets DCO working frequency in uHz: Fout = ui32_frq_hz + i32_frq_microhz * 1e-6.
+/// @brief The full resolution is yielded by eDCOMOD_HIRES modulator, the others use
+/// @brief the value rounded down to 2^-24 cycle.
+/// @param pdco Ptr to DCO context.
+/// @param ui32_frq_hz The `coarse` part of frequency [Hz].
+/// @param i32_frq_microhz The `fine` part of frequency [uHz]. Might be negative.
+/// @return 0 if OK. -1 invalid freq.
+/// @attention The func can be called while DCO running.
+int PioDCOSetFreqMicroHertz(PioDco *pdco, uint32_t ui32_frq_hz, int32_t i32_frq_microhz)
+{
+    assert_(pdco);
+    assert_(pdco->_clkfreq_hz);
+
+    if(ui32_frq_hz <= (pdco->_clkfreq_hz >> 9))
+    {
+        return -1;
+    }
+
+    const uint64_t u64cycles = PioDCOModCyclesPerPiHiRes(pdco->_clkfreq_hz, ui32_frq_hz,
+                                                         i32_frq_microhz)
+                               - ((uint64_t)PIOASM_DELAY_CYCLES << 56U);
+
+    pdco->_frq_cycles_per_pi = (int32_t)(u64cycles >> 32U) + (PIOASM_DELAY_CYCLES<<24);
+    /* RPix: The freq. of uHz shift has no exact rational form in mHz. */
+    const bool bmillihz = !(i32_frq_microhz % 1000);
+    PioDCOPostFreq(pdco, u64cycles + ((uint64_t)PIOASM_DELAY_CYCLES << 56U),
+                   bmillihz ? ui32_frq_hz : 0, i32_frq_microhz / 1000);
+
+    pdco->_ui32_frq_hz = ui32_frq_hz;
+    pdco->_ui32_frq_millihz = i32_frq_microhz / 1000;
+    pdco->_harmonic = 1;
+
+    return 0;
+}
+
+/// @brief Sets DCO working frequency so that the odd harmonic of output is the
+/// @brief target frequency; the lowest harmonic which reaches it is chosen.
+/// @param pdco Ptr to DCO context.
+/// @param ui32_frq_hz The `coarse` part of target frequency [Hz].
+/// @param i32_frq_millihz The `fine` part of target frequency [mHz]. Might be negative.
+/// @param pplan Ptr to the plan to report, may be NULL.
+/// @return 0 if OK. -1 the freq. is out of reach.
+/// @attention The func can be called while DCO running.
+int PioDCOSetFreqHarmonic(PioDco *pdco, uint32_t ui32_frq_hz, int32_t i32_frq_millihz,
+                          PioDcoPlan *pplan)
+{
+    assert_(pdco);
+    assert_(pdco->_clkfreq_hz);
+
+    PioDcoPlan plan;
+    if(!pplan)
+    {
+        pplan = &plan;
+    }
+
+    if(PioDCOPlanHarmonic(pdco->_clkfreq_hz, ui32_frq_hz, i32_frq_millihz, pplan))
+    {
+        return -1;
+    }
+
+    pdco->_frq_cycles_per_pi = pplan->_i32_cycles_per_pi;
+    PioDCOPostFreq(pdco, (uint64_t)pdco->_frq_cycles_per_pi << 32U,
+                   pplan->_ui32_fund_hz, pplan->_i32_fund_millihz);
+
+    pdco->_ui32_frq_hz = pplan->_ui32_fund_hz;
+    pdco->_ui32_frq_millihz = pplan->_i32_fund_millihz;
+    pdco->_harmonic = pplan->_harmonic;
 
     return 0;
 }
 
+/// @brief Calculates the frequency shift [milliHz] of the given correction.
+/// @param i64_ppb The correction, parts per billion.
+/// @param u64_frq_millihz The frequency, mHz.
+/// @return mHz * ppb * 1e-9, rounded half away from zero.
+static int32_t PioDCOShiftMilliHertz(int64_t i64_ppb, uint64_t u64_frq_millihz)
+{
+    if(!i64_ppb)
+    {
+        return 0;
+    }
+
+    const int64_t i64prod = i64_ppb * (int64_t)u64_frq_millihz;
+    return (int32_t)((i64prod + (i64prod < 0 ? -500000000LL : 500000000LL)) / 1000000000LL);
+}
+
 /// @brief Obtains the frequency shift [milliHz] which is calculated for a given frequency.
 /// @param pdco Ptr to Context.
-/// @param u64_desired_frq_millihz The frequency for which we want to calculate correction.
-/// @return The value of correction we need to subtract from desired freq. to compensate
-/// @return Pico's reference clock shift. 2854974.
-int32_t PioDCOGetFreqShiftMilliHertz(const PioDco *pdco, uint64_t u64_desired_frq_millihz)
+/// @param u64_desired_frq_millihz The frequency for which we want to calculate correction, mHz.
+/// @return The value of correction [mHz] we need to subtract from desired freq. to compensate
+/// @return Pico's reference clock shift. In eDCOMODE_GPS_COMPENSATED it's of the correction
+/// @return applied by GPSDO, so the tones follow its slew & holdover.
+int32_t PioDCOGetFreqShiftMilliHertz(PioDco *pdco, uint64_t u64_desired_frq_millihz)
 {
     assert_(pdco);
+    if(eDCOMODE_GPS_COMPENSATED == pdco->_mode)
+    {
+        pdco->_i64_last_correction = pdco->_gpsdo._i64_ppb;
+        return PioDCOShiftMilliHertz(pdco->_i64_last_correction, u64_desired_frq_millihz);
+    }
     if(!pdco->_pGPStime)
     {
         return 0U;
     }
 
-    static int64_t i64_last_correction = 0;
     const int64_t dt = pdco->_pGPStime->_time_data._i32_freq_shift_ppb; /* Parts per billion. */
     if(dt)
     {
-        i64_last_correction = dt;
+        pdco->_i64_last_correction = dt;
+    }
+
+    return PioDCOShiftMilliHertz(pdco->_i64_last_correction, u64_desired_frq_millihz);
+}
+
+/// @brief Posts the new value of cycles per PI to the worker, the producer side of
+/// @brief the mailbox. The worker applies it at the next word boundary.
+/// @param pdco Ptr to DCO context.
+/// @param i32cycles CPU CLK cycles per PI less PIO delay, scaled by 2^24.
+/// @return The sequence number of the request.
+/// @attention All the requests to DCO should be posted by the same core.
+uint32_t PioDCOPostCycles(PioDco *pdco, int32_t i32cycles)
+{
+    return PioDCOPostCyclesExt(pdco, i32cycles, 0);
+}
+
+/// @brief Posts the new value of cycles per PI of high resolution to the worker.
+/// @param pdco Ptr to DCO context.
+/// @param i32cycles CPU CLK cycles per PI less PIO delay, scaled by 2^24.
+/// @param ui32ext The next 32 bits of the fraction, used by eDCOMOD_HIRES only.
+/// @return The sequence number of the request.
+/// @attention All the requests to DCO should be posted by the same core. The value is
+/// @attention posted as is, GPSDO leaves it alone.
+uint32_t PioDCOPostCyclesExt(PioDco *pdco, int32_t i32cycles, uint32_t ui32ext)
+{
+    pdco->_gpsdo._u64_cycles = 0;
+    return PioDCOPostRequest(pdco, i32cycles, ui32ext, 0, 0);
+}
+
+/// @brief Checks whether the worker has applied the last frequency request.
+/// @param pdco Ptr to DCO context.
+/// @param pui32word Ptr to the word count of worker the request took effect at, may be NULL.
+/// @return 1 if the last request is applied, 0 if it's still pending.
+int PioDCOIsFreqApplied(const PioDco *pdco, uint32_t *pui32word)
+{
+    assert_(pdco);
+
+    const PioDcoMailbox *pmb = &pdco->_ctl._mbox;
+    if(pmb->_ui32_seq_applied != pmb->_ui32_seq)
+    {
+        return 0;
     }
 
-    int32_t i32ret_millis;
-    if(i64_last_correction)
+    __dmb();
+    if(pui32word)
     {
-        int64_t i64corr_coeff = (u64_desired_frq_millihz + 500000LL) / 1000000LL;
-        i32ret_millis = (i64_last_correction * i64corr_coeff + 50000LL) / 1000000LL;
+        *pui32word = pmb->_ui32_word_applied;
+    }
+
+    return 1;
+}
+
+/// @brief Queues the frequency switch at the given tick of output timeline. It comes
+/// @brief out at a PIO word boundary, up to 1 output cycle early and up to 1 output
+/// @brief cycle plus the dither of word late: ~1.3 output cycles at 20 MHz, ~2.1 of
+/// @brief MASH 1-1-1, see PioDCOEventPushCycles.
+/// @param pdco Ptr to DCO context.
+/// @param u64tick The tick of output timeline (CPU CLK cycles since worker start).
+/// @param ui32_frq_hz The `coarse` part of frequency [Hz].
+/// @param i32_frq_millihz The `fine` part of frequency [mHz].
+/// @return 0 if OK. -1 the queue is full.
+/// @attention The events should be queued in ascending order of ticks. The freq. is
+/// @attention corrected by GPSDO as of the push, it's not updated afterwards.
+int PioDCOEventPush(PioDco *pdco, uint64_t u64tick, uint32_t ui32_frq_hz, int32_t i32_frq_millihz)
+{
+    assert_(pdco);
+
+    const uint64_t u64cycles = (uint64_t)PioDCOModCyclesPerPi(pdco->_clkfreq_hz, ui32_frq_hz,
+                                                              i32_frq_millihz) << 32U;
+    const int32_t i32cycles = (int32_t)(PioDCOGpsdoCorrect(&pdco->_gpsdo, u64cycles) >> 32U)
+                              - (PIOASM_DELAY_CYCLES<<24);
 
-        return i32ret_millis;
+    return PioDCOEventPushCycles(pdco, u64tick, i32cycles);
+}
+
+/// @brief Queues the switch of cycles per PI at the given tick of output timeline.
+/// @brief A PIO word carries 2 output cycles of one count, so the switch is applied
+/// @brief at the first word which starts no earlier than 1 output cycle ere the tick:
+/// @brief the error is from -1 output cycle to +1 output cycle plus the dither of the
+/// @brief word (4 CPU CLK, 16 of MASH 1-1-1), that is up to ~1.3 output cycles late
+/// @brief at 20 MHz and ~2.1 of MASH 1-1-1, see PioDCOEventLastError & dcosim -E.
+/// @param pdco Ptr to DCO context.
+/// @param u64tick The tick of output timeline (CPU CLK cycles since worker start).
+/// @param i32cycles CPU CLK cycles per PI less PIO delay, scaled by 2^24.
+/// @return 0 if OK. -1 the queue is full.
+int PioDCOEventPushCycles(PioDco *pdco, uint64_t u64tick, int32_t i32cycles)
+{
+    assert_(pdco);
+
+    PioDcoEventQueue *pq = &pdco->_ctl._evq;
+    const uint32_t ui32head = pq->_ui32_head;
+    if(ui32head - pq->_ui32_tail == eDCOEventQueueLen)
+    {
+        return -1;
     }
 
-    return 0U;
+    /* RPix: A request of GPSDO or a tone would override the switch, so they're left alone. */
+    pdco->_gpsdo._u64_cycles = 0;
+    pdco->_tones._ix = -1;
+
+    PioDcoEvent *pev = &pq->_events[ui32head & (eDCOEventQueueLen - 1)];
+    pev->_u64_tick = u64tick;
+    pev->_i32_cycles = i32cycles;
+
+    __dmb();
+    pq->_ui32_head = ui32head + 1U;
+    PioDCOCtlNotify(&pdco->_ctl);
+
+    return 0;
 }
 
-/// @brief Starts the DCO.
+/// @brief Converts the uptime to the tick of output timeline. The output is free
+/// @brief of gaps as long as the worker keeps the FIFO fed, so the timeline runs
+/// @brief strictly at CPU CLK rate since the worker started.
 /// @param pdco Ptr to DCO context.
-void PioDCOStart(PioDco *pdco)
+/// @param u64_us The uptime, us.
+/// @return The tick of output timeline.
+uint64_t PioDCOTickFromUs(const PioDco *pdco, uint64_t u64_us)
 {
     assert_(pdco);
-    pio_sm_set_enabled(pdco->_pio, pdco->_ism, true);
 
-    pdco->_is_enabled = YES;
+    return (u64_us - pdco->_u64_tick0_us) * (pdco->_clkfreq_hz / 1000000UL);
 }
 
-/// @brief Stops the DCO.
+/// @brief Obtains the timing error of the last event applied.
 /// @param pdco Ptr to DCO context.
-void PioDCOStop(PioDco *pdco)
+/// @return Applied minus requested tick, CPU CLK cycles.
+int32_t PioDCOEventLastError(const PioDco *pdco)
 {
     assert_(pdco);
-    pio_sm_set_enabled(pdco->_pio, pdco->_ism, false);
 
-    pdco->_is_enabled = NO;
+    return pdco->_ctl._evq._i32_last_err_ticks;
 }
 
-/// @brief Main worker task of DCO V.2. It is time critical, so it ought to be run on
-/// @brief the dedicated pi pico core.
-/// @param pDCO Ptr to DCO context.
-/// @return No return. It spins forever.
-void RAM (PioDCOWorker2)(PioDco *pDCO)
+/// @brief Calculates cycles per PI of the tone of table, the correction the table
+/// @brief is built with is included.
+/// @param pdco Ptr to DCO context.
+/// @param ix The index of tone.
+/// @return CPU CLK cycles per PI less PIO delay, scaled by 2^24.
+static int32_t PioDCOToneCycles(PioDco *pdco, int ix)
 {
-    register PIO pio = pDCO->_pio;
-    register uint sm = pDCO->_ism;
-    register int32_t i32acc_error = 0;
-    register uint32_t i32wc, i32reg;
+    const PioDcoToneTable *pt = &pdco->_tones;
+    uint64_t u64frq_millihz = pt->_u64_base_millihz + (uint64_t)ix * pt->_ui32_spacing_millihz;
+    u64frq_millihz -= PioDCOShiftMilliHertz(pt->_i64_correction, u64frq_millihz);
 
-LOOP:
-    i32reg = si32precise_cycles;
-    i32wc = (i32reg - i32acc_error) >> 24U;
-    pio_sm_put_blocking(pio, sm, i32wc);
-    i32acc_error += (i32wc << 24U) - i32reg;
+    return PioDCOModCyclesPerPi(pdco->_clkfreq_hz, (uint32_t)(u64frq_millihz / 1000U),
+                                (int32_t)(u64frq_millihz % 1000U))
+           - (PIOASM_DELAY_CYCLES<<24);
+}
 
-    goto LOOP;
+/// @brief Builds the tone table of MFSK modes: Ftone = Fbase + ix * spacing. The
+/// @brief cycles per PI of every tone are calculated here, so PioDCOSetTone does
+/// @brief no division and takes constant time.
+/// @param pdco Ptr to DCO context.
+/// @param ui32_base_hz The `coarse` part of the freq. of tone 0 [Hz].
+/// @param i32_base_millihz The `fine` part of the freq. of tone 0 [mHz]. Might be negative.
+/// @param ui32_spacing_millihz Tone spacing [mHz].
+/// @param ntones Count of tones, 1...eDCOToneMaxCount.
+/// @return 0 if OK. -1 invalid count of tones.
+/// @attention The output is not switched until PioDCOSetTone is called.
+int PioDCOSetTones(PioDco *pdco, uint32_t ui32_base_hz, int32_t i32_base_millihz,
+                   uint32_t ui32_spacing_millihz, int ntones)
+{
+    assert_(pdco);
+    assert_(pdco->_clkfreq_hz);
+
+    if(ntones < 1 || ntones > eDCOToneMaxCount)
+    {
+        return -1;
+    }
+
+    PioDcoToneTable *pt = &pdco->_tones;
+    pt->_u64_base_millihz = 1000ULL * ui32_base_hz + i32_base_millihz;
+    pt->_ui32_spacing_millihz = ui32_spacing_millihz;
+    pt->_ix = -1;
+    pt->_n = 0;
+
+    PioDCOGetFreqShiftMilliHertz(pdco, pt->_u64_base_millihz);
+    pt->_i64_correction = pdco->_i64_last_correction;
+    for(int i = 0; i < ntones; ++i)
+    {
+        pt->_i32_cycles[i] = PioDCOToneCycles(pdco, i);
+    }
+    pt->_n = ntones;
+
+    pdco->_ui32_frq_hz = ui32_base_hz;
+    pdco->_ui32_frq_millihz = i32_base_millihz;
+    pdco->_harmonic = 1;
+
+    return 0;
 }
 
-/// @brief Main worker task of DCO. It is time critical, so it ought to be run on
-/// @brief the dedicated pi pico core.
-/// @param pDCO Ptr to DCO context.
-/// @return No return. It spins forever.
-void RAM (PioDCOWorker)(PioDco *pDCO)
+/// @brief Switches DCO to the tone of table. It takes constant time, so it may be
+/// @brief called at symbol rate.
+/// @param pdco Ptr to DCO context.
+/// @param ix The index of tone.
+/// @return 0 if OK. -1 no such tone.
+int RAM (PioDCOSetTone)(PioDco *pdco, int ix)
 {
-    assert_(pDCO);
+    PioDcoToneTable *pt = &pdco->_tones;
+    if((unsigned)ix >= (unsigned)pt->_n)
+    {
+        return -1;
+    }
 
-    register PIO pio = pDCO->_pio;
-    register uint sm = pDCO->_ism;
-    register int32_t i32acc_error = 0;
-    register uint32_t *preg32 = pDCO->_ui32_pioreg;
-    register uint8_t *pu8reg = (uint8_t *)preg32;
+    pt->_ix = ix;
+    pdco->_frq_cycles_per_pi = pt->_i32_cycles[ix] + (PIOASM_DELAY_CYCLES<<24);
+    PioDCOPostCycles(pdco, pt->_i32_cycles[ix]);
 
-    for(;;)
+    return 0;
+}
+
+/// @brief Folds the current GPS freq. correction into the tone table, if it has
+/// @brief changed since the table was built; the current tone is reissued then.
+/// @param pdco Ptr to DCO context.
+/// @return 1 if the table has been rebuilt, 0 otherwise.
+/// @attention It ought to be called periodically by the same core which calls
+/// @attention PioDCOSetTone, e.g. betwixt symbols.
+int PioDCOTonesRefresh(PioDco *pdco)
+{
+    assert_(pdco);
+
+    PioDcoToneTable *pt = &pdco->_tones;
+    if(!pt->_n)
     {
-        const register int32_t i32reg = si32precise_cycles;
-        /* RPix: Load the next precise value of CPU CLK cycles per DCO cycle,
-           scaled by 2^24. It yields about 24 millihertz resolution at @10MHz
-           DCO frequency. */
-        for(int i = 0; i < 32; ++i)
-        {
-            /* RPix: Calculate the integer number of CPU CLK cycles per next
-               DCO cycle, corrected by accumulated error (feedback of the PLL). */
-            const int32_t i32wc = iSAR32(i32reg - i32acc_error + (1<<23), 24);
-
-            /* RPix: Calculate the difference betwixt calculated value scaled to
-               fine resolution back and precise value of DCO cycles per CPU CLK cycle.
-               This forms a phase locked loop which provides precise freq */
-            i32acc_error += (i32wc<<24) - i32reg;
-
-            /* RPix: Set PIO array contents corrected by pio program delay
-               of N CPU CLK cycles owing to pio asm instructions. */
-            pu8reg[i] = i32wc - PIOASM_DELAY_CYCLES;
-        }
+        return 0;
+    }
+
+    PioDCOGetFreqShiftMilliHertz(pdco, pt->_u64_base_millihz);
+    if(pdco->_i64_last_correction == pt->_i64_correction)
+    {
+        return 0;
+    }
 
-        dco_program_puts(pio, sm, preg32);
+    pt->_i64_correction = pdco->_i64_last_correction;
+    for(int i = 0; i < pt->_n; ++i)
+    {
+        pt->_i32_cycles[i] = PioDCOToneCycles(pdco, i);
+    }
+
+    if(pt->_ix >= 0)
+    {
+        PioDCOSetTone(pdco, pt->_ix);
     }
+
+    return 1;
 }
 
-/// @brief Sets DCO running mode.
+/// @brief Posts the ramp request to the worker.
 /// @param pdco Ptr to DCO context.
-/// @param emode Desired mode.
-/// @attention Not actual so far. User-independent freq. correction not impl'd yet. !FIXME!
-void PioDCOSetMode(PioDco *pdco, enum PioDcoMode emode)
+/// @param emode The ramp mode.
+/// @param i64start Cycles per PI less PIO delay at start, scaled by 2^56.
+/// @param i64stop Cycles per PI less PIO delay at stop, scaled by 2^56.
+/// @param ui32rate The mantissa of the rate, see PioDCORampRate.
+/// @param ui32shift Its negated exponent.
+static void PioDCORampPost(PioDco *pdco, enum PioDcoRampMode emode, int64_t i64start,
+                           int64_t i64stop, uint32_t ui32rate, uint32_t ui32shift)
+{
+    PioDcoRampRequest *pr = &pdco->_ctl._ramp;
+    const uint32_t ui32seq = pr->_ui32_seq;
+
+    pr->_ui32_seq = ui32seq + 1U;
+    __dmb();
+    pr->_mode = emode;
+    pr->_i64_start = i64start;
+    pr->_i64_stop = i64stop;
+    pr->_ui32_rate = ui32rate;
+    pr->_ui32_rate_shift = ui32shift;
+    __dmb();
+    pr->_ui32_seq = ui32seq + 2U;
+    PioDCOCtlNotify(&pdco->_ctl);
+}
+
+/// @brief Starts phase continuous linear ramp of DCO freq. The worker changes its
+/// @brief cycles per PI every PIO word by the increment of the cycles reached, see
+/// @brief PioDCORampDelta, so the freq. is linear in time over any span.
+/// @param pdco Ptr to DCO context.
+/// @param ui32_start_hz The freq. at start, Hz.
+/// @param ui32_stop_hz The freq. at stop, Hz.
+/// @param ui32_duration_ms The duration of sweep start to stop, ms.
+/// @param emode eDCORAMP_ONCE, eDCORAMP_REPEAT or eDCORAMP_TRIANGLE.
+/// @return 0 if OK. -1 invalid freq. or duration, or the ramp is that slow the
+/// @return increment of the highest freq. is below 2^-56 cycles.
+/// @attention Any freq. request posted to the mailbox afterwards cancels the ramp.
+int PioDCORampStart(PioDco *pdco, uint32_t ui32_start_hz, uint32_t ui32_stop_hz,
+                    uint32_t ui32_duration_ms, enum PioDcoRampMode emode)
 {
     assert_(pdco);
-    pdco->_mode = emode;
+    assert_(pdco->_clkfreq_hz);
 
-    switch(emode)
+    const uint32_t ui32min_hz = pdco->_clkfreq_hz >> 8;
+    if(ui32_start_hz <= ui32min_hz || ui32_stop_hz <= ui32min_hz
+       || ui32_start_hz == ui32_stop_hz || !ui32_duration_ms || eDCORAMP_OFF == emode)
     {
-        case eDCOMODE_IDLE:
-            PioDCOStop(pdco);
-            break;
+        return -1;
+    }
 
-        case eDCOMODE_GPS_COMPENSATED:
-            PioDCOStart(pdco);
-            break;
+    const int64_t i64start = (int64_t)(PioDCOModCyclesPerPi(pdco->_clkfreq_hz, ui32_start_hz, 0)
+                                       - (PIOASM_DELAY_CYCLES<<24)) << 32;
+    const int64_t i64stop = (int64_t)(PioDCOModCyclesPerPi(pdco->_clkfreq_hz, ui32_stop_hz, 0)
+                                      - (PIOASM_DELAY_CYCLES<<24)) << 32;
 
-        default:
-            break;
+    uint32_t ui32rate, ui32shift;
+    const uint32_t ui32span_hz = ui32_start_hz > ui32_stop_hz ? ui32_start_hz - ui32_stop_hz
+                                                              : ui32_stop_hz - ui32_start_hz;
+    if(PioDCORampRate(pdco->_clkfreq_hz, ui32span_hz, ui32_duration_ms, &ui32rate, &ui32shift)
+       || !PioDCORampDelta(i64start < i64stop ? i64start : i64stop, ui32rate, ui32shift,
+                           i64stop > i64start))
+    {
+        return -1;
     }
+
+    pdco->_gpsdo._u64_cycles = 0;
+    pdco->_tones._ix = -1;
+    PioDCORampPost(pdco, emode, i64start, i64stop, ui32rate, ui32shift);
+
+    pdco->_ui32_frq_hz = ui32_start_hz;
+    pdco->_ui32_frq_millihz = 0;
+    pdco->_harmonic = 1;
+
+    return 0;
+}
+
+/// @brief Stops the ramp, DCO stays at the freq. reached.
+/// @param pdco Ptr to DCO context.
+void PioDCORampStop(PioDco *pdco)
+{
+    assert_(pdco);
+    PioDCORampPost(pdco, eDCORAMP_OFF, 0, 0, 0, 0);
+}
+
+/// @brief Commands the phase step of N/2^k turns (cycles of output), positive is
+/// @brief advance. The worker applies it at the next word boundary by changing
+/// @brief the duration of one word, the freq. & its error feedback are intact.
+/// @brief Near the lowest freq. a retard which does not fit the 32-bit count of
+/// @brief word is split over the next words, 3/128 turn at least per word.
+/// @param pdco Ptr to DCO context.
+/// @param i32n N, e.g. 1 with k = 1 for 180 deg.
+/// @param k The power of 2 of denominator, 0...32.
+/// @return The phase offset commanded, 2^32 per turn.
+/// @attention The steps commanded ere the worker has applied them are summed.
+uint32_t PioDCOPhaseStep(PioDco *pdco, int32_t i32n, int k)
+{
+    assert_(pdco);
+    assert_(k >= 0 && k <= 32);
+
+    const uint32_t ui32step = (uint32_t)((uint64_t)(uint32_t)i32n << (32 - k));
+    pdco->_ctl._ui32_phase_req += ui32step;
+    PioDCOCtlNotify(&pdco->_ctl);
+
+    return pdco->_ctl._ui32_phase_req;
+}
+
+/// @brief Obtains the phase offset applied by the worker so far, that is the phase
+/// @brief of output relative to free running DCO of the same freq. history.
+/// @param pdco Ptr to DCO context.
+/// @return The phase offset applied, 2^32 per turn.
+uint32_t PioDCOGetPhase(const PioDco *pdco)
+{
+    assert_(pdco);
+
+    return pdco->_ctl._ui32_phase_applied;
+}
+
+/// @brief Starts the measurement of output freq. over the gate. The edges of output
+/// @brief are counted by `dco_count` on a spare PIO state machine, which is claimed
+/// @brief on the first call and kept. The gate is exact number of CPU CLK cycles.
+/// @param pdco Ptr to DCO context.
+/// @param ui32gate_ms The gate, ms.
+/// @return 0 if OK. -1 no free state machine, invalid gate or the gate in progress.
+/// @attention The result is obtained by PioDCOMeasureResult.
+int PioDCOMeasureStart(PioDco *pdco, uint32_t ui32gate_ms)
+{
+    assert_(pdco);
+
+    const uint32_t ui32samples = PioDCOMeasGateSamples(pdco->_clkfreq_hz, ui32gate_ms);
+    if(!ui32samples || pdco->_ui32_meas_samples)
+    {
+        return -1;
+    }
+
+    if(pdco->_meas_ism < 0)
+    {
+        int offset;
+        if(PioDCOClaimAnySM(&dco_count_program, siDcoCountOffset,
+                            &pdco->_meas_pio, &pdco->_meas_ism, &offset))
+        {
+            return -1;
+        }
+        dco_count_program_init(pdco->_meas_pio, pdco->_meas_ism, offset, pdco->_gpio);
+    }
+
+    pdco->_ui32_meas_samples = ui32samples;
+    pio_sm_put(pdco->_meas_pio, pdco->_meas_ism, ui32samples);
+
+    return 0;
+}
+
+/// @brief Obtains the result of the measurement started by PioDCOMeasureStart. If GPS
+/// @brief is on, its measured CPU CLK error corrects the gate.
+/// @param pdco Ptr to DCO context.
+/// @param pmeas Ptr to the result.
+/// @return 0 if OK. 1 the gate is still open. -1 no measurement started.
+int PioDCOMeasureResult(PioDco *pdco, PioDcoMeas *pmeas)
+{
+    assert_(pdco);
+    assert_(pmeas);
+
+    if(pdco->_meas_ism < 0 || !pdco->_ui32_meas_samples)
+    {
+        return -1;
+    }
+
+    if(pio_sm_is_rx_fifo_empty(pdco->_meas_pio, pdco->_meas_ism))
+    {
+        return 1;
+    }
+
+    const uint32_t ui32edges = pio_sm_get(pdco->_meas_pio, pdco->_meas_ism);
+    const int64_t i64ppb = pdco->_pGPStime ? pdco->_pGPStime->_time_data._i32_freq_shift_ppb : 0;
+    const uint64_t u64cmd = 1000ULL * pdco->_ui32_frq_hz + (int64_t)pdco->_ui32_frq_millihz;
+
+    PioDCOMeasResult(pdco->_clkfreq_hz, pdco->_ui32_meas_samples, ui32edges, i64ppb, u64cmd, pmeas);
+    pdco->_ui32_meas_samples = 0;
+
+    return 0;
+}
+
+/// @brief Starts the DCO.
+/// @param pdco Ptr to DCO context.
+void PioDCOStart(PioDco *pdco)
+{
+    assert_(pdco);
+    pio_sm_set_enabled(pdco->_pio, pdco->_ism, true);
+
+    pdco->_is_enabled = YES;
+}
+
+/// @brief Stops the DCO.
+/// @param pdco Ptr to DCO context.
+void PioDCOStop(PioDco *pdco)
+{
+    assert_(pdco);
+    pio_sm_set_enabled(pdco->_pio, pdco->_ism, false);
+
+    pdco->_is_enabled = NO;
+}
+
+#if DCO_TELEMETRY
+/// @brief The sink of PioDCOWorker2 which times the loop, see PioDcoStats: the
+/// @brief time since the last store is taken ere the wait for FIFO room, the next
+/// @brief one starts after it.
+/// @param pctx Ptr to PioDcoFifo.
+/// @param ui32wc The cycle count.
+DCO_INLINE void PioDCOPutFifoTimed(void *pctx, uint32_t ui32wc)
+{
+    PioDcoFifo *pf = (PioDcoFifo *)pctx;
+    PioDCOStatsWord(pf->_pstats, (pf->_ui32_t0 - systick_hw->cvr) & 0xFFFFFFU);
+    while(pio_sm_is_tx_fifo_full(pf->_pio, pf->_sm))
+    {
+        tight_loop_contents();
+    }
+    pf->_ui32_t0 = systick_hw->cvr;
+    pf->_pio->txf[pf->_sm] = ui32wc;
+}
+#endif
+
+/// @brief Main worker task of DCO V.2. It is time critical, so it ought to be run on
+/// @brief the dedicated pi pico core. The steady loop of the first order modulator
+/// @brief costs the baseline loop plus a compare per word, see dcowork.h.
+/// @param pDCO Ptr to DCO context.
+/// @return No return. It spins forever.
+/// @attention The word of the top freq. (CPU CLK / 8) lasts 16 CPU CLK cycles, so
+/// @attention does the budget of loop. MASH 1-1-1 & high resolution loops and the
+/// @attention generic one of ramps & phase steps take more, so their top freqs.
+/// @attention are lower, see README for the estimates & PioDCOBench for the real ones.
+/// @attention Once it runs, _is_in_ram is set: the flash writes needn't park its core.
+void RAM (PioDCOWorker2)(PioDco *pDCO)
+{
+    PioDcoWork work = {0};
+    PioDcoFifo fifo = { pDCO->_pio, pDCO->_ism, &pDCO->_stats, 0 };
+
+    pDCO->_u64_tick0_us = time_us_64();
+
+    /* RPix: PIO has been stalled until the first word, it isn't an underrun. */
+    PioDCORun(&pDCO->_ctl, &work, 1, PioDCOPutFifo, &fifo);
+    PioDCOClearStall(pDCO);
+
+    /* RPix: From here on the loop is all inline in RAM, no XIP is touched. */
+    pDCO->_is_in_ram = 1;
+
+#if DCO_TELEMETRY
+    /* RPix: SysTick of this core counts CPU CLK down, 24 bits. */
+    systick_hw->rvr = 0xFFFFFFU;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5U;
+    fifo._ui32_t0 = systick_hw->cvr;
+
+LOOP:
+    PioDCORun(&pDCO->_ctl, &work, eDCOWorkMaxBatch, PioDCOPutFifoTimed, &fifo);
+#else
+LOOP:
+    PioDCORun(&pDCO->_ctl, &work, eDCOWorkMaxBatch, PioDCOPutFifo, &fifo);
+#endif
+
+    goto LOOP;
+}
+
+/// @brief The sink of the bench: FIFO status is polled as put_blocking does, the
+/// @brief word goes nowhere.
+/// @param pctx Ptr to PioDcoFifo.
+/// @param ui32wc The cycle count.
+DCO_INLINE void PioDCOPutBench(void *pctx, uint32_t ui32wc)
+{
+    PioDcoFifo *pf = (PioDcoFifo *)pctx;
+    if(pio_sm_is_tx_fifo_full(pf->_pio, pf->_sm))
+    {
+        tight_loop_contents();
+    }
+    *(volatile uint32_t *)&pf->_ui32_t0 = ui32wc;
+}
+
+/// @brief Measures CPU CLK cycles per word of the worker loop given, running it on
+/// @brief the copy of DCO requests at the freq. in work. The outputs aren't affected.
+/// @param pdco Ptr to DCO context.
+/// @param eloop The loop to time; the generic one is timed running a ramp.
+/// @return CPU CLK cycles per word, scaled by 100.
+/// @attention It should be called on the core which is to run the worker, while the
+/// @attention other one is busy the result is pessimistic by the bus contention.
+uint32_t RAM (PioDCOBench)(PioDco *pdco, enum PioDcoLoop eloop)
+{
+    assert_(pdco);
+
+    static PioDcoCtl sctl;
+    static PioDcoWork swork;
+
+    memcpy(&sctl, &pdco->_ctl, sizeof(PioDcoCtl));
+    memset(&swork, 0, sizeof(PioDcoWork));
+    sctl._evq._ui32_tail = sctl._evq._ui32_head;
+    sctl._ui32_phase_req = 0;
+    sctl._ramp._ui32_seq = 0;
+    sctl._modulator = eDCOLOOP_MASH111 == eloop ? eDCOMOD_MASH111
+                    : eDCOLOOP_HIRES == eloop ? eDCOMOD_HIRES : eDCOMOD_FIRST_ORDER;
+    if(eDCOLOOP_GENERIC == eloop)
+    {
+        /* RPix: The ramp which never ends, 1 kHz per second. */
+        const int64_t i64start = (int64_t)(pdco->_frq_cycles_per_pi
+                                 - (PIOASM_DELAY_CYCLES<<24)) << 32;
+        uint32_t ui32rate = 0, ui32shift = 0;
+        PioDCORampRate(pdco->_clkfreq_hz, 1000, 1000, &ui32rate, &ui32shift);
+        sctl._ramp._mode = eDCORAMP_REPEAT;
+        sctl._ramp._i64_start = i64start;
+        sctl._ramp._i64_stop = i64start + (1LL << 40);
+        sctl._ramp._ui32_rate = ui32rate;
+        sctl._ramp._ui32_rate_shift = ui32shift;
+        sctl._ramp._ui32_seq = 2;
+    }
+
+    PioDcoFifo fifo = { pdco->_pio, pdco->_ism, NULL, 0 };
+    PioDCORun(&sctl, &swork, 1, PioDCOPutBench, &fifo);
+
+    const uint32_t ui32irq = save_and_disable_interrupts();
+    const uint64_t tm0 = time_us_64();
+    for(uint32_t n = 0; n < eDCOBenchWords; )
+    {
+        n += PioDCORun(&sctl, &swork, eDCOBenchWords - n, PioDCOPutBench, &fifo);
+    }
+    const uint64_t dt = time_us_64() - tm0;
+    restore_interrupts(ui32irq);
+
+    return (uint32_t)(dt * pdco->_clkfreq_hz / (10000ULL * eDCOBenchWords));
+}
+
+/// @brief Main worker task of duty cycle variant of DCO. Every level of output
+/// @brief has its own error feedback loop, so both freq. & duty cycle are precise.
+/// @param pDCO Ptr to DCO context, initialized by PioDCOInitDuty.
+/// @return No return. It spins forever.
+/// @attention Mailbox requests are served; the events, ramps & phase steps aren't.
+void RAM (PioDCOWorkerDuty)(PioDco *pDCO)
+{
+    register PIO pio = pDCO->_pio;
+    register uint sm = pDCO->_ism;
+    PioDcoWork work = {0};
+    int32_t i32acch = 0, i32accl = 0;
+    uint32_t ui32regh = 0, ui32regl = 0;
+
+    pDCO->_u64_tick0_us = time_us_64();
+    work._ui32_ctl_seq = ~pDCO->_ctl._ui32_seq;     /* Fetch the requests ere the first word. */
+
+LOOP:
+    if(work._ui32_ctl_seq != pDCO->_ctl._ui32_seq)
+    {
+        work._ui32_ctl_seq = pDCO->_ctl._ui32_seq;
+        __dmb();
+        PioDCOMailboxFetch(&pDCO->_ctl._mbox, &work);
+
+        PioDCOModDutySplit(work._i32_cycles + (PIOASM_DELAY_CYCLES<<24), pDCO->_ui32_duty_q16,
+                           PIOASM_DUTY_DELAY_CYCLES, &ui32regh, &ui32regl);
+    }
+
+    ++work._ui32_word;
+    pio_sm_put_blocking(pio, sm, PioDCOModDutyWord(ui32regh, ui32regl, &i32acch, &i32accl));
+
+    goto LOOP;
+}
+
+/// @brief Refills one half of DMA double buffer by the next batch of cycle counts.
+/// @param pdco Ptr to DCO context.
+/// @param ix Index of the half, 0 or 1.
+/// @attention The batch is computed ahead of output by up to two halves, so the
+/// @attention frequency request posted meanwhile takes effect that late; the
+/// @attention time tagged events are applied at their ticks as the worker does.
+void RAM (PioDCOFillHalf)(PioDco *pdco, int ix)
+{
+    PioDCORender(&pdco->_ctl, &pdco->_work, pdco->_ui32_dmabuf[ix], eDCODmaHalfLen);
+}
+
+/// @brief DMA IRQ handler. Rewinds the channel of the half buffer which has been
+/// @brief drained, so it is retriggered by the chain from the start, then refills
+/// @brief the half. The refill which ends after the other half has drained is late,
+/// @brief the channel may have sent some words of the previous batch; it's counted.
+static void RAM (PioDCODmaIrqHandler)(void)
+{
+    uint32_t ui32ints = dma_hw->ints1;
+    while(ui32ints)
+    {
+        const uint ch = __builtin_ctz(ui32ints);
+        ui32ints &= ui32ints - 1;
+
+        PioDco *pdco = spDmaOwner[ch];
+        if(!pdco)
+        {
+            continue;
+        }
+
+        dma_irqn_acknowledge_channel(1, ch);
+
+        const int ix = (ch == (uint)pdco->_dma_chan[0]) ? 0 : 1;
+        dma_channel_set_read_addr(ch, pdco->_ui32_dmabuf[ix], false);
+        PioDCOFillHalf(pdco, ix);
+        if(!dma_channel_is_busy(pdco->_dma_chan[ix ^ 1]))
+        {
+            ++pdco->_stats._ui32_dma_late;
+        }
+    }
+}
+
+/// @brief Starts DMA fed engine of DCO. Two chained DMA channels paced by PIO TX DREQ
+/// @brief drain the halves of double buffer in turn, the drained half is refilled by
+/// @brief DMA_IRQ_1 handler. It replaces PioDCOWorker2, so the core is free otherwise.
+/// @param pdco Ptr to DCO context.
+/// @return 0 if OK. -1 no free DMA channels. -2 the freq. is above CLK/16.
+/// @attention It should be called on the core which is to serve DMA IRQ. A half is
+/// @attention refilled while the other one drains, so the render of a word has one
+/// @attention word of output time. At CLK/16 (~16.9 MHz at 270 MHz) it is 32 CPU CLK,
+/// @attention twice the budget of PioDCOWorker2, the rest covers the IRQ latency. The
+/// @attention freq. posted later isn't checked, a late refill is counted instead.
+int PioDCOStartDMA(PioDco *pdco)
+{
+    assert_(pdco);
+    assert_(pdco->_dma_chan[0] < 0);
+
+    if((pdco->_frq_cycles_per_pi >> 24) < eDCODmaMinCycles)
+    {
+        return -2;
+    }
+
+    const int ch0 = dma_claim_unused_channel(false);
+    const int ch1 = ch0 < 0 ? -1 : dma_claim_unused_channel(false);
+    if(ch1 < 0)
+    {
+        if(ch0 >= 0)
+        {
+            dma_channel_unclaim(ch0);
+        }
+        return -1;
+    }
+
+    static bool bhandler_installed = false;
+    if(!bhandler_installed)
+    {
+        irq_add_shared_handler(DMA_IRQ_1, PioDCODmaIrqHandler,
+                               PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        bhandler_installed = true;
+    }
+
+    memset(&pdco->_work, 0, sizeof(pdco->_work));
+    pdco->_u64_tick0_us = time_us_64();
+    pdco->_dma_chan[0] = ch0;
+    pdco->_dma_chan[1] = ch1;
+    for(int i = 0; i < 2; ++i)
+    {
+        spDmaOwner[pdco->_dma_chan[i]] = pdco;
+        PioDCOFillHalf(pdco, i);
+    }
+
+    for(int i = 0; i < 2; ++i)
+    {
+        const uint ch = pdco->_dma_chan[i];
+        dma_channel_config c = dma_channel_get_default_config(ch);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+        channel_config_set_read_increment(&c, true);
+        channel_config_set_write_increment(&c, false);
+        channel_config_set_dreq(&c, pio_get_dreq(pdco->_pio, pdco->_ism, true));
+        channel_config_set_chain_to(&c, pdco->_dma_chan[i ^ 1]);
+
+        dma_channel_configure(ch, &c, &pdco->_pio->txf[pdco->_ism],
+                              pdco->_ui32_dmabuf[i], eDCODmaHalfLen, false);
+        dma_irqn_set_channel_enabled(1, ch, true);
+    }
+
+    irq_set_enabled(DMA_IRQ_1, true);
+    dma_channel_start(pdco->_dma_chan[0]);
+    PioDCOClearStall(pdco);
+
+    return 0;
+}
+
+/// @brief Stops DMA fed engine of DCO and releases its DMA channels.
+/// @param pdco Ptr to DCO context.
+void PioDCOStopDMA(PioDco *pdco)
+{
+    assert_(pdco);
+
+    for(int i = 0; i < 2; ++i)
+    {
+        const int ch = pdco->_dma_chan[i];
+        if(ch < 0)
+        {
+            continue;
+        }
+
+        dma_irqn_set_channel_enabled(1, ch, false);
+        dma_channel_config c = dma_get_channel_config(ch);
+        channel_config_set_chain_to(&c, ch);    /* Break the chain. */
+        dma_channel_set_config(ch, &c, false);
+        dma_channel_abort(ch);
+        dma_irqn_acknowledge_channel(1, ch);
+
+        spDmaOwner[ch] = NULL;
+        dma_channel_unclaim(ch);
+        pdco->_dma_chan[i] = -1;
+    }
+}
+
+/// @brief Polls the sticky TX stall flag of DCO state machine, that is PIO has met
+/// @brief the empty FIFO since the last poll, so the output has glitched. It costs
+/// @brief the worker nothing. The flag doesn't count, so neither does the poll: it
+/// @brief counts the intervals betwixt polls which had one stall or more.
+/// @param pdco Ptr to DCO context.
+/// @return The count of stalled intervals seen so far.
+/// @attention It should be called by the same core, not by the worker one. The
+/// @attention interval is the poll period, e.g. ~16 ms of the main loop of test.c.
+uint32_t PioDCOStatsPoll(PioDco *pdco)
+{
+    assert_(pdco);
+
+    const uint32_t ui32mask = 1U << (PIO_FDEBUG_TXSTALL_LSB + pdco->_ism);
+    if(pdco->_is_enabled && (pdco->_pio->fdebug & ui32mask))
+    {
+        pdco->_pio->fdebug = ui32mask;
+        ++pdco->_stats._ui32_stalled_polls;
+    }
+
+    return pdco->_stats._ui32_stalled_polls;
+}
+
+/// @brief Tops FIFO up by the worker loops while the replay is being prepared.
+/// @param pdco Ptr to DCO context.
+/// @param pfifo Ptr to the sink of worker, NULL if DMA feeds FIFO.
+/// @param ui32seq The mailbox request the preparation is of.
+/// @return 0 if OK. -1 a new request has been fetched, the preparation is stale.
+static int RAM (PioDCOReplayFeed)(PioDco *pdco, PioDcoFifo *pfifo, uint32_t ui32seq)
+{
+    if(pfifo)
+    {
+        const uint32_t ui32room = eDCOFifoLen - pio_sm_get_tx_fifo_level(pdco->_pio, pdco->_ism);
+        if(ui32room)
+        {
+            PioDCORun(&pdco->_ctl, &pdco->_work, ui32room, PioDCOPutFifoNow, pfifo);
+        }
+    }
+
+    return ui32seq == pdco->_work._ui32_seq ? 0 : -1;
+}
+
+/// @brief Plans the replay of the request in work. The freq. given in Hz & mHz is
+/// @brief rendered exact, its period is the denominator of the reduced ratio of CPU
+/// @brief CLK to freq.; the other requests use the period of the binary fraction of
+/// @brief their cycles per PI. A short period is repeated up to eDCOReplayMinWords,
+/// @brief so the replay has the room to be switched to another one.
+/// @param pdco Ptr to DCO context.
+/// @param pplan Ptr to the plan.
+/// @param pfifo Ptr to the sink of worker which is topped up betwixt the 64-bit
+/// @param pfifo divisions, each one is shorter than FIFO; NULL if DMA feeds FIFO.
+/// @return The words to replay. 0 the period is longer than eDCOReplayMaxWords, GPS
+/// @return compensation is on (it reposts the corrected cycles every second, they
+/// @return have no short period) or a new request has been fetched meanwhile.
+static uint32_t RAM (PioDCOReplayPlanOf)(PioDco *pdco, PioDcoReplayPlan *pplan,
+                                         PioDcoFifo *pfifo)
+{
+    const PioDcoWork *pw = &pdco->_work;
+    const uint32_t ui32seq = pw->_ui32_seq;
+    *pplan = (PioDcoReplayPlan){0};
+
+    if(eDCOMODE_GPS_COMPENSATED == pdco->_mode)
+    {
+        return 0;
+    }
+
+    if(pw->_ui32_frq_hz)
+    {
+        const uint64_t u64num = (uint64_t)pdco->_clkfreq_hz * 1000ULL;
+        const uint64_t u64den = 2000ULL * pw->_ui32_frq_hz + 2LL * pw->_i32_frq_millihz;
+        uint64_t u64a = u64num, u64b = u64den;
+        while(u64b)
+        {
+            const uint64_t u64r = u64a % u64b;
+            u64a = u64b;
+            u64b = u64r;
+            if(PioDCOReplayFeed(pdco, pfifo, ui32seq))
+            {
+                return 0;
+            }
+        }
+
+        const uint64_t u64period = u64den / u64a;
+        if(u64period > eDCOReplayMaxWords || PioDCOReplayFeed(pdco, pfifo, ui32seq))
+        {
+            return 0;
+        }
+
+        /* RPix: num / den = num' / den', the remainders scale by the gcd. */
+        pplan->_ui32_period = pplan->_ui32_den = (uint32_t)u64period;
+        pplan->_ui32_wc = (uint32_t)(u64num / u64den) - PIOASM_DELAY_CYCLES;
+        if(PioDCOReplayFeed(pdco, pfifo, ui32seq))
+        {
+            return 0;
+        }
+        pplan->_ui32_rem = (uint32_t)((u64num % u64den) / u64a);
+    }
+    else
+    {
+        pplan->_ui32_reg = pw->_i32_cycles;
+        pplan->_ui32_ext = eDCOMOD_HIRES == pdco->_ctl._modulator ? pw->_ui32_cycles_ext : 0;
+        const int ilog2 = PioDCOModPeriodLog2(pplan->_ui32_reg, pplan->_ui32_ext);
+        if((1ULL << ilog2) > eDCOReplayMaxWords)
+        {
+            return 0;
+        }
+        pplan->_ui32_period = 1U << ilog2;
+    }
+
+    const uint32_t ui32reps = (eDCOReplayMinWords + pplan->_ui32_period - 1) / pplan->_ui32_period;
+    pplan->_ui32_len = pplan->_ui32_period * ui32reps;
+
+    return PioDCOReplayFeed(pdco, pfifo, ui32seq) ? 0 : pplan->_ui32_len;
+}
+
+/// @brief Renders the words from...to-1 of the words planned to replay.
+/// @param pplan Ptr to the plan.
+/// @param pui32dst Ptr to the buffer of eDCOReplayMaxWords.
+/// @param ui32from The first word to render.
+/// @param ui32to The word past the last one to render.
+static void RAM (PioDCOReplayRender)(const PioDcoReplayPlan *pplan, uint32_t *pui32dst,
+                                     uint32_t ui32from, uint32_t ui32to)
+{
+    const uint32_t ui32end = ui32to < pplan->_ui32_period ? ui32to : pplan->_ui32_period;
+    if(ui32from < ui32end)
+    {
+        if(pplan->_ui32_den)
+        {
+            PioDCOModRenderRationalAt(pplan->_ui32_wc, pplan->_ui32_rem, pplan->_ui32_den,
+                                      pui32dst, ui32from, ui32end);
+        }
+        else
+        {
+            PioDCOModRenderAt(pplan->_ui32_reg, pplan->_ui32_ext, pui32dst, ui32from, ui32end);
+        }
+        ui32from = ui32end;
+    }
+
+    /* RPix: The repeats of the period. */
+    for(uint32_t i = ui32from; i < ui32to; ++i)
+    {
+        pui32dst[i] = pui32dst[i - pplan->_ui32_period];
+    }
+}
+
+/// @brief Renders the words planned to replay a FIFO worth at a time, the worker
+/// @brief tops FIFO up betwixt them, so the output runs on meanwhile.
+/// @param pdco Ptr to DCO context.
+/// @param pplan Ptr to the plan.
+/// @param pui32dst Ptr to the buffer of eDCOReplayMaxWords.
+/// @param pfifo Ptr to the sink of worker.
+/// @return 0 if rendered, FIFO has been topped up last. -1 a new request has been
+/// @return fetched meanwhile, the plan is stale.
+static int RAM (PioDCOReplayRenderFed)(PioDco *pdco, const PioDcoReplayPlan *pplan,
+                                       uint32_t *pui32dst, PioDcoFifo *pfifo)
+{
+    const uint32_t ui32seq = pdco->_work._ui32_seq;
+    for(uint32_t i = 0; i < pplan->_ui32_len; i += eDCOFifoLen)
+    {
+        const uint32_t ui32to = i + eDCOFifoLen;
+        PioDCOReplayRender(pplan, pui32dst, i, ui32to < pplan->_ui32_len ? ui32to : pplan->_ui32_len);
+        if(PioDCOReplayFeed(pdco, pfifo, ui32seq))
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/// @brief Claims the DMA channels of replay, the buffers are used by the DCO since.
+/// @param pdco Ptr to DCO context.
+/// @return 0 if OK. -1 the buffers are in use or no free DMA channels.
+static int PioDCOReplayClaim(PioDco *pdco)
+{
+    if(spReplayOwner)
+    {
+        return -1;
+    }
+
+    const int ch0 = dma_claim_unused_channel(false);
+    const int ch1 = ch0 < 0 ? -1 : dma_claim_unused_channel(false);
+    if(ch1 < 0)
+    {
+        if(ch0 >= 0)
+        {
+            dma_channel_unclaim(ch0);
+        }
+        return -1;
+    }
+
+    spReplayOwner = pdco;
+    pdco->_replay_chan[0] = ch0;
+    pdco->_replay_chan[1] = ch1;
+    pdco->_ui32_replay_len = 0;
+
+    return 0;
+}
+
+/// @brief Releases the DMA channels of replay and its buffers.
+/// @param pdco Ptr to DCO context.
+static void PioDCOReplayRelease(PioDco *pdco)
+{
+    for(int i = 0; i < 2; ++i)
+    {
+        dma_channel_unclaim(pdco->_replay_chan[i]);
+        pdco->_replay_chan[i] = -1;
+    }
+
+    spReplayOwner = NULL;
+}
+
+/// @brief The config of replay data channel: paced by PIO TX DREQ, chained to the
+/// @brief channel given.
+/// @param pdco Ptr to DCO context.
+/// @param chain The channel to chain to, the data one itself to break the chain.
+/// @return The config.
+static inline dma_channel_config PioDCOReplayDataConfig(const PioDco *pdco, uint chain)
+{
+    dma_channel_config c = dma_channel_get_default_config(pdco->_replay_chan[0]);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(pdco->_pio, pdco->_ism, true));
+    channel_config_set_chain_to(&c, chain);
+
+    return c;
+}
+
+/// @brief Starts to loop the words rendered by the DMA channels claimed. It uses no
+/// @brief flash code, so it takes over from the worker within the time of FIFO.
+/// @param pdco Ptr to DCO context.
+/// @param ix The index of replay buffer.
+/// @param ui32len The words to loop.
+static void RAM (PioDCOReplayLoop)(PioDco *pdco, int ix, uint32_t ui32len)
+{
+    const uint ch0 = pdco->_replay_chan[0];
+    const uint ch1 = pdco->_replay_chan[1];
+    pdco->_ui32_replay_len = ui32len;
+    pdco->_pui32_replay = sui32ReplayBuf[ix];
+
+    /* RPix: The control channel writes the start of period to the read address
+       trigger alias of data channel, which restarts it with the count reloaded. */
+    dma_channel_config c = dma_channel_get_default_config(ch1);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, false);
+    dma_channel_configure(ch1, &c, &dma_hw->ch[ch0].al3_read_addr_trig,
+                          &pdco->_pui32_replay, 1, false);
+
+    c = PioDCOReplayDataConfig(pdco, ch1);
+    dma_channel_configure(ch0, &c, &pdco->_pio->txf[pdco->_ism],
+                          sui32ReplayBuf[ix], ui32len, true);
+}
+
+/// @brief Lets the period replayed end and the DMA channels stop, so the output
+/// @brief isn't cut in the middle of a word. The channels stay claimed.
+/// @param pdco Ptr to DCO context.
+/// @attention FIFO holds the last words of the period on return, the caller has
+/// @attention their output time to feed it on.
+static void RAM (PioDCOReplayEnd)(PioDco *pdco)
+{
+    /* RPix: Break the chain, so the data channel isn't restarted. The control one
+       might restart it right now, then the period is replayed once more. */
+    const uint ch0 = pdco->_replay_chan[0];
+    const uint ch1 = pdco->_replay_chan[1];
+    const dma_channel_config c = PioDCOReplayDataConfig(pdco, ch0);
+    dma_channel_set_config(ch0, &c, false);
+    while(dma_channel_is_busy(ch1) || dma_channel_is_busy(ch0))
+    {
+        tight_loop_contents();
+    }
+
+    pdco->_ui32_replay_len = 0;
+}
+
+/// @brief Switches the replay to the words rendered to the other buffer. They are
+/// @brief set up as the next period while the one replayed has words to go, so the
+/// @brief control channel restarts the data one with them at the end of period.
+/// @param pdco Ptr to DCO context.
+/// @param ix The index of replay buffer.
+/// @param ui32len The words to loop.
+static void RAM (PioDCOReplaySwitch)(PioDco *pdco, int ix, uint32_t ui32len)
+{
+    const uint ch0 = pdco->_replay_chan[0];
+    for(;;)
+    {
+        const uint32_t ui32irq = save_and_disable_interrupts();
+        if(dma_hw->ch[ch0].transfer_count > eDCOReplaySwitchWords)
+        {
+            pdco->_pui32_replay = sui32ReplayBuf[ix];
+            __dmb();
+            dma_channel_set_trans_count(ch0, ui32len, false);
+            restore_interrupts(ui32irq);
+            break;
+        }
+        restore_interrupts(ui32irq);
+    }
+
+    pdco->_ui32_replay_len = ui32len;
+}
+
+/// @brief Starts replay engine of DCO. The request posted last is fetched from the
+/// @brief mailbox and the period of its cycle count sequence is rendered once, then
+/// @brief it is looped by two DMA channels: the data one paced by PIO TX DREQ and the
+/// @brief control one which rewinds it, so the static carrier costs no CPU. See
+/// @brief PioDCOReplayPlanOf for the period.
+/// @param pdco Ptr to DCO context.
+/// @return 0 if OK. -1 the period is longer than eDCOReplayMaxWords, GPS compensation
+/// @return is on, the buffers are in use or no free DMA channels; the worker should be
+/// @return run instead.
+/// @attention The ramps, events & phase steps are not served while replaying. MASH
+/// @attention is replaced by the first order sequence of the same freq.
+int PioDCOStartReplay(PioDco *pdco)
+{
+    assert_(pdco);
+    assert_(pdco->_replay_chan[0] < 0);
+
+    /* RPix: The producer might be in the middle of a request, it is short. */
+    PioDcoWork *pw = &pdco->_work;
+    while(pw->_ui32_seq != pdco->_ctl._mbox._ui32_seq)
+    {
+        PioDCOMailboxFetch(&pdco->_ctl._mbox, pw);
+    }
+
+    PioDcoReplayPlan plan;
+    if(!PioDCOReplayPlanOf(pdco, &plan, NULL) || PioDCOReplayClaim(pdco))
+    {
+        return -1;
+    }
+
+    PioDCOReplayRender(&plan, sui32ReplayBuf[0], 0, plan._ui32_len);
+    PioDCOReplayLoop(pdco, 0, plan._ui32_len);
+    PioDCOClearStall(pdco);
+
+    return 0;
+}
+
+/// @brief Stops replay engine of DCO and releases its DMA channels. The period
+/// @brief replayed is let end, so the output isn't cut in the middle of a word.
+/// @param pdco Ptr to DCO context.
+void PioDCOStopReplay(PioDco *pdco)
+{
+    assert_(pdco);
+
+    if(pdco->_replay_chan[0] < 0)
+    {
+        return;
+    }
+
+    PioDCOReplayEnd(pdco);
+    PioDCOReplayRelease(pdco);
+}
+
+/// @brief Keeps the replay on. A new request is rendered to the other buffer while
+/// @brief the period goes on, a repost of the same words is dropped, the other ones
+/// @brief are switched to at the end of period. Any request wakes it, so the change
+/// @brief of modulator counts as well.
+/// @param pdco Ptr to DCO context.
+/// @attention It returns once the request fetched can't be replayed, the replay has
+/// @attention been ended then and FIFO is to be fed at once.
+static void RAM (PioDCOReplayHold)(PioDco *pdco)
+{
+    PioDcoWork *pw = &pdco->_work;
+    uint32_t ui32ctl_seq = pw->_ui32_ctl_seq;
+    for(;;)
+    {
+        while(ui32ctl_seq == pdco->_ctl._ui32_seq)
+        {
+            sleep_us(100);
+        }
+        ui32ctl_seq = pdco->_ctl._ui32_seq;
+        while(pw->_ui32_seq != pdco->_ctl._mbox._ui32_seq)
+        {
+            PioDCOMailboxFetch(&pdco->_ctl._mbox, pw);
+        }
+
+        PioDcoReplayPlan plan;
+        if(!PioDCOReplayPlanOf(pdco, &plan, NULL))
+        {
+            PioDCOReplayEnd(pdco);
+            return;
+        }
+
+        const int ix = pdco->_pui32_replay == sui32ReplayBuf[0] ? 1 : 0;
+        PioDCOReplayRender(&plan, sui32ReplayBuf[ix], 0, plan._ui32_len);
+        if(plan._ui32_len == pdco->_ui32_replay_len
+           && !memcmp(sui32ReplayBuf[ix], pdco->_pui32_replay, plan._ui32_len * sizeof(uint32_t)))
+        {
+            continue;
+        }
+
+        PioDCOReplaySwitch(pdco, ix, plan._ui32_len);
+    }
+}
+
+/// @brief Worker task which replays the period of cycle counts by DMA while the
+/// @brief request allows and runs the worker loops otherwise. The worker feeds FIFO
+/// @brief while the period of a new request is planned & rendered, then DMA takes
+/// @brief over with FIFO full; a request which can't be replayed is tried again on
+/// @brief the next one. Once the replay runs, see PioDCOReplayHold.
+/// @param pDCO Ptr to DCO context.
+/// @return No return. It spins forever.
+/// @attention The DMA channels are claimed once here, with none free it is just the
+/// @attention worker.
+void RAM (PioDCOWorkerReplay)(PioDco *pDCO)
+{
+    assert_(pDCO);
+    assert_(pDCO->_replay_chan[0] < 0);
+
+    PioDcoWork *pw = &pDCO->_work;
+    PioDcoFifo fifo = { pDCO->_pio, pDCO->_ism, &pDCO->_stats, 0 };
+    memset(pw, 0, sizeof(PioDcoWork));
+    pDCO->_u64_tick0_us = time_us_64();
+    const bool bclaimed = !PioDCOReplayClaim(pDCO);
+
+    /* RPix: PIO has been stalled until the first word, it isn't an underrun. */
+    PioDCORun(&pDCO->_ctl, pw, 1, PioDCOPutFifo, &fifo);
+    PioDCOClearStall(pDCO);
+
+    for(;;)
+    {
+        const uint32_t ui32seq = pw->_ui32_seq;
+        PioDcoReplayPlan plan;
+        if(bclaimed && PioDCOReplayPlanOf(pDCO, &plan, &fifo)
+           && !PioDCOReplayRenderFed(pDCO, &plan, sui32ReplayBuf[0], &fifo))
+        {
+            PioDCOReplayLoop(pDCO, 0, plan._ui32_len);
+            PioDCOReplayHold(pDCO);
+            continue;
+        }
+
+        while(ui32seq == pw->_ui32_seq)
+        {
+            PioDCORun(&pDCO->_ctl, pw, eDCOWorkMaxBatch, PioDCOPutFifo, &fifo);
+        }
+    }
+}
+
+/// @brief Sets DCO running mode.
+/// @param pdco Ptr to DCO context.
+/// @param emode Desired mode.
+/// @attention In eDCOMODE_GPS_COMPENSATED the freq. of the setters is corrected by CPU
+/// @attention CLK error of GPS, see PioDCOGpsdoPoll. Leaving it drops the correction.
+void PioDCOSetMode(PioDco *pdco, enum PioDcoMode emode)
+{
+    assert_(pdco);
+
+    const enum PioDcoMode eprev = pdco->_mode;
+    pdco->_mode = emode;
+
+    if(eDCOMODE_GPS_COMPENSATED == eprev && eprev != emode)
+    {
+        PioDCOGpsdoReset(&pdco->_gpsdo, eDCOGPSDO_OFF);
+        if(pdco->_gpsdo._u64_cycles)
+        {
+            PioDCOPostGpsdo(pdco);  /* Back to the freq. as set. */
+        }
+    }
+
+    switch(emode)
+    {
+        case eDCOMODE_IDLE:
+            PioDCOStop(pdco);
+            break;
+
+        case eDCOMODE_RUNNING:
+            PioDCOStart(pdco);
+            break;
+
+        case eDCOMODE_GPS_COMPENSATED:
+            if(eprev != emode)
+            {
+                PioDCOGpsdoReset(&pdco->_gpsdo, eDCOGPSDO_WAIT);
+            }
+            PioDCOStart(pdco);
+            break;
+
+        default:
+            break;
+    }
+}
+
+/// @brief Updates GPSDO correction of CPU CLK error of GPS, once per PPS at most, and
+/// @brief reposts the freq. set & MFSK tones if it has changed. It's a no-op unless
+/// @brief in eDCOMODE_GPS_COMPENSATED. The on-chip temperature sensor is sampled to
+/// @brief its model of holdover once per PPS, or per eDCOGpsdoTempMs with no PPS.
+/// @brief With no GPS subsystem, the holdover of a warm start runs on.
+/// @param pdco Ptr to DCO context.
+/// @return GPSDO state.
+/// @attention It ought to be called periodically after GPStimeProcess by the core which
+/// @attention sets the freq.
+enum PioDcoGpsdoState PioDCOGpsdoPoll(PioDco *pdco)
+{
+    assert_(pdco);
+
+    PioDcoGpsdo *pg = &pdco->_gpsdo;
+    const GPStimeContext *pgps = pdco->_pGPStime;
+    if(eDCOMODE_GPS_COMPENSATED != pdco->_mode)
+    {
+        return pg->_state;
+    }
+
+    const uint64_t u64now = time_us_64();
+    const uint32_t ui32pps = pgps ? pgps->_time_data._u32_pps_count : pg->_ui32_pps_count;
+    if(ui32pps != pg->_ui32_pps_count || u64now - pg->_u64_temp_us >= eDCOGpsdoTempMs * 1000ULL)
+    {
+        if(!pg->_temp._ui32_samples)
+        {
+            adc_init();
+            adc_set_temp_sensor_enabled(true);
+        }
+        adc_select_input(ADC_TEMPERATURE_CHANNEL_NUM);
+        PioDCOTempSample(&pg->_temp, adc_read());
+        pg->_u64_temp_us = u64now;
+    }
+
+    const int is_valid = pgps && pgps->_pps_est._u8_is_valid && pgps->_time_data._u8_is_solution_active;
+    if(PioDCOGpsdoStep(pg, u64now, ui32pps, is_valid,
+                       pgps ? pgps->_time_data._i32_freq_shift_ppb : 0))
+    {
+        PioDCOGpsdoRepost(pdco);
+    }
+
+    return pg->_state;
+}
+
+/// @brief Applies GPSDO correction saved ere, see PioDCOGpsdoWarm.
+/// @param pdco Ptr to DCO context.
+/// @param i64ppb The correction saved, ppb.
+/// @param i32mdeg The temperature it was saved at, mC.
+/// @return 0 if OK. -1 not in eDCOMODE_GPS_COMPENSATED.
+int PioDCOGpsdoWarmStart(PioDco *pdco, int64_t i64ppb, int32_t i32mdeg)
+{
+    assert_(pdco);
+    if(eDCOMODE_GPS_COMPENSATED != pdco->_mode)
+    {
+        return -1;
+    }
+
+    PioDCOGpsdoWarm(&pdco->_gpsdo, time_us_64(), i64ppb, i32mdeg);
+    PioDCOGpsdoRepost(pdco);
+
+    return 0;
+}
+
+/// @brief Selects the modulator which converts precise cycles to PIO cycle counts.
+/// @param pdco Ptr to DCO context.
+/// @param emod Desired modulator.
+/// @attention The func can be called while DCO running. MASH 1-1-1 is applied only
+/// @attention when the count has at least eDCOModMashMinCycles cycles of margin,
+/// @attention that is below ~19 MHz at 270 MHz sysclk; the first order loop above.
+void PioDCOSetModulator(PioDco *pdco, enum PioDcoModulator emod)
+{
+    assert_(pdco);
+    pdco->_ctl._modulator = emod;
+    PioDCOCtlNotify(&pdco->_ctl);
 }
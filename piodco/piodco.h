@@ -40,6 +40,24 @@
 //      Rev 0.1   05 Nov 2023   Initial release
 //      Rev 0.2   18 Nov 2023
 //      Rev 1.0   10 Dec 2023   Improved frequency range (to ~33.333 MHz).
+//      Rev 1.1   16 Oct 2026   DMA fed engine.
+//      Rev 1.2   16 Oct 2026   MASH 1-1-1 modulator.
+//      Rev 1.3   16 Oct 2026   Any free PIO state machine, bank of DCOs.
+//      Rev 1.4   16 Oct 2026   Per instance frequency mailbox.
+//      Rev 1.5   16 Oct 2026   Time tagged frequency event queue.
+//      Rev 1.6   16 Oct 2026   Precomputed MFSK tone table.
+//      Rev 1.7   16 Oct 2026   Division free frequency setter.
+//      Rev 1.8   16 Oct 2026   In-worker linear ramp (chirp).
+//      Rev 1.9   16 Oct 2026   Phase steps.
+//      Rev 1.10  16 Oct 2026   Harmonic frequency planner.
+//      Rev 1.11  16 Oct 2026   Programmable duty cycle variant.
+//      Rev 1.12  16 Oct 2026   High resolution modulator, uHz setter.
+//      Rev 1.13  16 Oct 2026   DMA replay of the period of cycle counts.
+//      Rev 1.14  16 Oct 2026   TX stall counter & worker telemetry.
+//      Rev 1.15  16 Oct 2026   Output freq. self-measurement.
+//      Rev 1.16  16 Oct 2026   GPS disciplined mode.
+//      Rev 1.17  17 Oct 2026   PioDCOSetFreqFast dropped.
+//      Rev 1.18  17 Oct 2026   Legacy PioDCOWorker dropped, PioDCOWorker2 is the worker.
 //
 //  PROJECT PAGE
 //      https://github.com/RPiks/pico-hf-oscillator
@@ -74,17 +92,90 @@
 #include <stdint.h>
 #include "pico/stdlib.h"
 #include "hardware/pio.h"
+#include "hardware/sync.h"
 
 #include "defines.h"
+#include "dcomod.h"
+#include "dcowork.h"
+#include "dcoplan.h"
+#include "dcomeas.h"
+#include "dcogpsdo.h"
+#include "dco2.pio.h"
 
 #include "../gpstime/GPStime.h"
 
+enum
+{
+    eDCODmaHalfLen = 256,       /* Words per half of DMA double buffer. */
+    eDCOFifoLen = 8,            /* Words of PIO TX FIFO, RX one joined to it. */
+    eDCODmaMinCycles = 8,       /* Min CPU CLK cycles per PI of DMA engine, CLK/16. */
+    eDCOToneMaxCount = 128,     /* Max tones in MFSK tone table. */
+    eDCOReplayMaxWords = 8192,  /* Max words of the period replayed by DMA. */
+    eDCOReplayMinWords = 64,    /* Min words replayed, short periods are repeated. */
+    eDCOReplaySwitchWords = 16, /* Min words left to switch the period replayed. */
+    eDCOStatsHistLen = 12,      /* Bins of worker loop cycles histogram, log2. */
+    eDCOBenchWords = 16384      /* Words to time a worker loop by. */
+};
+
 enum PioDcoMode
 {
     eDCOMODE_IDLE = 0,          /* No output. */
+    eDCOMODE_RUNNING = 1,       /* The freq. is as set, no correction. */
     eDCOMODE_GPS_COMPENSATED= 2 /* Internally compensated, if GPS available. */
 };
 
+/* MFSK tone table. Cycles per PI of every tone are precomputed, so the tone is
+   switched by its index in constant time, free of 64-bit division. */
+typedef struct
+{
+    int32_t _i32_cycles[eDCOToneMaxCount]; /* CPU CLK cycles per PI less PIO delay. */
+    uint64_t _u64_base_millihz; /* The freq. of tone 0, mHz. */
+    uint32_t _ui32_spacing_millihz; /* Tone spacing, mHz. */
+    int _n;                     /* Count of tones, 0 if the table is not set. */
+    int _ix;                    /* Current tone, -1 if none. */
+    int64_t _i64_correction;    /* GPS freq. correction the table is built with, ppb. */
+
+} PioDcoToneTable;
+
+/* Telemetry of DCO. The worker is the only writer of loop counters, DMA IRQ of
+   the late refills & core0 of the stall counter, every field is a single word,
+   so they are read lock-free.
+   The whole worker loop of a word is timed but its wait for FIFO room: from the
+   FIFO store of a word to the next word ready to store, so the slow path of the
+   requests, the modulator & the store are in, the spin on full FIFO is out. */
+typedef struct
+{
+    volatile uint32_t _ui32_stalled_polls; /* Polls which saw PIO TX stalled, see PioDCOStatsPoll. */
+    volatile uint32_t _ui32_dma_late;     /* DMA refills ended after the other half drained. */
+    volatile uint32_t _ui32_iterations;   /* Worker loop iterations (DCO_TELEMETRY). */
+    volatile uint32_t _ui32_max_cycles;   /* Max CPU CLK cycles of worker loop. */
+    volatile uint32_t _ui32_hist[eDCOStatsHistLen]; /* Loop cycles, bin i is 2^i...2^(i+1)-1. */
+
+} PioDcoStats;
+
+/* The sink of worker loops which feeds PIO TX FIFO of DCO. */
+typedef struct
+{
+    PIO _pio;                   /* PIO of DCO. */
+    uint _sm;                   /* Its state machine. */
+    PioDcoStats *_pstats;       /* Telemetry of the loop (DCO_TELEMETRY). */
+    uint32_t _ui32_t0;          /* SysTick at the FIFO store of the last word. */
+
+} PioDcoFifo;
+
+/* The period of cycle count sequence to be replayed by DMA. */
+typedef struct
+{
+    uint32_t _ui32_period;      /* Words of the period. */
+    uint32_t _ui32_len;         /* Words replayed, the period repeated. */
+    uint32_t _ui32_den;         /* The denominator of exact rational one, 0 if binary. */
+    uint32_t _ui32_wc;          /* Its integer part less PIO delay. */
+    uint32_t _ui32_rem;         /* Its remainder. */
+    uint32_t _ui32_reg;         /* CPU CLK cycles per PI of binary one, scaled by 2^24. */
+    uint32_t _ui32_ext;         /* The next 32 bits of its fraction. */
+
+} PioDcoReplayPlan;
+
 typedef struct
 {
     enum PioDcoMode _mode;      /* Running mode. */
@@ -98,28 +189,126 @@ typedef struct
 
     int32_t _frq_cycles_per_pi; /* CPU CLK cycles per PI. */
 
-    uint32_t _ui32_pioreg[8];   /* Shift register to PIO. */
-
     uint32_t _clkfreq_hz;       /* CPU CLK freq, Hz. */
 
     GPStimeContext *_pGPStime;  /* Ptr to GPS time context. */
 
     uint32_t _ui32_frq_hz;      /* Working freq, Hz. */
     int32_t _ui32_frq_millihz;  /* Working freq additive shift, mHz. */
+    int _harmonic;              /* The harmonic the working freq. is meant for. */
+    volatile uint32_t _ui32_duty_q16; /* Duty cycle of duty cycle variant, 65536 is 100%. */
     int _is_enabled;
 
+    PioDcoCtl _ctl;             /* Requests to worker: freq., events, ramp, phase, modulator. */
+    PioDcoToneTable _tones;     /* MFSK tone table. */
+
+    int64_t _i64_last_correction; /* The last nonzero GPS freq. correction, ppb. */
+    PioDcoGpsdo _gpsdo;         /* GPS disciplining of eDCOMODE_GPS_COMPENSATED. */
+
+    volatile uint64_t _u64_tick0_us; /* Uptime the output tick 0 corresponds to, us. */
+    volatile int _is_in_ram;    /* The worker core runs from RAM only, see PioDCOWorker2. */
+    PioDcoWork _work;           /* Worker state of DMA & bank engines. */
+
+    int _dma_chan[2];           /* DMA ping-pong channels, -1 if not in use. */
+    uint32_t _ui32_dmabuf[2][eDCODmaHalfLen]; /* DMA double buffer. */
+
+    PioDcoStats _stats;         /* Telemetry. */
+
+    PIO _meas_pio;              /* PIO of edge counter of self-measurement. */
+    int _meas_ism;              /* Its state machine, -1 if not claimed. */
+    uint32_t _ui32_meas_samples; /* Samples of the gate in progress, 0 if none. */
+
+    int _replay_chan[2];        /* Replay data & control DMA channels, -1 if not claimed. */
+    uint32_t _ui32_replay_len;  /* Words of the period replayed, 0 if none. */
+    const uint32_t *_pui32_replay; /* The period, the control channel reads it. */
+
 } PioDco;
 
 int PioDCOInit(PioDco *pdco, int gpio, int cpuclkhz);
+int PioDCOInitDuty(PioDco *pdco, int gpio, int cpuclkhz);
+void PioDCOSetDuty(PioDco *pdco, uint32_t ui32duty_q16);
 int PioDCOSetFreq(PioDco *pdco, uint32_t u32_frq_hz, int32_t u32_frq_millihz);
-int32_t PioDCOGetFreqShiftMilliHertz(const PioDco *pdco, uint64_t u64_desired_frq_millihz);
+int PioDCOSetFreqMicroHertz(PioDco *pdco, uint32_t ui32_frq_hz, int32_t i32_frq_microhz);
+int PioDCOSetFreqHarmonic(PioDco *pdco, uint32_t ui32_frq_hz, int32_t i32_frq_millihz,
+                          PioDcoPlan *pplan);
+int32_t PioDCOGetFreqShiftMilliHertz(PioDco *pdco, uint64_t u64_desired_frq_millihz);
+uint32_t PioDCOPostCycles(PioDco *pdco, int32_t i32cycles);
+uint32_t PioDCOPostCyclesExt(PioDco *pdco, int32_t i32cycles, uint32_t ui32ext);
+int PioDCOIsFreqApplied(const PioDco *pdco, uint32_t *pui32word);
+
+int PioDCOEventPush(PioDco *pdco, uint64_t u64tick, uint32_t ui32_frq_hz, int32_t i32_frq_millihz);
+int PioDCOEventPushCycles(PioDco *pdco, uint64_t u64tick, int32_t i32cycles);
+uint64_t PioDCOTickFromUs(const PioDco *pdco, uint64_t u64_us);
+int32_t PioDCOEventLastError(const PioDco *pdco);
+
+int PioDCOSetTones(PioDco *pdco, uint32_t ui32_base_hz, int32_t i32_base_millihz,
+                   uint32_t ui32_spacing_millihz, int ntones);
+int RAM (PioDCOSetTone)(PioDco *pdco, int ix);
+int PioDCOTonesRefresh(PioDco *pdco);
+
+int PioDCORampStart(PioDco *pdco, uint32_t ui32_start_hz, uint32_t ui32_stop_hz,
+                    uint32_t ui32_duration_ms, enum PioDcoRampMode emode);
+void PioDCORampStop(PioDco *pdco);
+
+uint32_t PioDCOPhaseStep(PioDco *pdco, int32_t i32n, int k);
+uint32_t PioDCOGetPhase(const PioDco *pdco);
 
 void PioDCOStart(PioDco *pdco);
 void PioDCOStop(PioDco *pdco);
 
 void PioDCOSetMode(PioDco *pdco, enum PioDcoMode emode);
+enum PioDcoGpsdoState PioDCOGpsdoPoll(PioDco *pdco);
+int PioDCOGpsdoWarmStart(PioDco *pdco, int64_t i64ppb, int32_t i32mdeg);
+void PioDCOSetModulator(PioDco *pdco, enum PioDcoModulator emod);
 
-void RAM (PioDCOWorker)(PioDco *pDCO);
 void RAM (PioDCOWorker2)(PioDco *pDCO);
+void RAM (PioDCOWorkerDuty)(PioDco *pDCO);
+uint32_t RAM (PioDCOBench)(PioDco *pdco, enum PioDcoLoop eloop);
+
+int PioDCOStartDMA(PioDco *pdco);
+void PioDCOStopDMA(PioDco *pdco);
+void RAM (PioDCOFillHalf)(PioDco *pdco, int ix);
+
+uint32_t PioDCOStatsPoll(PioDco *pdco);
+
+int PioDCOMeasureStart(PioDco *pdco, uint32_t ui32gate_ms);
+int PioDCOMeasureResult(PioDco *pdco, PioDcoMeas *pmeas);
+
+int PioDCOStartReplay(PioDco *pdco);
+void PioDCOStopReplay(PioDco *pdco);
+void RAM (PioDCOWorkerReplay)(PioDco *pDCO);
+
+/// @brief The sink which waits for FIFO room and stores the word.
+/// @param pctx Ptr to PioDcoFifo.
+/// @param ui32wc The cycle count.
+DCO_INLINE void PioDCOPutFifo(void *pctx, uint32_t ui32wc)
+{
+    const PioDcoFifo *pf = (const PioDcoFifo *)pctx;
+    pio_sm_put_blocking(pf->_pio, pf->_sm, ui32wc);
+}
+
+/// @brief The sink which stores the word at once, the caller knows FIFO has room.
+/// @param pctx Ptr to PioDcoFifo.
+/// @param ui32wc The cycle count.
+DCO_INLINE void PioDCOPutFifoNow(void *pctx, uint32_t ui32wc)
+{
+    const PioDcoFifo *pf = (const PioDcoFifo *)pctx;
+    pio_sm_put(pf->_pio, pf->_sm, ui32wc);
+}
+
+/// @brief Accounts one worker loop in telemetry.
+/// @param pst Ptr to telemetry.
+/// @param ui32cycles CPU CLK cycles the loop took.
+static inline void PioDCOStatsWord(PioDcoStats *pst, uint32_t ui32cycles)
+{
+    ++pst->_ui32_iterations;
+    if(ui32cycles > pst->_ui32_max_cycles)
+    {
+        pst->_ui32_max_cycles = ui32cycles;
+    }
+
+    const int ibin = 31 - __builtin_clz(ui32cycles | 1U);
+    ++pst->_ui32_hist[ibin < eDCOStatsHistLen ? ibin : eDCOStatsHistLen - 1];
+}
 
 #endif
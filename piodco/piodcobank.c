@@ -0,0 +1,247 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  piodcobank.c - Bank of PIO based DCOs served by one worker.
+//
+//
+//  DESCRIPTION
+//
+//      The bank runs several independent DCOs, each of them has its own
+//  frequency and GPIO and occupies any free state machine of pio0, pio1 (and
+//  pio2 on RP2350). The outputs are served either by one interleaved worker,
+//  which feeds every TX FIFO having room in round robin order, or by the DMA
+//  fed engine of each DCO.
+//      The total edge rate the worker can sustain is limited by the CPU time
+//  needed per PIO word (4 edges); it is measured by PioDCOBankMaxEdgeRate.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "piodcobank.h"
+
+#include <string.h>
+#include "../lib/assert.h"
+
+/// @brief Initializes an empty bank of DCOs.
+/// @param pbank Ptr to bank context.
+/// @param cpuclkhz The system CPU clock freq., Hz.
+void PioDCOBankInit(PioDcoBank *pbank, int cpuclkhz)
+{
+    assert_(pbank);
+    assert_(cpuclkhz);
+
+    memset(pbank, 0, sizeof(PioDcoBank));
+    pbank->_clkfreq_hz = cpuclkhz;
+}
+
+/// @brief Initializes the DCO on the next free PIO state machine and adds it to the bank.
+/// @param pbank Ptr to bank context.
+/// @param pdco Ptr to DCO context, it should live as long as the bank does.
+/// @param gpio The GPIO of DCO output.
+/// @return The index of DCO in the bank. -1 the bank is full or no free state machine.
+int PioDCOBankAdd(PioDcoBank *pbank, PioDco *pdco, int gpio)
+{
+    assert_(pbank);
+    assert_(pdco);
+
+    if(pbank->_n == eDCOBankMaxChannels || PioDCOInit(pdco, gpio, pbank->_clkfreq_hz))
+    {
+        return -1;
+    }
+
+    pbank->_pdco[pbank->_n] = pdco;
+
+    return pbank->_n++;
+}
+
+/// @brief Sets the working frequency of DCO of the bank.
+/// @param pbank Ptr to bank context.
+/// @param ix The index of DCO in the bank.
+/// @param ui32_frq_hz The `coarse` part of frequency [Hz].
+/// @param i32_frq_millihz The `fine` part of frequency [mHz].
+/// @return 0 if OK. -1 invalid index.
+/// @return -2 the total edge rate exceeds measured capacity of the worker (freq is set anyway).
+int PioDCOBankSetFreq(PioDcoBank *pbank, int ix, uint32_t ui32_frq_hz, int32_t i32_frq_millihz)
+{
+    assert_(pbank);
+
+    if(ix < 0 || ix >= pbank->_n)
+    {
+        return -1;
+    }
+
+    PioDCOSetFreq(pbank->_pdco[ix], ui32_frq_hz, i32_frq_millihz);
+
+    if(pbank->_ui32_max_edge_rate && PioDCOBankEdgeRate(pbank) > pbank->_ui32_max_edge_rate)
+    {
+        return -2;
+    }
+
+    return 0;
+}
+
+/// @brief Calculates the total edge rate demanded by all DCOs of the bank.
+/// @param pbank Ptr to bank context.
+/// @return The sum of rising and falling edges per second.
+uint32_t PioDCOBankEdgeRate(const PioDcoBank *pbank)
+{
+    assert_(pbank);
+
+    uint64_t u64rate = 0;
+    for(int i = 0; i < pbank->_n; ++i)
+    {
+        u64rate += 2ULL * pbank->_pdco[i]->_ui32_frq_hz;
+    }
+
+    return u64rate > UINT32_MAX ? UINT32_MAX : (uint32_t)u64rate;
+}
+
+/// @brief The sink of capacity measurement, it stores to nowhere.
+DCO_INLINE void PioDCOBankPutNull(void *pctx, uint32_t ui32wc)
+{
+    *(volatile uint32_t *)pctx = ui32wc;
+}
+
+/// @brief Measures the highest total edge rate the interleaved worker can sustain.
+/// @brief It times the worker loop body (FIFO level poll, the loop of one word, the
+/// @brief store) on the copy of DCO state, the outputs aren't affected. One word per
+/// @brief poll is the worst case, the worker which keeps up finds one word of room.
+/// @param pbank Ptr to bank context.
+/// @return The highest total edge rate, edges per second.
+/// @attention It should be called on the core which is to run the worker.
+uint32_t RAM (PioDCOBankMaxEdgeRate)(PioDcoBank *pbank)
+{
+    assert_(pbank);
+    assert_(pbank->_n);
+
+    static PioDco sdco_copy;
+    static volatile uint32_t sui32sink;
+
+    memcpy(&sdco_copy, pbank->_pdco[0], sizeof(PioDco));
+
+    const uint64_t tm0 = time_us_64();
+    for(int i = 0, ix = 0; i < eDCOBankBenchWords; ++i)
+    {
+        PioDco *pdco = pbank->_pdco[ix];
+        if(++ix == pbank->_n)
+        {
+            ix = 0;
+        }
+        sui32sink = pio_sm_get_tx_fifo_level(pdco->_pio, pdco->_ism);
+        PioDCORun(&sdco_copy._ctl, &sdco_copy._work, 1, PioDCOBankPutNull, (void *)&sui32sink);
+    }
+    const uint64_t dt = time_us_64() - tm0;
+
+    /* RPix: Every word carries 4 edges. */
+    const uint64_t u64rate = dt ? 4000000ULL * eDCOBankBenchWords / dt : UINT32_MAX;
+    pbank->_ui32_max_edge_rate = u64rate > UINT32_MAX ? UINT32_MAX : (uint32_t)u64rate;
+
+    return pbank->_ui32_max_edge_rate;
+}
+
+/// @brief Starts all DCOs of the bank.
+/// @param pbank Ptr to bank context.
+void PioDCOBankStart(PioDcoBank *pbank)
+{
+    assert_(pbank);
+
+    for(int i = 0; i < pbank->_n; ++i)
+    {
+        PioDCOStart(pbank->_pdco[i]);
+    }
+}
+
+/// @brief Starts DMA fed engine of every DCO of the bank, so no worker is needed.
+/// @param pbank Ptr to bank context.
+/// @return 0 if OK. -1 there are not enough DMA channels (two per DCO). -2 a freq.
+/// @return is above CLK/16, see PioDCOStartDMA.
+/// @attention It should be called on the core which is to serve DMA IRQ.
+int PioDCOBankStartDMA(PioDcoBank *pbank)
+{
+    assert_(pbank);
+
+    for(int i = 0; i < pbank->_n; ++i)
+    {
+        const int iret = PioDCOStartDMA(pbank->_pdco[i]);
+        if(iret)
+        {
+            while(i--)
+            {
+                PioDCOStopDMA(pbank->_pdco[i]);
+            }
+
+            return iret;
+        }
+    }
+
+    return 0;
+}
+
+/// @brief The interleaved worker of the bank. It fills the room of TX FIFO of every DCO
+/// @brief in round robin order, by the loop of its modulator. It is time critical,
+/// @brief so it ought to be run on the dedicated pi pico core.
+/// @param pbank Ptr to bank context.
+/// @return No return. It spins forever.
+void RAM (PioDCOBankWorker)(PioDcoBank *pbank)
+{
+    assert_(pbank);
+
+    PioDco * const *ppdco = pbank->_pdco;
+    const int n = pbank->_n;
+    PioDcoFifo fifo[eDCOBankMaxChannels];
+
+    const uint64_t u64tm = time_us_64();
+    for(int i = 0; i < n; ++i)
+    {
+        ppdco[i]->_u64_tick0_us = u64tm;
+        fifo[i] = (PioDcoFifo){ ppdco[i]->_pio, ppdco[i]->_ism, NULL, 0 };
+    }
+
+    for(;;)
+    {
+        for(int i = 0; i < n; ++i)
+        {
+            PioDco *pdco = ppdco[i];
+            const uint32_t ui32room = eDCOFifoLen - pio_sm_get_tx_fifo_level(pdco->_pio, pdco->_ism);
+            if(ui32room)
+            {
+                PioDCORun(&pdco->_ctl, &pdco->_work, ui32room, PioDCOPutFifoNow, &fifo[i]);
+            }
+        }
+    }
+}
@@ -0,0 +1,88 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  piodcobank.h - Bank of PIO based DCOs served by one worker.
+//
+//
+//  DESCRIPTION
+//
+//      The bank runs several independent DCOs, each of them has its own
+//  frequency and GPIO and occupies any free state machine of pio0, pio1 (and
+//  pio2 on RP2350). The outputs are served either by one interleaved worker,
+//  which feeds every TX FIFO having room in round robin order, or by the DMA
+//  fed engine of each DCO.
+//      The total edge rate the worker can sustain is limited by the CPU time
+//  needed per PIO word (4 edges); it is measured by PioDCOBankMaxEdgeRate.
+//
+//  PLATFORM
+//      Raspberry Pi pico.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef PIODCOBANK_H_
+#define PIODCOBANK_H_
+
+#include "piodco.h"
+
+enum
+{
+    eDCOBankMaxChannels = 4 * NUM_PIOS, /* Every state machine of every PIO. */
+    eDCOBankBenchWords = 65536          /* Words to time capacity measurement by. */
+};
+
+typedef struct
+{
+    PioDco *_pdco[eDCOBankMaxChannels]; /* DCOs of the bank. */
+    int _n;                     /* Count of DCOs in the bank. */
+
+    uint32_t _clkfreq_hz;       /* CPU CLK freq, Hz. */
+    uint32_t _ui32_max_edge_rate; /* Measured capacity, edges per second, 0 if unknown. */
+
+} PioDcoBank;
+
+void PioDCOBankInit(PioDcoBank *pbank, int cpuclkhz);
+int PioDCOBankAdd(PioDcoBank *pbank, PioDco *pdco, int gpio);
+int PioDCOBankSetFreq(PioDcoBank *pbank, int ix, uint32_t ui32_frq_hz, int32_t i32_frq_millihz);
+
+uint32_t PioDCOBankMaxEdgeRate(PioDcoBank *pbank);
+uint32_t PioDCOBankEdgeRate(const PioDcoBank *pbank);
+
+void PioDCOBankStart(PioDcoBank *pbank);
+int PioDCOBankStartDMA(PioDcoBank *pbank);
+
+void RAM (PioDCOBankWorker)(PioDcoBank *pbank);
+
+#endif
@@ -2,6 +2,8 @@
 #define PROTOS_H_
 
 #include "defines.h"
+#include "piodco/piodco.h"
+#include "lib/kvstore.h"
 
 /* main.c */
 
@@ -21,5 +23,18 @@ void core1_entry();
 void ConsoleCommandsWrapper(char *cmd, int narg, char *params);
 void PushErrorMessage(int id);
 void PushStatusMessage(void);
+void ConsoleMeasurePoll(void);
+
+/* config.c */
+
+int ConfigLoad(void);
+void ConfigRestoreDCO(PioDco *pdco);
+void ConfigRestore(PioDco *pdco);
+int ConfigSave(const PioDco *pdco);
+void ConfigSetAutoSave(int is_on);
+int ConfigIsAutoSave(void);
+int ConfigClear(void);
+void ConfigPoll(const PioDco *pdco);
+const KVstore *ConfigStore(void);
 
 #endif
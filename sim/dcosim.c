@@ -0,0 +1,1531 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  dcosim.c - Off-target simulator of the PIO based DCO.
+//
+//
+//  DESCRIPTION
+//
+//      The simulator runs the very arithmetic of PioDCOWorker2 and PioDCOWorkerDuty
+//  (see piodco/dcomod.h) against the cycle accurate model of `dco` PIO program.
+//  It emits rising edge timestamps in sysclk ticks and reports mean frequency
+//  error, period jitter and time interval error. The worker is assumed to
+//  meet the FIFO deadline, i.e. PIO never stalls on empty FIFO.
+//
+//  USAGE
+//      dcosim -f Hz [-m mHz] [-u uHz] [-c sysclk_Hz] [-n edges] [-w 2|3] [-M|-X] [-D %] [-o file]
+//      dcosim -P [-f Hz] [-c sysclk_Hz]
+//      dcosim -U [-c sysclk_Hz]
+//      dcosim -Y [-c sysclk_Hz]
+//      dcosim -G ms [-f Hz] [-c sysclk_Hz]
+//      dcosim -C [-c sysclk_Hz]
+//      dcosim -E [-c sysclk_Hz]
+//      dcosim -L [-c sysclk_Hz]
+//      dcosim -W
+//      dcosim -S -f Hz [-m mHz] [-c sysclk_Hz]
+//
+//      -f  DCO frequency, Hz.
+//      -m  DCO frequency additive shift, mHz.
+//      -u  DCO frequency additive shift, uHz, added to the one of -m.
+//      -c  CPU CLK freq., Hz, 270000000 by default.
+//      -n  Count of rising edges to simulate, 1000000 by default.
+//      -w  Worker to simulate, 2 by default (PioDCOWorker2), 3 is PioDCOWorkerDuty.
+//      -M  MASH 1-1-1 modulator instead of the first order one (worker 2).
+//      -X  First order modulator of high resolution (worker 2).
+//      -D  Duty cycle of worker 3, percent, 50 by default.
+//      -o  File to dump rising edge ticks to.
+//      -P  Print the harmonic plan of the freq. given by -f; with no -f check
+//          the planner choices over the whole range it covers, and the phase
+//          steps of PioDCOPhaseStep down to the lowest freq. of PioDCOSetFreq.
+//      -U  Check PioDCOModCyclesPerPiHiRes against 128-bit reference and the
+//          long term mean of PioDCOModFirstOrderHiRes at random freqs.
+//      -Y  Check the periods rendered by PioDCOModRender & PioDCOModRenderRational,
+//          whole & in chunks, and count the Hz of the range which fit the replay
+//          buffer.
+//      -G  Measure the freq. given by -f as `dco_count` & PioDCOMeasResult do
+//          over the gate of ms; with no -f check it at random freqs & CPU CLK
+//          errors.
+//      -C  Check PioDCOGpsdoCorrect against 128-bit reference at random freqs &
+//          CPU CLK errors, and the GPSDO states of PioDCOGpsdoStep: acquisition,
+//          slew limit, holdover on PPS timeout & loss of fix, recovery.
+//      -E  Check the timing of time tagged events by the worker loops of
+//          piodco/dcowork.h against PIO model, per word & batched, for every
+//          modulator.
+//      -L  Check the freq. of ramps, narrow & wide, up & down, run through the
+//          worker loop & PIO model against the linear chirp, and their duration.
+//      -W  Check the words of DMA engine (PioDCOFillHalf) & of PioDCOWorker2
+//          against the loops run word by word over the random script of
+//          requests of every kind.
+//      -S  Find the worst spurs of the freq. given by -f, overall & close-in, of
+//          both the first order & MASH 1-1-1 modulators, by FFT of the phase
+//          error of 2^20 rising edges.
+//
+//  PLATFORM
+//      Linux host.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//      Rev 0.2   16 Oct 2026   High resolution modulator check.
+//      Rev 0.3   16 Oct 2026   Replay period check.
+//      Rev 0.4   16 Oct 2026   Self-measurement check.
+//      Rev 0.5   16 Oct 2026   GPSDO check.
+//      Rev 0.6   16 Oct 2026   Event timing check.
+//      Rev 0.7   16 Oct 2026   DMA & worker engines check.
+//      Rev 0.8   16 Oct 2026   Spur metric.
+//      Rev 0.9   17 Oct 2026   Replay render in chunks check.
+//      Rev 1.0   17 Oct 2026   Ramp linearity check.
+//      Rev 1.1   17 Oct 2026   Division free cycles per PI check dropped.
+//      Rev 1.2   17 Oct 2026   Legacy worker 1 model dropped.
+//      Rev 1.3   17 Oct 2026   Phase step check down to the lowest freq.
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+
+#include "../piodco/dcomod.h"
+#include "../piodco/dcowork.h"
+#include "../piodco/dcoplan.h"
+#include "../piodco/dcomeas.h"
+#include "../piodco/dcogpsdo.h"
+#include "piosim.h"
+
+static void Usage(void)
+{
+    fprintf(stderr, "Usage: dcosim -f Hz [-m mHz] [-u uHz] [-c sysclk_Hz] [-n edges] [-w 2|3] [-M|-X] [-D %%] [-o file]\n"
+                    "       dcosim -P [-f Hz] [-c sysclk_Hz]\n"
+                    "       dcosim -U [-c sysclk_Hz]\n"
+                    "       dcosim -Y [-c sysclk_Hz]\n"
+                    "       dcosim -G ms [-f Hz] [-c sysclk_Hz]\n"
+                    "       dcosim -C [-c sysclk_Hz]\n"
+                    "       dcosim -E [-c sysclk_Hz]\n"
+                    "       dcosim -L [-c sysclk_Hz]\n"
+                    "       dcosim -W\n"
+                    "       dcosim -S -f Hz [-m mHz] [-c sysclk_Hz]\n");
+}
+
+/// @brief Prints the harmonic plan.
+static void PrintPlan(uint32_t ui32frq_hz, int32_t i32frq_millihz, const PioDcoPlan *pplan)
+{
+    printf("Target %u Hz + %d mHz: harmonic %d of %u Hz + %d mHz, step %u uHz, "
+           "TIE %u ps, phase p-p %.3f deg, level %.1f dB\n",
+           ui32frq_hz, i32frq_millihz, pplan->_harmonic, pplan->_ui32_fund_hz,
+           pplan->_i32_fund_millihz, pplan->_ui32_step_uhz, pplan->_ui32_tie_ps,
+           pplan->_ui32_phase_pp_mdeg / 1000.0, pplan->_level_db10 / 10.0);
+}
+
+/// @brief Checks the harmonic planner over the whole range it covers, every kHz
+/// @brief with a pseudo random mHz shift: the harmonic is the lowest possible,
+/// @brief the fundamental is in range and the cycles per PI are the exactly
+/// @brief rounded value of the target, calculated by 128-bit arithmetic here.
+/// @param ui32clk_hz The CPU CLK freq., Hz.
+/// @return The count of failures.
+static uint64_t CheckPlanner(uint32_t ui32clk_hz)
+{
+    static const int harmonics[] = { 1, 3, 5, 7 };
+    const uint32_t ui32max_hz = ui32clk_hz >> 3;
+    uint64_t u64checked = 0, u64failures = 0;
+    uint64_t u64count[8] = { 0 };
+
+    for(uint32_t hz = (ui32clk_hz >> 8) + 1000; hz < 7 * ui32max_hz; hz += 1000)
+    {
+        const int32_t mhz = (int32_t)((hz * 7919U) % 1999U) - 999;
+        const int64_t frq_millihz = 1000LL * hz + mhz;
+
+        PioDcoPlan plan;
+        if(PioDCOPlanHarmonic(ui32clk_hz, hz, mhz, &plan))
+        {
+            printf("No plan for %u Hz + %d mHz\n", hz, mhz);
+            ++u64failures;
+            continue;
+        }
+
+        int hmin = 0;
+        for(int i = 0; i < 4 && !hmin; ++i)
+        {
+            if(frq_millihz <= 1000LL * ui32max_hz * harmonics[i])
+            {
+                hmin = harmonics[i];
+            }
+        }
+
+        const unsigned __int128 num = (unsigned __int128)plan._harmonic * ui32clk_hz
+                                      * (1ULL << 24) * 1000U;
+        const uint64_t den = 2 * frq_millihz;
+        const int32_t cpp = (int32_t)(uint32_t)((num + den / 2) / den);
+
+        const int64_t fund_millihz = 1000LL * plan._ui32_fund_hz + plan._i32_fund_millihz;
+        const int64_t fund_err = fund_millihz * plan._harmonic - frq_millihz;
+
+        if(plan._harmonic != hmin || cpp != plan._i32_cycles_per_pi
+           || fund_millihz > 1000LL * ui32max_hz || fund_err > plan._harmonic || fund_err < -plan._harmonic)
+        {
+            if(u64failures < 10)
+            {
+                printf("Failure: ");
+                PrintPlan(hz, mhz, &plan);
+            }
+            ++u64failures;
+        }
+
+        ++u64count[plan._harmonic];
+        ++u64checked;
+    }
+
+    printf("Checked:    %llu freqs, h1 %llu h3 %llu h5 %llu h7 %llu, %llu failures\n",
+           (unsigned long long)u64checked, (unsigned long long)u64count[1],
+           (unsigned long long)u64count[3], (unsigned long long)u64count[5],
+           (unsigned long long)u64count[7], (unsigned long long)u64failures);
+
+    return u64failures;
+}
+
+/// @brief Checks PioDCOModCyclesPerPiHiRes against the value calculated in 128 bits
+/// @brief and runs PioDCOModFirstOrderHiRes at each freq.: the sum of cycle counts
+/// @brief should never drift from N * value by more than a cycle.
+/// @param ui32clk_hz The CPU CLK freq., Hz.
+/// @return The count of failures.
+static uint64_t CheckHiRes(uint32_t ui32clk_hz)
+{
+    const uint32_t ui32lo = (ui32clk_hz >> 9) + 1;
+    const uint32_t ui32hi = ui32clk_hz >> 3;
+    const uint32_t ui32freqs = 1000;
+    const uint32_t ui32words = 10000000;
+
+    uint64_t u64failures = 0;
+    uint64_t u64max_drift = 0;
+    uint32_t ui32seed = 12345;
+    for(uint32_t i = 0; i < ui32freqs; ++i)
+    {
+        ui32seed = ui32seed * 1664525U + 1013904223U;
+        const uint32_t hz = ui32lo + ui32seed % (ui32hi - ui32lo);
+        ui32seed = ui32seed * 1664525U + 1013904223U;
+        const int32_t uhz = (int32_t)(ui32seed % 1999999U) - 999999;
+
+        const unsigned __int128 den = 2000000ULL * hz + 2LL * uhz;
+        const unsigned __int128 num = ((unsigned __int128)ui32clk_hz * 1000000ULL) << 56;
+        const uint64_t ref = (uint64_t)((num + den / 2) / den);
+        const uint64_t u64v = PioDCOModCyclesPerPiHiRes(ui32clk_hz, hz, uhz);
+
+        /* RPix: A tie is rounded up by both, the remainder is exact. */
+        if(u64v != ref)
+        {
+            if(u64failures < 10)
+            {
+                printf("Mismatch at %u Hz %d uHz: %llu vs %llu\n", hz, uhz,
+                       (unsigned long long)ref, (unsigned long long)u64v);
+            }
+            ++u64failures;
+            continue;
+        }
+
+        /* RPix: The same as PioDCOSetFreqMicroHertz does. */
+        const uint64_t u64cycles = u64v - ((uint64_t)eSimDelayCycles << 56U);
+        const uint32_t ui32reg = (uint32_t)(u64cycles >> 32U);
+        const uint32_t ui32ext = (uint32_t)u64cycles;
+
+        /* RPix: The long runs are a few, the others are short. */
+        const uint32_t n = i < 10 ? ui32words : ui32words / 100;
+        uint64_t u64acc = 0;
+        uint64_t u64sum = 0;
+        for(uint32_t k = 0; k < n; ++k)
+        {
+            u64sum += PioDCOModFirstOrderHiRes(ui32reg, ui32ext, &u64acc);
+        }
+
+        const __int128 drift = ((__int128)u64sum << 56) - (__int128)u64cycles * n;
+        const uint64_t u64drift = (uint64_t)((drift < 0 ? -drift : drift) >> 32);
+        if(u64drift > u64max_drift)
+        {
+            u64max_drift = u64drift;
+        }
+        if(drift >= ((__int128)1 << 56) || drift <= -((__int128)1 << 56))
+        {
+            if(u64failures < 10)
+            {
+                printf("Drift at %u Hz %d uHz after %u words\n", hz, uhz, n);
+            }
+            ++u64failures;
+        }
+    }
+
+    printf("Checked:    %u freqs %u...%u Hz, max drift %.9f cycles, %llu failures\n",
+           ui32freqs, ui32lo, ui32hi, (double)u64max_drift / (1 << 24),
+           (unsigned long long)u64failures);
+
+    return u64failures;
+}
+
+/// @brief Checks PioDCOModRender: the period rendered and repeated should be the
+/// @brief very sequence of the modulator, whose sum over the period is exact. Checks
+/// @brief PioDCOModRenderRational: the sum over its period should be the numerator.
+/// @brief Both ones rendered in random chunks by the *At variants, as the replay of
+/// @brief firmware does betwixt FIFO top ups, should be the same words. Then counts
+/// @brief the Hz of the range which the replay buffer of firmware fits.
+/// @param ui32clk_hz The CPU CLK freq., Hz.
+/// @return The count of failures.
+static uint64_t CheckReplay(uint32_t ui32clk_hz)
+{
+    enum { eMaxLog2 = 13, eMaxWords = 8192 };  /* Must match eDCOReplayMaxWords of piodco.h. */
+    enum { eChunkWords = 8 };                  /* As eDCOFifoLen of piodco.h. */
+    static uint32_t ui32buf[eMaxWords];
+    static uint32_t ui32chunked[eMaxWords];
+
+    uint64_t u64failures = 0;
+    uint32_t ui32seed = 12345;
+    for(uint32_t i = 0; i < 10000; ++i)
+    {
+        /* RPix: The value of period 2^k words, 12...40 cycles per PI. */
+        ui32seed = ui32seed * 1664525U + 1013904223U;
+        const int k = ui32seed % (eMaxLog2 + 1);
+        ui32seed = ui32seed * 1664525U + 1013904223U;
+        const uint64_t u64frac = k ? ((uint64_t)(ui32seed | 1U) << (56 - k)) & 0xFFFFFFFFFFFFFFULL : 0;
+        const uint32_t ui32reg = ((8U + ui32seed % 28U) << 24U) | (uint32_t)(u64frac >> 32U);
+        const uint32_t ui32ext = (uint32_t)u64frac;
+
+        const int ilog2 = PioDCOModPeriodLog2(ui32reg, ui32ext);
+        const uint32_t ui32len = 1U << ilog2;
+        PioDCOModRender(ui32reg, ui32ext, ui32buf, ui32len);
+        for(uint32_t n = 0; n < ui32len; )
+        {
+            ui32seed = ui32seed * 1664525U + 1013904223U;
+            const uint32_t ui32to = n + 1 + ui32seed % 16U;
+            PioDCOModRenderAt(ui32reg, ui32ext, ui32chunked, n, ui32to < ui32len ? ui32to : ui32len);
+            n = ui32to;
+        }
+
+        uint64_t u64acc = 0;
+        uint64_t u64sum = 0;
+        int bfail = ilog2 != k;
+        bfail |= 0 != memcmp(ui32buf, ui32chunked, ui32len * sizeof(uint32_t));
+        for(uint32_t n = 0; n < 4 * ui32len; ++n)
+        {
+            const uint32_t ui32wc = PioDCOModFirstOrderHiRes(ui32reg, ui32ext, &u64acc);
+            bfail |= ui32wc != ui32buf[n & (ui32len - 1)];
+            u64sum += n < ui32len ? ui32wc : 0;
+        }
+
+        const unsigned __int128 exact = ((((unsigned __int128)ui32reg << 32) | ui32ext) * ui32len);
+        bfail |= ((unsigned __int128)u64sum << 56) != exact;
+        if(bfail)
+        {
+            if(u64failures < 10)
+            {
+                printf("Failure at 0x%08X:%08X, period 2^%d\n", ui32reg, ui32ext, ilog2);
+            }
+            ++u64failures;
+        }
+    }
+
+    /* RPix: The same as PioDCOStartReplay does. */
+    const uint32_t ui32lo = (ui32clk_hz >> 8) + 1;
+    const uint32_t ui32hi = ui32clk_hz >> 3;
+    uint64_t u64fit_binary = 0, u64fit_rational = 0;
+    for(uint32_t hz = ui32lo; hz <= ui32hi; ++hz)
+    {
+        const uint32_t ui32reg = PioDCOModCyclesPerPi(ui32clk_hz, hz, 0) - (eSimDelayCycles<<24);
+        u64fit_binary += PioDCOModPeriodLog2(ui32reg, 0) <= eMaxLog2;
+
+        const uint64_t u64num0 = (uint64_t)ui32clk_hz * 1000ULL;
+        const uint64_t u64den0 = 2000ULL * hz;
+        const uint64_t u64gcd = PioDCOModGcd(u64num0, u64den0);
+        const uint64_t u64num = u64num0 / u64gcd;
+        const uint64_t u64den = u64den0 / u64gcd;
+        if(u64den > eMaxWords)
+        {
+            continue;
+        }
+        ++u64fit_rational;
+
+        PioDCOModRenderRational(u64num, u64den, eSimDelayCycles, ui32buf);
+        uint64_t u64sum = 0;
+        for(uint32_t n = 0; n < u64den; ++n)
+        {
+            u64sum += ui32buf[n] + eSimDelayCycles;
+        }
+
+        /* RPix: The unreduced quotient & remainder scaled by gcd, as PioDCOReplayPlanOf. */
+        const uint32_t ui32wc = (uint32_t)(u64num0 / u64den0) - eSimDelayCycles;
+        const uint32_t ui32rem = (uint32_t)((u64num0 % u64den0) / u64gcd);
+        for(uint32_t n = 0; n < u64den; )
+        {
+            const uint32_t ui32to = n + eChunkWords;
+            PioDCOModRenderRationalAt(ui32wc, ui32rem, (uint32_t)u64den, ui32chunked, n,
+                                      ui32to < u64den ? ui32to : (uint32_t)u64den);
+            n = ui32to;
+        }
+        if(u64sum != u64num || memcmp(ui32buf, ui32chunked, u64den * sizeof(uint32_t)))
+        {
+            if(u64failures < 10)
+            {
+                printf("Failure at %u Hz, period %llu\n", hz, (unsigned long long)u64den);
+            }
+            ++u64failures;
+        }
+    }
+
+    printf("Checked:    10000 binary periods & every rational one, %llu failures\n",
+           (unsigned long long)u64failures);
+    printf("Replayable: %u Hz %u...%u, binary %llu, exact rational %llu (buffer of %d words)\n",
+           ui32hi - ui32lo + 1, ui32lo, ui32hi, (unsigned long long)u64fit_binary,
+           (unsigned long long)u64fit_rational, eMaxWords);
+
+    return u64failures;
+}
+
+/// @brief Runs the DCO model at the freq. and counts its edges over the gate.
+/// @param ui32clk_hz The CPU CLK freq., Hz.
+/// @param ui32frq_hz The freq., Hz.
+/// @param i32frq_millihz The freq. additive shift, mHz.
+/// @param ui32samples The count of samples of the gate.
+/// @param u64open The tick the gate opens at.
+/// @return The count of rising edges.
+static uint32_t CountEdges(uint32_t ui32clk_hz, uint32_t ui32frq_hz, int32_t i32frq_millihz,
+                           uint32_t ui32samples, uint64_t u64open)
+{
+    const uint32_t ui32reg = PioDCOModCyclesPerPi(ui32clk_hz, ui32frq_hz, i32frq_millihz)
+                             - (eSimDelayCycles<<24);
+    PioSim sim;
+    PioSimInit(&sim, 32, 1000.0 * ui32clk_hz / (1000.0 * ui32frq_hz + i32frq_millihz), NULL);
+    sim._u64_gate_open = u64open;
+    sim._u64_gate_close = u64open + (uint64_t)ui32samples * eDCOMeasCyclesPerSample;
+
+    int32_t i32acc_error = 0;
+    while(sim._u64_tick <= sim._u64_gate_close)
+    {
+        PioSimPut(&sim, PioDCOModFirstOrder(ui32reg, &i32acc_error));
+    }
+
+    return (uint32_t)sim._u64_gate_edges;
+}
+
+/// @brief Checks the self-measurement at random freqs, gate phases & CPU CLK errors:
+/// @brief the error of the result should be within an edge of the gate.
+/// @param ui32clk_hz The CPU CLK freq., Hz.
+/// @param ui32gate_ms The gate, ms.
+/// @return The count of failures.
+static uint64_t CheckMeasure(uint32_t ui32clk_hz, uint32_t ui32gate_ms)
+{
+    const uint32_t ui32lo = (ui32clk_hz >> 8) + 1;
+    const uint32_t ui32hi = ui32clk_hz >> 3;
+    const uint32_t ui32samples = PioDCOMeasGateSamples(ui32clk_hz, ui32gate_ms);
+
+    uint64_t u64failures = 0;
+    double max_err_edges = 0.;
+    uint32_t ui32seed = 12345;
+    for(int i = 0; i < 100; ++i)
+    {
+        ui32seed = ui32seed * 1664525U + 1013904223U;
+        const uint32_t hz = ui32lo + ui32seed % (ui32hi - ui32lo);
+        ui32seed = ui32seed * 1664525U + 1013904223U;
+        const int32_t ppb = (int32_t)(ui32seed % 20001U) - 10000;
+
+        /* RPix: CPU CLK runs off by ppb, so does the output; the measurement
+           corrected by ppb should see the true freq. */
+        const uint32_t ui32edges = CountEdges(ui32clk_hz, hz, 0, ui32samples, 1 + ui32seed % 1000U);
+        const double ideal_millihz = 1000. * (double)ui32clk_hz * (double)(1 << 23)
+                                     / (double)PioDCOModCyclesPerPi(ui32clk_hz, hz, 0)
+                                     * (1. + 1e-9 * ppb);
+        PioDcoMeas meas;
+        PioDCOMeasResult(ui32clk_hz, ui32samples, ui32edges, ppb, 1000ULL * hz, &meas);
+
+        const double edge_millihz = 1000. * ui32clk_hz / (double)meas._u64_gate_cycles;
+        const double err_edges = fabs((double)meas._u64_frq_millihz - ideal_millihz) / edge_millihz;
+        if(err_edges > max_err_edges)
+        {
+            max_err_edges = err_edges;
+        }
+        if(err_edges > 1. + 2. / edge_millihz)
+        {
+            if(u64failures < 10)
+            {
+                printf("Failure at %u Hz %d ppb: %llu mHz vs %.1f mHz\n", hz, ppb,
+                       (unsigned long long)meas._u64_frq_millihz, ideal_millihz);
+            }
+            ++u64failures;
+        }
+    }
+
+    printf("Checked:    100 freqs %u...%u Hz, gate %u ms, max error %.3f edges, %llu failures\n",
+           ui32lo, ui32hi, ui32gate_ms, max_err_edges, (unsigned long long)u64failures);
+
+    return u64failures;
+}
+
+/// @brief Runs one PPS of GPSDO & checks its state and correction.
+/// @return 1 if failed.
+static int GpsdoExpect(PioDcoGpsdo *pg, uint64_t u64now_us, uint32_t ui32pps, int is_valid,
+                       int64_t i64ppb, enum PioDcoGpsdoState state, int64_t i64expect_ppb)
+{
+    PioDCOGpsdoStep(pg, u64now_us, ui32pps, is_valid, i64ppb);
+    if(pg->_state == state && pg->_i64_ppb == i64expect_ppb)
+    {
+        return 0;
+    }
+
+    printf("GPSDO at %llu us PPS %u: state %d, %lld ppb vs %d, %lld ppb\n",
+           (unsigned long long)u64now_us, ui32pps, pg->_state, (long long)pg->_i64_ppb,
+           state, (long long)i64expect_ppb);
+    return 1;
+}
+
+/// @brief Checks PioDCOGpsdoCorrect against cycles * (1 + ppb * 1e-9) of 128-bit
+/// @brief arithmetic at random freqs & CPU CLK errors, then runs the GPSDO states.
+/// @param ui32clk_hz The CPU CLK freq., Hz.
+/// @return The count of failures.
+static uint64_t CheckGpsdo(uint32_t ui32clk_hz)
+{
+    const uint32_t ui32lo = (ui32clk_hz >> 9) + 1;
+    const uint32_t ui32hi = ui32clk_hz >> 3;
+
+    uint64_t u64failures = 0;
+    double max_err_ppb = 0.;
+    uint32_t ui32seed = 12345;
+    PioDcoGpsdo gd;
+    memset(&gd, 0, sizeof(gd));
+    for(int i = 0; i < 100000; ++i)
+    {
+        ui32seed = ui32seed * 1664525U + 1013904223U;
+        const uint32_t hz = ui32lo + ui32seed % (ui32hi - ui32lo);
+        ui32seed = ui32seed * 1664525U + 1013904223U;
+        const int64_t ppb = (int64_t)(ui32seed % 400001U) - 200000;
+
+        /* RPix: Acquisition applies the estimate at once. */
+        PioDCOGpsdoReset(&gd, eDCOGPSDO_WAIT);
+        PioDCOGpsdoStep(&gd, 1000000ULL * (i + 1), i + 1, 1, ppb);
+
+        const uint64_t u64cycles = PioDCOModCyclesPerPiHiRes(ui32clk_hz, hz, 0);
+        const __int128 ref = (__int128)u64cycles * (1000000000LL + ppb) / 1000000000LL;
+        const double err_ppb = 1e9 * fabs((double)((__int128)PioDCOGpsdoCorrect(&gd, u64cycles) - ref))
+                               / (double)u64cycles;
+        if(err_ppb > max_err_ppb)
+        {
+            max_err_ppb = err_ppb;
+        }
+        if(err_ppb > 1e-3)
+        {
+            if(u64failures < 10)
+            {
+                printf("Mismatch at %u Hz %lld ppb: %.6f ppb\n", hz, (long long)ppb, err_ppb);
+            }
+            ++u64failures;
+        }
+    }
+
+    printf("Checked:    100000 freqs %u...%u Hz, +/-200 ppm, max error %.6f ppb\n",
+           ui32lo, ui32hi, max_err_ppb);
+
+    /* RPix: 1 PPS per s; acquire, slew to a step, lose PPS, lose the fix, recover. */
+    memset(&gd, 0, sizeof(gd));
+    PioDCOGpsdoReset(&gd, eDCOGPSDO_WAIT);
+    uint64_t t = 0;
+    uint32_t pps = 0;
+    int ifail = 0;
+    ifail |= GpsdoExpect(&gd, t += 1000000, ++pps, 0, 0, eDCOGPSDO_WAIT, 0);
+    ifail |= GpsdoExpect(&gd, t += 1000000, ++pps, 1, 2345, eDCOGPSDO_LOCKED, 2345);
+    for(int k = 1; k <= 11; ++k)
+    {
+        ifail |= GpsdoExpect(&gd, t += 1000000, ++pps, 1, 2400, eDCOGPSDO_LOCKED,
+                             k < 11 ? 2345 + eDCOGpsdoSlewPPB * k : 2400);
+    }
+    ifail |= GpsdoExpect(&gd, t += eDCOGpsdoTimeoutMs * 1000ULL, pps, 1, 2500, eDCOGPSDO_LOCKED, 2400);
+    ifail |= GpsdoExpect(&gd, t += 1000, pps, 1, 2500, eDCOGPSDO_HOLDOVER, 2400);
+    ifail |= GpsdoExpect(&gd, t += 1000000, ++pps, 0, 2500, eDCOGPSDO_HOLDOVER, 2400);
+    ifail |= GpsdoExpect(&gd, t += 1000000, ++pps, 1, 2390, eDCOGPSDO_LOCKED, 2395);
+    ifail |= GpsdoExpect(&gd, t += 1000000, ++pps, 1, 2390, eDCOGPSDO_LOCKED, 2390);
+    ifail |= GpsdoExpect(&gd, t += 1000000, ++pps, 0, 2390, eDCOGPSDO_HOLDOVER, 2390);
+    ifail |= GpsdoExpect(&gd, t += 100000000, pps, 0, 2390, eDCOGPSDO_HOLDOVER, 2390);
+    ifail |= GpsdoExpect(&gd, t += 1000000, ++pps, 1, 2388, eDCOGPSDO_LOCKED, 2388);
+    PioDCOGpsdoReset(&gd, eDCOGPSDO_OFF);
+    ifail |= GpsdoExpect(&gd, t += 1000000, ++pps, 1, 2388, eDCOGPSDO_OFF, 0);
+    ifail |= gd._i64_scale != 0;
+
+    printf("GPSDO:      acquisition, slew %d ppb/PPS, holdover & recovery %s\n",
+           eDCOGpsdoSlewPPB, ifail ? "FAILED" : "OK");
+
+    return u64failures + ifail;
+}
+
+/* The sink of the worker loops: PIO model plus the tick the last switch of the
+   cycles in work has come out at. */
+typedef struct
+{
+    PioSim _sim;                /* PIO model the words go to. */
+    const PioDcoWork *_pw;      /* The worker state, its cycles in work. */
+    int32_t _i32_cycles;        /* The cycles in work of the last word. */
+    uint64_t _u64_switch;       /* PIO tick of the start of the word they switched at. */
+
+} SimSink;
+
+/// @brief Puts the word to PIO model and notes the switch of cycles in work.
+static inline void SimPut(void *pctx, uint32_t ui32wc)
+{
+    SimSink *pss = (SimSink *)pctx;
+    if(pss->_pw->_i32_cycles != pss->_i32_cycles)
+    {
+        pss->_i32_cycles = pss->_pw->_i32_cycles;
+        pss->_u64_switch = pss->_sim._u64_tick;
+    }
+    PioSimPut(&pss->_sim, ui32wc);
+}
+
+/// @brief Calculates random cycles per PI less PIO delay in the range of DCO.
+static int32_t RandomCycles(uint32_t *pui32seed, uint32_t ui32clk_hz)
+{
+    const uint32_t ui32lo = (ui32clk_hz >> 8) + 1;
+    const uint32_t ui32hi = ui32clk_hz >> 3;
+    *pui32seed = *pui32seed * 1664525U + 1013904223U;
+    const uint32_t hz = ui32lo + *pui32seed % (ui32hi - ui32lo);
+
+    return PioDCOModCyclesPerPi(ui32clk_hz, hz, 0) - (eSimDelayCycles<<24);
+}
+
+/// @brief Runs the worker loops of dcowork.h with time tagged events at random ticks
+/// @brief & freqs, per word & batched as PioDCOWorker2 does, for every modulator. The
+/// @brief word a switch comes out at in PIO model should start within 1 output cycle
+/// @brief of the tick, plus the dither of modulator past it, and the error the worker
+/// @brief reports should be that of the model.
+/// @param ui32clk_hz The CPU CLK freq., Hz.
+/// @return The count of failures.
+static uint64_t CheckEvents(uint32_t ui32clk_hz)
+{
+    static const enum PioDcoModulator mods[] = { eDCOMOD_FIRST_ORDER, eDCOMOD_MASH111,
+                                                 eDCOMOD_HIRES };
+    static const uint32_t batches[] = { 1, eDCOWorkMaxBatch };
+    static const char *names[] = { "first order", "MASH 1-1-1", "high resolution" };
+    const uint32_t ui32events = 20000;
+
+    uint64_t u64failures = 0;
+    for(int m = 0; m < 3; ++m)
+    {
+        for(int b = 0; b < 2; ++b)
+        {
+            static PioDcoCtl ctl;
+            static PioDcoWork work;
+            static SimSink sink;
+            memset(&ctl, 0, sizeof(ctl));
+            memset(&work, 0, sizeof(work));
+            PioSimInit(&sink._sim, 32, 1., NULL);
+            sink._pw = &work;
+            sink._i32_cycles = 0;
+
+            uint32_t ui32seed = 12345;
+            ctl._modulator = mods[m];
+            ctl._mbox._i32_cycles = RandomCycles(&ui32seed, ui32clk_hz);
+            ctl._mbox._ui32_seq = 2;
+            PioDCOCtlNotify(&ctl);
+
+            uint64_t u64ticks[eDCOEventQueueLen];
+            uint64_t u64tick = 0;
+            uint32_t ui32pushed = 0, ui32checked = 0;
+            int32_t i32err_min = 0, i32err_max = 0;
+            double max_cycles = 0.;
+            while(ui32checked < ui32events)
+            {
+                /* RPix: The producer keeps the queue full, the gaps are 2 to 200
+                   words of the slowest freq. at least, so every event is due alone. */
+                PioDcoEventQueue *pq = &ctl._evq;
+                while(ui32pushed < ui32events && ui32pushed - pq->_ui32_tail < eDCOEventQueueLen)
+                {
+                    ui32seed = ui32seed * 1664525U + 1013904223U;
+                    u64tick += 2048 + ui32seed % (200U * 1024U);
+                    if(u64tick < work._u64_tick + 2048)
+                    {
+                        u64tick = work._u64_tick + 2048;
+                    }
+
+                    int32_t i32cycles;
+                    do
+                    {
+                        i32cycles = RandomCycles(&ui32seed, ui32clk_hz);
+                    }
+                    while(i32cycles == pq->_events[(ui32pushed - 1) & (eDCOEventQueueLen - 1)]._i32_cycles);
+
+                    PioDcoEvent *pev = &pq->_events[ui32pushed & (eDCOEventQueueLen - 1)];
+                    pev->_u64_tick = u64tick;
+                    pev->_i32_cycles = i32cycles;
+                    u64ticks[ui32pushed & (eDCOEventQueueLen - 1)] = u64tick;
+                    pq->_ui32_head = ++ui32pushed;
+                    PioDCOCtlNotify(&ctl);
+                }
+
+                const uint32_t ui32applied = pq->_ui32_applied;
+                const int32_t i32cycles_before = work._i32_cycles;
+                PioDCORun(&ctl, &work, batches[b], SimPut, &sink);
+                if(pq->_ui32_applied == ui32applied)
+                {
+                    continue;
+                }
+
+                /* RPix: The word before the switch started ere tick - a half word,
+                   the word of the switch starts at tick - a half word at most. */
+                const uint64_t u64ev = u64ticks[ui32applied & (eDCOEventQueueLen - 1)];
+                const int32_t i32err = (int32_t)(sink._u64_switch - u64ev);
+                const int32_t i32half = (((uint32_t)i32cycles_before >> 24) + eSimDelayCycles) << 1;
+                const int32_t i32dither = eDCOMOD_MASH111 == mods[m] ? 16 : 4;
+                if(pq->_ui32_applied != ui32applied + 1 || i32err < -i32half
+                   || i32err >= i32half + i32dither || i32err != pq->_i32_last_err_ticks)
+                {
+                    if(u64failures < 10)
+                    {
+                        printf("Event %u of %s, batch %u: at %llu, error %d ticks, reported %d, "
+                               "half word %d\n", ui32applied, names[m], batches[b],
+                               (unsigned long long)u64ev, i32err, pq->_i32_last_err_ticks, i32half);
+                    }
+                    ++u64failures;
+                }
+
+                if(i32err < i32err_min) i32err_min = i32err;
+                if(i32err > i32err_max) i32err_max = i32err;
+                const double cycles = fabs((double)i32err) / i32half;
+                if(cycles > max_cycles) max_cycles = cycles;
+                ++ui32checked;
+            }
+
+            if(work._u64_tick != sink._sim._u64_tick)
+            {
+                printf("Output tick of %s, batch %u: %llu vs %llu of PIO model\n", names[m],
+                       batches[b], (unsigned long long)work._u64_tick,
+                       (unsigned long long)sink._sim._u64_tick);
+                ++u64failures;
+            }
+
+            printf("Events:     %u of %s, batch %u, error %d...%d ticks, max %.3f output cycles\n",
+                   ui32checked, names[m], batches[b], i32err_min, i32err_max, max_cycles);
+        }
+    }
+
+    printf("Checked:    %llu failures\n", (unsigned long long)u64failures);
+
+    return u64failures;
+}
+
+/* The sink of the ramp check: PIO model plus the phase of output against the one
+   of ideal linear chirp. */
+typedef struct
+{
+    PioSim _sim;                /* PIO model the words go to. */
+    const PioDcoWork *_pw;      /* The worker state, its ramp in work. */
+    double _start_hz;           /* The ramp start freq., Hz per tick. */
+    double _rate;               /* The ramp rate, Hz per tick per tick. */
+    uint64_t _u64_cycles;       /* Output cycles put. */
+    double _max_err;            /* Max phase error, output cycles. */
+    uint64_t _u64_end;          /* PIO tick the ramp has ended at, 0 if not yet. */
+
+} RampSink;
+
+/// @brief Puts the word to PIO model and checks the phase at its end.
+static inline void RampPut(void *pctx, uint32_t ui32wc)
+{
+    RampSink *prs = (RampSink *)pctx;
+    if(prs->_u64_end)
+    {
+        PioSimPut(&prs->_sim, ui32wc);
+        return;
+    }
+    if(eDCORAMP_OFF == prs->_pw->_ramp_mode)
+    {
+        prs->_u64_end = prs->_sim._u64_tick;
+    }
+    PioSimPut(&prs->_sim, ui32wc);
+
+    /* RPix: Every word is 2 periods of output. */
+    prs->_u64_cycles += 2;
+    const double t = (double)prs->_sim._u64_tick;
+    const double err = fabs(prs->_u64_cycles - t * (prs->_start_hz + .5 * prs->_rate * t));
+    if(err > prs->_max_err)
+    {
+        prs->_max_err = err;
+    }
+}
+
+/// @brief Runs the ramps of PioDCORampStart, narrow & wide, up & down, through the
+/// @brief worker loop of dcowork.h & PIO model. The phase of output should follow the
+/// @brief one of linear chirp within 1 output cycle, that is the freq. is linear in
+/// @brief time, and the ramp should end within 0.1% of its duration.
+/// @param ui32clk_hz The CPU CLK freq., Hz.
+/// @return The count of failures.
+static uint64_t CheckRamp(uint32_t ui32clk_hz)
+{
+    static const uint32_t ramps[][3] =
+    {
+        { 7000000, 7200000, 50 }, { 7200000, 7000000, 50 },
+        { 14000000, 14000500, 200 }, { 28000000, 29700000, 20 },
+        { 1100000, 33000000, 20 }, { 33000000, 1100000, 20 }
+    };
+
+    uint64_t u64failures = 0;
+    for(size_t i = 0; i < sizeof(ramps) / sizeof(ramps[0]); ++i)
+    {
+        const uint32_t ui32start_hz = ramps[i][0], ui32stop_hz = ramps[i][1];
+        const uint32_t ui32span_hz = ui32start_hz > ui32stop_hz ? ui32start_hz - ui32stop_hz
+                                                                : ui32stop_hz - ui32start_hz;
+        static PioDcoCtl ctl;
+        static PioDcoWork work;
+        static RampSink sink;
+        memset(&ctl, 0, sizeof(ctl));
+        memset(&work, 0, sizeof(work));
+        memset(&sink, 0, sizeof(sink));
+        PioSimInit(&sink._sim, 32, 1., NULL);
+        sink._pw = &work;
+        const double ticks = (double)ramps[i][2] * ui32clk_hz / 1000.;
+        sink._start_hz = (double)ui32start_hz / ui32clk_hz;
+        sink._rate = ((double)ui32stop_hz - ui32start_hz) / ui32clk_hz / ticks;
+
+        const int32_t i32start = PioDCOModCyclesPerPi(ui32clk_hz, ui32start_hz, 0)
+                                 - (eSimDelayCycles<<24);
+        const int32_t i32stop = PioDCOModCyclesPerPi(ui32clk_hz, ui32stop_hz, 0)
+                                - (eSimDelayCycles<<24);
+        uint32_t ui32rate, ui32shift;
+        if(PioDCORampRate(ui32clk_hz, ui32span_hz, ramps[i][2], &ui32rate, &ui32shift))
+        {
+            printf("Ramp %u...%u Hz: no rate\n", ui32start_hz, ui32stop_hz);
+            ++u64failures;
+            continue;
+        }
+        ctl._mbox._i32_cycles = i32start;
+        ctl._mbox._ui32_seq = 2;
+        ctl._ramp._mode = eDCORAMP_ONCE;
+        ctl._ramp._i64_start = (int64_t)i32start << 32;
+        ctl._ramp._i64_stop = (int64_t)i32stop << 32;
+        ctl._ramp._ui32_rate = ui32rate;
+        ctl._ramp._ui32_rate_shift = ui32shift;
+        ctl._ramp._ui32_seq = 2;
+        PioDCOCtlNotify(&ctl);
+
+        while(!sink._u64_end && sink._sim._u64_tick < 2. * ticks)
+        {
+            PioDCORun(&ctl, &work, 1, RampPut, &sink);
+        }
+
+        const double dur_err = sink._u64_end ? ((double)sink._u64_end - ticks) / ticks : 1.;
+        const int ifail = sink._max_err > 1. || fabs(dur_err) > 1e-3;
+        printf("Ramp:       %u...%u Hz in %u ms, phase error %.3f output cycles, duration "
+               "error %+.2e %s\n", ui32start_hz, ui32stop_hz, ramps[i][2], sink._max_err,
+               dur_err, ifail ? "FAILED" : "OK");
+        u64failures += ifail;
+    }
+
+    printf("Checked:    %llu failures\n", (unsigned long long)u64failures);
+
+    return u64failures;
+}
+
+/* The sink of the phase step check: PIO model plus the phase of output against the
+   one of free running DCO shifted by the phase the worker reports applied. */
+typedef struct
+{
+    PioSim _sim;                /* PIO model the words go to. */
+    const PioDcoCtl *_pc;       /* The requests, the phase applied in them. */
+    double _frq;                /* The output freq., cycles per tick. */
+    uint64_t _u64_cycles;       /* Output cycles put. */
+    double _max_err;            /* Max phase error, ticks. */
+
+} PhaseSink;
+
+/// @brief Puts the word to PIO model and checks the phase at its end.
+static inline void PhasePut(void *pctx, uint32_t ui32wc)
+{
+    PhaseSink *pps = (PhaseSink *)pctx;
+    PioSimPut(&pps->_sim, ui32wc);
+
+    /* RPix: Every word is 2 periods of output; the phase is that modulo turn. */
+    pps->_u64_cycles += 2;
+    double err = pps->_u64_cycles - (double)pps->_sim._u64_tick * pps->_frq
+                 - pps->_pc->_ui32_phase_applied / 0x1p32;
+    err = fabs(err - floor(err + .5)) / pps->_frq;
+    if(err > pps->_max_err)
+    {
+        pps->_max_err = err;
+    }
+}
+
+/// @brief Runs the phase steps of PioDCOPhaseStep, advances & retards up to a turn,
+/// @brief through the worker loop of dcowork.h & PIO model at the lowest freq. of
+/// @brief PioDCOSetFreq and above, for every modulator. The step should be applied
+/// @brief within 32 words, and the output phase should be that of free running DCO
+/// @brief plus the phase applied within the dither of modulator.
+/// @param ui32clk_hz The CPU CLK freq., Hz.
+/// @return The count of failures.
+static uint64_t CheckPhaseSteps(uint32_t ui32clk_hz)
+{
+    static const char *names[] = { "first order", "MASH 1-1-1", "high resolution" };
+    static const int32_t steps[][2] = { { 1, 1 }, { -1, 1 }, { 1, 2 }, { -1, 2 },
+                                        { 255, 8 }, { -255, 8 }, { -1, 8 }, { 1, 32 } };
+    const uint32_t frqs[] = { (ui32clk_hz >> 9) + 1U, 550000, 1000000, 7040000, ui32clk_hz >> 4 };
+
+    uint64_t u64failures = 0;
+    for(size_t i = 0; i < sizeof(frqs) / sizeof(frqs[0]); ++i)
+    {
+        for(int m = 0; m < 3; ++m)
+        {
+            static PioDcoCtl ctl;
+            static PioDcoWork work;
+            static PhaseSink sink;
+            memset(&ctl, 0, sizeof(ctl));
+            memset(&work, 0, sizeof(work));
+            memset(&sink, 0, sizeof(sink));
+            PioSimInit(&sink._sim, 32, 1., NULL);
+            sink._pc = &ctl;
+
+            /* RPix: The count of the lowest freq. is above 2^31, as PioDCOSetFreq sets. */
+            const uint32_t ui32reg = (uint32_t)PioDCOModCyclesPerPi(ui32clk_hz, frqs[i], 0)
+                                     - ((uint32_t)eSimDelayCycles << 24);
+            sink._frq = 0x1p24 / (2. * ((double)ui32reg + 0x1p24 * eSimDelayCycles));
+            ctl._mbox._i32_cycles = (int32_t)ui32reg;
+            ctl._mbox._ui32_seq = 2;
+            ctl._modulator = (enum PioDcoModulator)m;
+            PioDCOCtlNotify(&ctl);
+
+            uint32_t ui32late = 0, ui32max_words = 0;
+            for(size_t k = 0; k < sizeof(steps) / sizeof(steps[0]); ++k)
+            {
+                ctl._ui32_phase_req += (uint32_t)((uint64_t)(uint32_t)steps[k][0]
+                                                  << (32 - steps[k][1]));
+                PioDCOCtlNotify(&ctl);
+
+                uint32_t ui32words = 0;
+                while(ctl._ui32_phase_applied != ctl._ui32_phase_req && ui32words < 64)
+                {
+                    PioDCORun(&ctl, &work, 1, PhasePut, &sink);
+                    ++ui32words;
+                }
+                ui32late += ctl._ui32_phase_applied != ctl._ui32_phase_req || ui32words > 32;
+                if(ui32words > ui32max_words)
+                {
+                    ui32max_words = ui32words;
+                }
+                for(int n = 0; n < 256; ++n)
+                {
+                    PioDCORun(&ctl, &work, 1, PhasePut, &sink);
+                }
+            }
+
+            /* RPix: A count is 4 ticks, MASH dithers the word by 3 counts. */
+            const bool bmash = eDCOMOD_MASH111 == m
+                               && ui32reg >= ((uint32_t)eDCOModMashMinCycles << 24);
+            const double max_ticks = (bmash ? 3. : 1.) * eDCOPlanTieTicks;
+            const int ifail = ui32late || sink._max_err > max_ticks;
+            printf("Phase:      %u Hz, %s, %u words at most per step, error %.3f ticks %s\n",
+                   frqs[i], names[m], ui32max_words, sink._max_err, ifail ? "FAILED" : "OK");
+            u64failures += ifail;
+        }
+    }
+
+    printf("Checked:    %llu failures\n", (unsigned long long)u64failures);
+
+    return u64failures;
+}
+
+enum
+{
+    eSimDmaHalfLen = 256        /* Must match eDCODmaHalfLen of piodco.h. */
+};
+
+/* The sink which stores the words to the buffer and runs the script of requests
+   at every half of DMA buffer, where DMA engine is betwixt the refills too. */
+typedef struct
+{
+    uint32_t *_pui32_words;     /* The words put. */
+    uint32_t _ui32_n;           /* Count of them. */
+    uint64_t _u64_tick;         /* Output tick of the end of the words put. */
+    PioDcoCtl *_pc;             /* The requests the script posts. */
+    uint32_t _ui32_seed;        /* Random state of the script. */
+    uint32_t _ui32_requests;    /* Count of requests posted. */
+
+} ScriptSink;
+
+/// @brief Posts the random request as core0 would: a freq., a time tagged event,
+/// @brief a ramp or its stop, a phase step or a modulator, or nothing at all.
+static void ScriptStep(ScriptSink *pss, uint32_t ui32clk_hz)
+{
+    PioDcoCtl *pc = pss->_pc;
+    uint32_t *pseed = &pss->_ui32_seed;
+    *pseed = *pseed * 1664525U + 1013904223U;
+    switch((*pseed >> 16) % 16U)
+    {
+        case 0:
+        {
+            const int32_t i32cycles = RandomCycles(pseed, ui32clk_hz);
+            *pseed = *pseed * 1664525U + 1013904223U;
+            pc->_mbox._ui32_seq = pc->_mbox._ui32_seq + 1U;
+            pc->_mbox._i32_cycles = i32cycles;
+            pc->_mbox._ui32_cycles_ext = *pseed;
+            pc->_mbox._ui32_seq = pc->_mbox._ui32_seq + 1U;
+            break;
+        }
+
+        case 1:
+        case 2:
+        {
+            PioDcoEventQueue *pq = &pc->_evq;
+            if(pq->_ui32_head - pq->_ui32_tail == eDCOEventQueueLen)
+            {
+                return;
+            }
+            const int32_t i32cycles = RandomCycles(pseed, ui32clk_hz);
+            *pseed = *pseed * 1664525U + 1013904223U;
+            PioDcoEvent *pev = &pq->_events[pq->_ui32_head & (eDCOEventQueueLen - 1)];
+            pev->_u64_tick = pss->_u64_tick + *pseed % (4U * eSimDmaHalfLen * 1024U);
+            pev->_i32_cycles = i32cycles;
+            pq->_ui32_head = pq->_ui32_head + 1U;
+            break;
+        }
+
+        case 3:
+        {
+            const int64_t i64start = (int64_t)RandomCycles(pseed, ui32clk_hz) << 32;
+            const int64_t i64stop = (int64_t)RandomCycles(pseed, ui32clk_hz) << 32;
+            const double span_hz = fabs(ui32clk_hz / (2. * (i64start / 0x1p56 + eSimDelayCycles))
+                                        - ui32clk_hz / (2. * (i64stop / 0x1p56 + eSimDelayCycles)));
+            *pseed = *pseed * 1664525U + 1013904223U;
+            uint32_t ui32rate, ui32shift;
+            if(PioDCORampRate(ui32clk_hz, (uint32_t)span_hz + 1U, 1U + *pseed % 8U,
+                              &ui32rate, &ui32shift))
+            {
+                return;
+            }
+            pc->_ramp._ui32_seq = pc->_ramp._ui32_seq + 1U;
+            pc->_ramp._i64_start = i64start;
+            pc->_ramp._i64_stop = i64stop;
+            pc->_ramp._ui32_rate = ui32rate;
+            pc->_ramp._ui32_rate_shift = ui32shift;
+            pc->_ramp._mode = (enum PioDcoRampMode)(1 + (*pseed >> 24) % 3U);
+            pc->_ramp._ui32_seq = pc->_ramp._ui32_seq + 1U;
+            break;
+        }
+
+        case 4:
+            pc->_ramp._ui32_seq = pc->_ramp._ui32_seq + 1U;
+            pc->_ramp._mode = eDCORAMP_OFF;
+            pc->_ramp._ui32_seq = pc->_ramp._ui32_seq + 1U;
+            break;
+
+        case 5:
+            *pseed = *pseed * 1664525U + 1013904223U;
+            pc->_ui32_phase_req = pc->_ui32_phase_req + *pseed;
+            break;
+
+        case 6:
+            pc->_modulator = (enum PioDcoModulator)((*pseed >> 24) % 3U);
+            break;
+
+        default:
+            return;
+    }
+
+    ++pss->_ui32_requests;
+    PioDCOCtlNotify(pc);
+}
+
+/// @brief Stores the word and runs the script at the end of every half of DMA buffer.
+static inline void ScriptPut(void *pctx, uint32_t ui32wc)
+{
+    ScriptSink *pss = (ScriptSink *)pctx;
+    pss->_pui32_words[pss->_ui32_n++] = ui32wc;
+    pss->_u64_tick += (uint64_t)(ui32wc + eSimDelayCycles) << 2U;
+    if(!(pss->_ui32_n % eSimDmaHalfLen))
+    {
+        ScriptStep(pss, 270000000UL);
+    }
+}
+
+/// @brief Runs one engine of words over the script of requests.
+/// @param ui32engine 0 word by word with the slow path every word, 1 batched as
+/// @param ui32engine PioDCOWorker2, 2 by halves of DMA buffer as PioDCOFillHalf.
+/// @param pui32words The buffer of words.
+/// @param ui32n The count of words to run.
+/// @param pc Ptr to the requests, reset here.
+/// @param pw Ptr to worker state, reset here.
+/// @return The count of requests posted.
+static uint32_t RunEngine(uint32_t ui32engine, uint32_t *pui32words, uint32_t ui32n,
+                          PioDcoCtl *pc, PioDcoWork *pw)
+{
+    memset(pc, 0, sizeof(PioDcoCtl));
+    memset(pw, 0, sizeof(PioDcoWork));
+
+    ScriptSink ss = { pui32words, 0, 0, pc, 12345, 0 };
+    pc->_mbox._i32_cycles = RandomCycles(&ss._ui32_seed, 270000000UL);
+    pc->_mbox._ui32_seq = 2;
+    PioDCOCtlNotify(pc);
+
+    if(2 == ui32engine)
+    {
+        /* RPix: The refill sees the requests posted ere it, as IRQ handler does. */
+        for(uint32_t i = 0; i < ui32n; i += eSimDmaHalfLen)
+        {
+            PioDCORender(pc, pw, pui32words + i, eSimDmaHalfLen);
+            for(uint32_t k = 0; k < eSimDmaHalfLen; ++k)
+            {
+                ss._u64_tick += (uint64_t)(pui32words[i + k] + eSimDelayCycles) << 2U;
+            }
+            ss._ui32_n += eSimDmaHalfLen;
+            ScriptStep(&ss, 270000000UL);
+        }
+        return ss._ui32_requests;
+    }
+
+    const uint32_t ui32max = ui32engine ? eDCOWorkMaxBatch : 1;
+    while(ss._ui32_n < ui32n)
+    {
+        /* RPix: Word by word the slow path runs every word, it's the reference. */
+        if(!ui32engine)
+        {
+            pw->_ui32_budget = 0;
+        }
+
+        const uint32_t ui32left = ui32n - ss._ui32_n;
+        PioDCORun(pc, pw, ui32left < ui32max ? ui32left : ui32max, ScriptPut, &ss);
+    }
+
+    return ss._ui32_requests;
+}
+
+/// @brief Runs the worker loops word by word, batched as PioDCOWorker2 does and by
+/// @brief halves of DMA buffer as PioDCOFillHalf does, over the same random script of
+/// @brief requests of every kind posted at the ends of halves. The words should match.
+/// @return The count of failures.
+static uint64_t CheckEngines(void)
+{
+    const uint32_t ui32n = 1U << 22;
+    static const char *names[] = { "word by word", "PioDCOWorker2", "PioDCOFillHalf" };
+    uint32_t *pui32words[3];
+    uint32_t ui32requests[3];
+    static PioDcoCtl ctl[3];
+    static PioDcoWork work[3];
+
+    uint64_t u64failures = 0;
+    for(uint32_t e = 0; e < 3; ++e)
+    {
+        pui32words[e] = malloc(ui32n * sizeof(uint32_t));
+        if(!pui32words[e])
+        {
+            perror("malloc");
+            return 1;
+        }
+        ui32requests[e] = RunEngine(e, pui32words[e], ui32n, &ctl[e], &work[e]);
+    }
+
+    printf("Script:     %u requests, %u events applied\n", ui32requests[0], ctl[0]._evq._ui32_applied);
+
+    for(uint32_t e = 1; e < 3; ++e)
+    {
+        uint32_t ui32diff = 0;
+        for(uint32_t i = 0; i < ui32n; ++i)
+        {
+            if(pui32words[e][i] != pui32words[0][i] && !ui32diff++)
+            {
+                printf("%s: word %u is %u, %u word by word\n", names[e], i,
+                       pui32words[e][i], pui32words[0][i]);
+            }
+        }
+        if(work[e]._u64_tick != work[0]._u64_tick || work[e]._ui32_word != work[0]._ui32_word
+           || ui32requests[e] != ui32requests[0] || ctl[e]._evq._ui32_applied != ctl[0]._evq._ui32_applied)
+        {
+            printf("%s: output tick %llu, %llu word by word\n", names[e],
+                   (unsigned long long)work[e]._u64_tick, (unsigned long long)work[0]._u64_tick);
+            ++ui32diff;
+        }
+
+        printf("Engines:    %s vs word by word, %u words, %u mismatches\n", names[e], ui32n, ui32diff);
+        u64failures += ui32diff;
+    }
+
+    for(uint32_t e = 0; e < 3; ++e)
+    {
+        free(pui32words[e]);
+    }
+
+    return u64failures;
+}
+
+enum
+{
+    eSimSpurLog2 = 20,          /* Log2 of rising edges the spectrum is taken of. */
+    eSimSpurSkipBins = 8,       /* Bins of main lobe of window & trend skipped. */
+    eSimSpurCloseHz = 100000    /* Offset the close-in spurs are searched within. */
+};
+
+/// @brief In place radix-2 FFT.
+/// @param pre Real parts.
+/// @param pim Imaginary parts.
+/// @param ilog2 Log2 of length.
+static void Fft(double *pre, double *pim, int ilog2)
+{
+    const uint32_t n = 1U << ilog2;
+    for(uint32_t i = 1, j = 0; i < n; ++i)
+    {
+        uint32_t bit = n >> 1;
+        for(; j & bit; bit >>= 1)
+        {
+            j ^= bit;
+        }
+        j ^= bit;
+        if(i < j)
+        {
+            double t = pre[i]; pre[i] = pre[j]; pre[j] = t;
+            t = pim[i]; pim[i] = pim[j]; pim[j] = t;
+        }
+    }
+
+    for(uint32_t len = 2; len <= n; len <<= 1)
+    {
+        const double ang = -2. * M_PI / len;
+        for(uint32_t i = 0; i < n; i += len)
+        {
+            for(uint32_t k = 0; k < len / 2; ++k)
+            {
+                const double wr = cos(ang * k), wi = sin(ang * k);
+                const uint32_t a = i + k, b = i + k + len / 2;
+                const double xr = pre[b] * wr - pim[b] * wi;
+                const double xi = pre[b] * wi + pim[b] * wr;
+                pre[b] = pre[a] - xr; pim[b] = pim[a] - xi;
+                pre[a] += xr; pim[a] += xi;
+            }
+        }
+    }
+}
+
+/// @brief Finds the worst spurs of the output of PioDCOWorker2 loop: the phase error
+/// @brief of rising edges is detrended, Blackman-Harris windowed & transformed, the
+/// @brief line of phase amplitude b at offset f is a pair of sidebands of 20lg(b/2) dBc.
+/// @param ui32clk_hz The CPU CLK freq., Hz.
+/// @param ui32frq_hz The freq., Hz.
+/// @param i32frq_millihz The freq. additive shift, mHz.
+/// @param bmash MASH 1-1-1 instead of the first order modulator.
+/// @param pdbc The worst spur, dBc; [1] within eSimSpurCloseHz.
+/// @param pf_hz Its offset, Hz; [1] within eSimSpurCloseHz.
+static void SpurMetric(uint32_t ui32clk_hz, uint32_t ui32frq_hz, int32_t i32frq_millihz,
+                       int bmash, double pdbc[2], double pf_hz[2])
+{
+    const uint32_t n = 1U << eSimSpurLog2;
+    double *pre = calloc(n, sizeof(double));
+    double *pim = calloc(n, sizeof(double));
+    if(!pre || !pim)
+    {
+        perror("calloc");
+        exit(1);
+    }
+
+    const uint32_t ui32reg = PioDCOModCyclesPerPi(ui32clk_hz, ui32frq_hz, i32frq_millihz)
+                             - (eSimDelayCycles<<24);
+    const double period = 1e3 * ui32clk_hz / (1e3 * ui32frq_hz + i32frq_millihz);
+    int32_t i32acc = 0;
+    PioDcoMash mash = {0};
+    uint64_t u64tick = 0;
+    for(uint32_t i = 0; i < n; i += 2)
+    {
+        const uint32_t ui32wc = bmash && ui32reg >= ((uint32_t)eDCOModMashMinCycles << 24U)
+                              ? PioDCOModMash111(ui32reg, &mash) : PioDCOModFirstOrder(ui32reg, &i32acc);
+
+        /* RPix: 2 rising edges per word, 2 half periods apart. */
+        for(int k = 0; k < 2; ++k)
+        {
+            u64tick += 2ULL * (ui32wc + eSimDelayCycles);
+            pre[i + k] = 2. * M_PI * ((double)u64tick - (i + k + 1) * period) / period;
+        }
+    }
+
+    /* RPix: The least squares line is the mean freq. error & the start phase. */
+    double sx = 0., sy = 0., sxx = 0., sxy = 0.;
+    for(uint32_t i = 0; i < n; ++i)
+    {
+        sx += i; sy += pre[i]; sxx += (double)i * i; sxy += i * pre[i];
+    }
+    const double slope = (n * sxy - sx * sy) / (n * sxx - sx * sx);
+    const double icept = (sy - slope * sx) / n;
+    for(uint32_t i = 0; i < n; ++i)
+    {
+        const double x = 2. * M_PI * i / (n - 1);
+        const double w = .35875 - .48829 * cos(x) + .14128 * cos(2. * x) - .01168 * cos(3. * x);
+        pre[i] = (pre[i] - icept - slope * i) * w;
+    }
+
+    Fft(pre, pim, eSimSpurLog2);
+
+    /* RPix: The edges sample the phase at the output freq.; the coherent gain of
+       the window is .35875. */
+    const double fs = 1e-3 * (1e3 * ui32frq_hz + i32frq_millihz);
+    pdbc[0] = pdbc[1] = -400.;
+    pf_hz[0] = pf_hz[1] = 0.;
+    for(uint32_t k = eSimSpurSkipBins; k < n / 2; ++k)
+    {
+        const double b = 2. * sqrt(pre[k] * pre[k] + pim[k] * pim[k]) / (n * .35875);
+        const double dbc = 20. * log10(b / 2. + 1e-10);
+        const double f = fs * k / n;
+        for(int j = 0; j < 2; ++j)
+        {
+            if(dbc > pdbc[j] && (!j || f <= eSimSpurCloseHz))
+            {
+                pdbc[j] = dbc;
+                pf_hz[j] = f;
+            }
+        }
+    }
+
+    free(pre);
+    free(pim);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t ui32frq_hz = 0;
+    int32_t i32frq_millihz = 0;
+    int32_t i32frq_microhz = 0;
+    uint32_t ui32clk_hz = 270000000UL;
+    uint64_t u64edges = 1000000ULL;
+    int iworker = 2;
+    int bmash = 0;
+    int bhires = 0;
+    double duty_percent = 50.;
+    int bplan = 0;
+    int bcheck_hires = 0;
+    int bcheck_replay = 0;
+    int bcheck_gpsdo = 0;
+    int bcheck_events = 0;
+    int bcheck_ramp = 0;
+    int bcheck_engines = 0;
+    int bspurs = 0;
+    uint32_t ui32gate_ms = 0;
+    const char *pfname = NULL;
+
+    int opt;
+    while(-1 != (opt = getopt(argc, argv, "f:m:u:c:n:w:MXD:o:PUYG:CELWS")))
+    {
+        switch(opt)
+        {
+            case 'f': ui32frq_hz = strtoul(optarg, NULL, 10); break;
+            case 'm': i32frq_millihz = strtol(optarg, NULL, 10); break;
+            case 'u': i32frq_microhz = strtol(optarg, NULL, 10); break;
+            case 'c': ui32clk_hz = strtoul(optarg, NULL, 10); break;
+            case 'n': u64edges = strtoull(optarg, NULL, 10); break;
+            case 'w': iworker = atoi(optarg); break;
+            case 'M': bmash = 1; break;
+            case 'X': bhires = 1; break;
+            case 'D': duty_percent = atof(optarg); break;
+            case 'o': pfname = optarg; break;
+            case 'P': bplan = 1; break;
+            case 'U': bcheck_hires = 1; break;
+            case 'Y': bcheck_replay = 1; break;
+            case 'G': ui32gate_ms = strtoul(optarg, NULL, 10); break;
+            case 'C': bcheck_gpsdo = 1; break;
+            case 'E': bcheck_events = 1; break;
+            case 'L': bcheck_ramp = 1; break;
+            case 'W': bcheck_engines = 1; break;
+            case 'S': bspurs = 1; break;
+            default: Usage(); return 1;
+        }
+    }
+
+    if(bcheck_hires)
+    {
+        return CheckHiRes(ui32clk_hz) ? 1 : 0;
+    }
+
+    if(bcheck_replay)
+    {
+        return CheckReplay(ui32clk_hz) ? 1 : 0;
+    }
+
+    if(bcheck_gpsdo)
+    {
+        return CheckGpsdo(ui32clk_hz) ? 1 : 0;
+    }
+
+    if(bcheck_events)
+    {
+        return CheckEvents(ui32clk_hz) ? 1 : 0;
+    }
+
+    if(bcheck_ramp)
+    {
+        return CheckRamp(ui32clk_hz) ? 1 : 0;
+    }
+
+    if(bcheck_engines)
+    {
+        return CheckEngines() ? 1 : 0;
+    }
+
+    if(bspurs)
+    {
+        if(!ui32frq_hz)
+        {
+            Usage();
+            return 1;
+        }
+
+        static const char *names[] = { "first order", "MASH 1-1-1" };
+        const uint32_t ui32reg = PioDCOModCyclesPerPi(ui32clk_hz, ui32frq_hz, i32frq_millihz)
+                                 - (eSimDelayCycles<<24);
+        for(int i = 0; i < 2; ++i)
+        {
+            double dbc[2], f_hz[2];
+            SpurMetric(ui32clk_hz, ui32frq_hz, i32frq_millihz, i, dbc, f_hz);
+            printf("Spurs of %-11s worst %7.1f dBc at %10.0f Hz, within %d Hz %7.1f dBc at %8.0f Hz%s\n",
+                   names[i], dbc[0], f_hz[0], eSimSpurCloseHz, dbc[1], f_hz[1],
+                   i && ui32reg < ((uint32_t)eDCOModMashMinCycles << 24U) ? ", first order here" : "");
+        }
+
+        return 0;
+    }
+
+    if(ui32gate_ms)
+    {
+        if(!ui32frq_hz)
+        {
+            return CheckMeasure(ui32clk_hz, ui32gate_ms) ? 1 : 0;
+        }
+
+        const uint32_t ui32samples = PioDCOMeasGateSamples(ui32clk_hz, ui32gate_ms);
+        PioDcoMeas meas;
+        PioDCOMeasResult(ui32clk_hz, ui32samples,
+                         CountEdges(ui32clk_hz, ui32frq_hz, i32frq_millihz, ui32samples, 1),
+                         0, 1000ULL * ui32frq_hz + i32frq_millihz, &meas);
+        printf("Edges:      %u over %llu ticks\n", meas._ui32_edges,
+               (unsigned long long)meas._u64_gate_cycles);
+        printf("Measured:   %llu.%03llu Hz, error %lld ppb, resolution %u ppb\n",
+               (unsigned long long)(meas._u64_frq_millihz / 1000ULL),
+               (unsigned long long)(meas._u64_frq_millihz % 1000ULL),
+               (long long)meas._i64_err_ppb, meas._ui32_res_ppb);
+
+        return 0;
+    }
+
+    if(bplan)
+    {
+        if(!ui32frq_hz)
+        {
+            return CheckPlanner(ui32clk_hz) + CheckPhaseSteps(ui32clk_hz) ? 1 : 0;
+        }
+
+        PioDcoPlan plan;
+        if(PioDCOPlanHarmonic(ui32clk_hz, ui32frq_hz, i32frq_millihz, &plan))
+        {
+            printf("The freq. is out of reach\n");
+            return 1;
+        }
+        PrintPlan(ui32frq_hz, i32frq_millihz, &plan);
+
+        return 0;
+    }
+
+    if(!ui32frq_hz || iworker < 2 || iworker > 3 || duty_percent < 0. || duty_percent > 100.)
+    {
+        Usage();
+        return 1;
+    }
+
+    FILE *pfedges = NULL;
+    if(pfname && !(pfedges = fopen(pfname, "w")))
+    {
+        perror(pfname);
+        return 1;
+    }
+
+    /* RPix: The same as PioDCOSetFreq does. */
+    const int32_t i32cycles_per_pi = PioDCOModCyclesPerPi(ui32clk_hz, ui32frq_hz, i32frq_millihz);
+    const uint32_t ui32precise_cycles = i32cycles_per_pi - (eSimDelayCycles<<24);
+
+    /* RPix: The same as PioDCOSetFreqMicroHertz does. */
+    const int32_t i32uhz = 1000 * i32frq_millihz + i32frq_microhz;
+    const uint64_t u64hires_cycles = PioDCOModCyclesPerPiHiRes(ui32clk_hz, ui32frq_hz, i32uhz)
+                                     - ((uint64_t)eSimDelayCycles << 56U);
+    uint64_t u64acc_hires = 0;
+
+    const double ideal_period = 1e6 * ui32clk_hz / (1e6 * ui32frq_hz + (double)i32uhz);
+
+    PioSim sim;
+    PioSimInit(&sim, 3 == iworker ? 8 : 32, ideal_period, pfedges);
+
+    /* RPix: The same as PioDCOWorkerDuty does. */
+    uint32_t ui32regh, ui32regl;
+    int32_t i32acch = 0, i32accl = 0;
+    PioDCOModDutySplit(i32cycles_per_pi, (uint32_t)(duty_percent * 655.36 + .5),
+                       eSimDutyDelayCycles, &ui32regh, &ui32regl);
+    if(3 == iworker)
+    {
+        /* RPix: `dco_duty` starts every word with the high level. */
+        sim._delay = eSimDutyDelayCycles;
+        sim._level = 1;
+    }
+
+    int32_t i32acc_error = 0;
+    PioDcoMash mash = {0};
+    while(sim._u64_edges < u64edges)
+    {
+        if(3 == iworker)
+        {
+            PioSimPut(&sim, PioDCOModDutyWord(ui32regh, ui32regl, &i32acch, &i32accl));
+        }
+        else
+        {
+            /* RPix: PioDCOWorker2 loop. */
+            if(bhires)
+            {
+                PioSimPut(&sim, PioDCOModFirstOrderHiRes((uint32_t)(u64hires_cycles >> 32U),
+                                                         (uint32_t)u64hires_cycles, &u64acc_hires));
+            }
+            else if(bmash && ui32precise_cycles >= ((uint32_t)eDCOModMashMinCycles << 24U))
+            {
+                PioSimPut(&sim, PioDCOModMash111(ui32precise_cycles, &mash));
+            }
+            else
+            {
+                PioSimPut(&sim, PioDCOModFirstOrder(ui32precise_cycles, &i32acc_error));
+            }
+        }
+    }
+
+    if(pfedges)
+    {
+        fclose(pfedges);
+    }
+
+    printf("DCO frequency:         %lu Hz + %ld uHz, sysclk %lu Hz, worker %d%s\n",
+           (unsigned long)ui32frq_hz, (long)i32uhz, (unsigned long)ui32clk_hz,
+           iworker, bhires ? " high resolution" : bmash ? " MASH 1-1-1" : "");
+    PioSimReport(&sim, ui32clk_hz, stdout);
+    if(2 == iworker && !bhires)
+    {
+        double dbc[2], f_hz[2];
+        SpurMetric(ui32clk_hz, ui32frq_hz, i32frq_millihz, bmash, dbc, f_hz);
+        printf("Worst spur:            %.1f dBc at %.0f Hz, within %d Hz %.1f dBc at %.0f Hz\n",
+               dbc[0], f_hz[0], eSimSpurCloseHz, dbc[1], f_hz[1]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,279 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  holdsim.c - Off-target check of temperature compensated holdover.
+//
+//
+//  DESCRIPTION
+//
+//      The tool replays a trace of the temperature of the on-chip sensor & the
+//  CPU CLK error, one line per PPS `s mC ppb`, through two GPSDO states of
+//  piodco/dcogpsdo.h: one with the temperature model of dcotemp.h, the other with
+//  no model, that is the plain hold. The sensor is sampled 64 times per PPS with
+//  ADC quantization & noise, the estimate of GPS is the error plus 1 ppb noise.
+//  The fix is there for the first hours of the trace, then it's lost for the
+//  holdover hours. Reported per state: the RMS & max error of the correction in
+//  holdover against the true CPU CLK error, and the time error accumulated.
+//      With no trace a synthetic one is made: the crystal lags the ambient by
+//  two minutes, its error is a parabola of temperature & ages; the ambient swings
+//  daily & by HVAC cycles. The run fails unless the model beats the plain hold.
+//      A trace of a board is logged by polling STATUS every second with the fix:
+//  the Temperature & the GPS frequency correction lines.
+//
+//  USAGE
+//      holdsim [-l hours_locked] [-H hours_holdover] [-s seed] [-o trace] [-v] [trace]
+//
+//      -l  Hours with the fix, 48 by default.
+//      -H  Hours of holdover then, 12 by default.
+//      -s  Seed, 1 by default.
+//      -o  Dump the synthetic trace to file.
+//      -v  Dumps the error of each second of holdover, `s temp_ppb hold_ppb`.
+//
+//  PLATFORM
+//      Linux host.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+
+#include "../piodco/dcogpsdo.h"
+
+enum
+{
+    eSamplesPerPPS = 64,                        /* Sensor samples per PPS, GPSDO poll rate. */
+    eStates = 2
+};
+
+typedef struct
+{
+    uint32_t _u32_s;                            /* Seconds. */
+    int32_t _i32_mdeg;                          /* The sensor, mC. */
+    double _dppb;                               /* CPU CLK error. */
+
+} TracePoint;
+
+typedef struct
+{
+    double _dsum, _dmax, _dte_ns;
+    uint32_t _u32_n;
+
+} Result;
+
+static double Gauss(void)
+{
+    return sqrt(-2. * log(1. - drand48())) * cos(2. * M_PI * drand48());
+}
+
+/// @brief Makes the ADC reading of the sensor, the inverse of PioDCOTempFromADC & noise.
+static uint16_t SensorRaw(int32_t i32mdeg)
+{
+    const double dv = .706 - (i32mdeg * 1e-3 - 27.) * .001721;
+    const double draw = dv / 3.3 * 4096. + 1.5 * Gauss();
+
+    return (uint16_t)(draw < 0. ? 0. : draw > 4095. ? 4095. : floor(draw + .5));
+}
+
+/// @brief Makes the synthetic trace.
+static TracePoint *Synth(uint32_t u32n)
+{
+    TracePoint *pt = calloc(u32n, sizeof(TracePoint));
+    double dxtal = 28.;
+    double dwalk = 0.;
+    for(uint32_t k = 0; k < u32n; ++k)
+    {
+        const double t = k;
+        const double damb = 25. + 6. * sin(2. * M_PI * t / 86400.) + 1.5 * sin(2. * M_PI * t / 5400. + 1.);
+        dxtal += (damb + 3. - dxtal) / 120.;    /* The crystal lags. */
+        dwalk += .002 * Gauss();
+
+        pt[k]._u32_s = k;
+        pt[k]._i32_mdeg = (int32_t)lround(1000. * (damb + 8.));  /* The die is warmer. */
+        pt[k]._dppb = 1800. - 150. * (dxtal - 25.) + 4. * (dxtal - 25.) * (dxtal - 25.)
+                      + .2 * t / 3600. + dwalk;
+    }
+
+    return pt;
+}
+
+/// @brief Reads the trace, `s mC ppb` per line.
+static TracePoint *Load(const char *pfname, uint32_t *pu32n)
+{
+    FILE *pf = fopen(pfname, "r");
+    if(!pf)
+    {
+        return NULL;
+    }
+
+    uint32_t u32cap = 86400, n = 0;
+    TracePoint *pt = malloc(u32cap * sizeof(TracePoint));
+    char line[128];
+    while(fgets(line, sizeof(line), pf))
+    {
+        TracePoint p;
+        if(3 != sscanf(line, "%u %d %lf", &p._u32_s, &p._i32_mdeg, &p._dppb))
+        {
+            continue;
+        }
+        if(n == u32cap)
+        {
+            u32cap *= 2;
+            pt = realloc(pt, u32cap * sizeof(TracePoint));
+        }
+        pt[n++] = p;
+    }
+    fclose(pf);
+
+    *pu32n = n;
+    return pt;
+}
+
+int main(int argc, char **argv)
+{
+    double dlocked_h = 48., dhold_h = 12.;
+    long lseed = 1;
+    const char *pdump = NULL;
+    int is_verbose = 0;
+
+    int opt;
+    while(-1 != (opt = getopt(argc, argv, "l:H:s:o:v")))
+    {
+        switch(opt)
+        {
+            case 'l': dlocked_h = atof(optarg); break;
+            case 'H': dhold_h = atof(optarg); break;
+            case 's': lseed = atol(optarg); break;
+            case 'o': pdump = optarg; break;
+            case 'v': is_verbose = 1; break;
+            default:
+                fprintf(stderr, "Usage: holdsim [-l hours_locked] [-H hours_holdover] [-s seed] [-o trace] [-v] [trace]\n");
+                return 1;
+        }
+    }
+
+    srand48(lseed);
+    const int is_synth = optind >= argc;
+    uint32_t u32n = (uint32_t)((dlocked_h + dhold_h) * 3600.);
+    TracePoint *pt = is_synth ? Synth(u32n) : Load(argv[optind], &u32n);
+    if(!pt || !u32n)
+    {
+        fprintf(stderr, "Can't read %s\n", argv[optind]);
+        return 1;
+    }
+    if(pdump)
+    {
+        FILE *pf = fopen(pdump, "w");
+        for(uint32_t k = 0; pf && k < u32n; ++k)
+        {
+            fprintf(pf, "%u %d %.3f\n", pt[k]._u32_s, pt[k]._i32_mdeg, pt[k]._dppb);
+        }
+        if(pf)
+        {
+            fclose(pf);
+        }
+    }
+
+    /* RPix: State 0 has the model, state 1 is never given the temperature. */
+    static PioDcoGpsdo gd[eStates];
+    Result r[eStates];
+    memset(r, 0, sizeof(r));
+    for(int i = 0; i < eStates; ++i)
+    {
+        PioDCOGpsdoReset(&gd[i], eDCOGPSDO_WAIT);
+    }
+
+    const uint32_t u32s0 = pt[0]._u32_s;
+    const uint32_t u32lost = u32s0 + (uint32_t)(dlocked_h * 3600.);
+    for(uint32_t k = 0; k < u32n; ++k)
+    {
+        const TracePoint *pp = &pt[k];
+        const int is_valid = pp->_u32_s < u32lost;
+        const int64_t i64est = (int64_t)llround(pp->_dppb + Gauss());
+        const uint64_t u64us = 1000000ULL * (pp->_u32_s - u32s0 + 1);
+        for(int j = 0; j < eSamplesPerPPS; ++j)
+        {
+            PioDCOTempSample(&gd[0]._temp, SensorRaw(pp->_i32_mdeg));
+        }
+
+        for(int i = 0; i < eStates; ++i)
+        {
+            PioDCOGpsdoStep(&gd[i], u64us, k + 1, is_valid, i64est);
+            if(is_valid)
+            {
+                continue;
+            }
+
+            const double derr = gd[i]._i64_ppb - pp->_dppb;
+            r[i]._dsum += derr * derr;
+            r[i]._dmax = fabs(derr) > r[i]._dmax ? fabs(derr) : r[i]._dmax;
+            r[i]._dte_ns += derr;               /* ppb * 1 s. */
+            ++r[i]._u32_n;
+        }
+        if(is_verbose && !is_valid)
+        {
+            printf("%u %.3f %.3f\n", pp->_u32_s, gd[0]._i64_ppb - pp->_dppb, gd[1]._i64_ppb - pp->_dppb);
+        }
+    }
+    free(pt);
+
+    if(!r[0]._u32_n)
+    {
+        fprintf(stderr, "No holdover in the trace\n");
+        return 1;
+    }
+
+    static const char *spName[eStates] = { "TEMP", "HOLD" };
+    printf("Holdover:   %u s after %.1f h, model bins %d of %d\n", r[0]._u32_n, dlocked_h,
+           PioDCOTempBinsUsed(&gd[0]._temp), eDCOTempBins);
+    printf("%-10s %10s %10s %12s\n", "state", "RMS ppb", "max ppb", "TE us");
+    for(int i = 0; i < eStates; ++i)
+    {
+        printf("%-10s %10.3f %10.3f %12.3f\n", spName[i], sqrt(r[i]._dsum / r[i]._u32_n), r[i]._dmax,
+               1e-3 * r[i]._dte_ns);
+    }
+
+    int ifail = 0;
+    if(is_synth)
+    {
+        ifail = r[0]._dsum >= r[1]._dsum || fabs(r[0]._dte_ns) >= fabs(r[1]._dte_ns);
+        printf("%s\n", ifail ? "FAILED" : "OK");
+    }
+
+    return ifail;
+}
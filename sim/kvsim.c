@@ -0,0 +1,286 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  kvsim.c - Off-target check of the key/value store in flash.
+//
+//
+//  DESCRIPTION
+//
+//      The tool runs lib/kvstore.h on a RAM-backed stand-in of NOR flash: the
+//  erase sets a sector to 0xFF, the program only clears bits. Random keys are
+//  set & committed; the power is cut at random, in the middle of a program (a
+//  part of the bytes is programmed) or of an erase (the sector is left random),
+//  then the store is reopened as at boot. It should hold the last snapshot
+//  committed, or the one in progress when the power was cut, value by value.
+//      Reported: the commits, the power cuts, the erases per sector (the wear
+//  should be even) & the failures.
+//
+//  USAGE
+//      kvsim [-n commits] [-s seed] [-p cut_per_commits]
+//
+//      -n  Commits, 100000 by default.
+//      -s  Seed, 1 by default.
+//      -p  A power cut per that many commits on average, 20 by default.
+//
+//  PLATFORM
+//      Linux host.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../lib/kvstore.h"
+
+enum
+{
+    eKeys = 12,                                 /* Keys in use. */
+    eMaxLen = 96                                /* Max value length. */
+};
+
+typedef struct
+{
+    uint8_t _mem[eKVregionBytes];
+    uint32_t _u32_erases[eKVsectors];
+    long _lcut;                                 /* Bytes to the power cut, -1 if none. */
+    int is_cut;
+
+} FlashSim;
+
+/* The values of keys: the length, 0 if none, & the bytes. */
+typedef struct
+{
+    uint16_t _u16_len[eKeys];
+    uint8_t _data[eKeys][eMaxLen];
+
+} Shadow;
+
+static int SimErase(void *pctx, uint32_t u32offset)
+{
+    FlashSim *pf = pctx;
+    if(pf->is_cut)
+    {
+        return -1;
+    }
+    ++pf->_u32_erases[u32offset / eKVsectorBytes];
+    if(pf->_lcut >= 0 && pf->_lcut < eKVsectorBytes)
+    {
+        for(int i = 0; i < eKVsectorBytes; ++i)
+        {
+            pf->_mem[u32offset + i] = (uint8_t)lrand48();
+        }
+        pf->is_cut = 1;
+        return -1;
+    }
+    if(pf->_lcut >= 0)
+    {
+        pf->_lcut -= eKVsectorBytes;
+    }
+    memset(pf->_mem + u32offset, 0xFF, eKVsectorBytes);
+
+    return 0;
+}
+
+static int SimProgram(void *pctx, uint32_t u32offset, const uint8_t *pdata, uint32_t u32len)
+{
+    FlashSim *pf = pctx;
+    if(pf->is_cut || u32offset % eKVpageBytes || u32len % eKVpageBytes)
+    {
+        return -1;
+    }
+    for(uint32_t i = 0; i < u32len; ++i)
+    {
+        if(pf->_lcut >= 0 && 0 == pf->_lcut--)
+        {
+            pf->is_cut = 1;
+            return -1;
+        }
+        pf->_mem[u32offset + i] &= pdata[i];    /* NOR: the bits are cleared only. */
+    }
+
+    return 0;
+}
+
+/// @brief Checks the store holds the values of the shadow.
+static int Matches(const KVstore *pkv, const Shadow *ps)
+{
+    uint8_t buf[eMaxLen];
+    for(int k = 0; k < eKeys; ++k)
+    {
+        if(!ps->_u16_len[k])
+        {
+            /* RPix: Deleted, it's of no length. */
+            for(uint16_t len = 0; len <= eMaxLen; ++len)
+            {
+                if(!KVstoreGet(pkv, (uint8_t)(k + 1), buf, len))
+                {
+                    return 0;
+                }
+            }
+            continue;
+        }
+        if(KVstoreGet(pkv, (uint8_t)(k + 1), buf, ps->_u16_len[k]) || memcmp(buf, ps->_data[k], ps->_u16_len[k]))
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t u32n = 100000;
+    long lseed = 1;
+    uint32_t u32cut_every = 20;
+
+    int opt;
+    while(-1 != (opt = getopt(argc, argv, "n:s:p:")))
+    {
+        switch(opt)
+        {
+            case 'n': u32n = strtoul(optarg, NULL, 10); break;
+            case 's': lseed = atol(optarg); break;
+            case 'p': u32cut_every = strtoul(optarg, NULL, 10); break;
+            default:
+                fprintf(stderr, "Usage: kvsim [-n commits] [-s seed] [-p cut_per_commits]\n");
+                return 1;
+        }
+    }
+    srand48(lseed);
+
+    static FlashSim fs;
+    memset(fs._mem, 0xFF, sizeof(fs._mem));
+    fs._lcut = -1;
+    const KVflash flash = { fs._mem, SimErase, SimProgram, &fs };
+
+    static KVstore kv;
+    static Shadow committed, pending;
+    memset(&committed, 0, sizeof(committed));
+    uint32_t u32failures = 0, u32cuts = 0, u32commits = 0;
+    if(1 != KVstoreOpen(&kv, &flash))
+    {
+        printf("The blank flash is not empty\n");
+        ++u32failures;
+    }
+
+    for(uint32_t i = 0; i < u32n; ++i)
+    {
+        /* RPix: A few keys are set or deleted, then committed. */
+        pending = committed;
+        const int nset = 1 + lrand48() % 4;
+        for(int j = 0; j < nset; ++j)
+        {
+            const int k = lrand48() % eKeys;
+            if(0 == lrand48() % 10)
+            {
+                KVstoreDelete(&kv, (uint8_t)(k + 1));
+                pending._u16_len[k] = 0;
+                continue;
+            }
+            const uint16_t u16len = 1 + lrand48() % (k < 3 ? eMaxLen : 8);
+            for(int b = 0; b < u16len; ++b)
+            {
+                pending._data[k][b] = (uint8_t)lrand48();
+            }
+            pending._u16_len[k] = u16len;
+            if(KVstoreSet(&kv, (uint8_t)(k + 1), pending._data[k], u16len))
+            {
+                printf("No room at commit %u\n", i);
+                ++u32failures;
+            }
+        }
+
+        const int is_cut = 0 == lrand48() % u32cut_every;
+        fs._lcut = is_cut ? lrand48() % (eKVsectorBytes + eKVslotBytes) : -1;
+        fs.is_cut = 0;
+        const int ires = KVstoreCommit(&kv);
+        if(ires >= 0)
+        {
+            committed = pending;            /* 1 if nothing has changed, e.g. deleted none. */
+            u32commits += !ires;
+        }
+        if(!is_cut && ires < 0)
+        {
+            printf("Commit %u failed with no power cut\n", i);
+            ++u32failures;
+        }
+        if(!is_cut)
+        {
+            continue;
+        }
+
+        /* RPix: Boot. The snapshot in progress may have made it. */
+        ++u32cuts;
+        fs._lcut = -1;
+        fs.is_cut = 0;
+        KVstoreOpen(&kv, &flash);
+        if(Matches(&kv, &pending))
+        {
+            committed = pending;
+        }
+        else if(!Matches(&kv, &committed))
+        {
+            if(u32failures < 10)
+            {
+                printf("Lost at commit %u, snapshot %u\n", i, kv._u32_seq);
+            }
+            ++u32failures;
+        }
+    }
+
+    uint32_t u32min = 0xFFFFFFFFU, u32max = 0;
+    printf("Commits:    %u, power cuts %u\nErases:    ", u32commits, u32cuts);
+    for(int i = 0; i < eKVsectors; ++i)
+    {
+        printf(" %u", fs._u32_erases[i]);
+        u32min = fs._u32_erases[i] < u32min ? fs._u32_erases[i] : u32min;
+        u32max = fs._u32_erases[i] > u32max ? fs._u32_erases[i] : u32max;
+    }
+    printf("\n");
+
+    /* RPix: A torn slot skips the rest of its sector, so the wear is even within the cuts. */
+    if(u32max - u32min > u32cuts / eKVsectors + 2)
+    {
+        printf("Uneven wear\n");
+        ++u32failures;
+    }
+    printf("%u failures\n%s\n", u32failures, u32failures ? "FAILED" : "OK");
+
+    return u32failures ? 1 : 0;
+}
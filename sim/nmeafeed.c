@@ -0,0 +1,573 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  nmeafeed.c - Off-target check of the NMEA framer of GPS UART DMA ring.
+//
+//
+//  DESCRIPTION
+//
+//      The tool feeds a recorded NMEA stream to GPSrxFrame (gpstime/gpsrx.h) the
+//  way UART RX DMA and GPStimeProcess do: the writer puts random size chunks into
+//  the ring, the reader frames what was received after each one. The sentences
+//  framed should be exactly the lines of the stream. In slow reader mode the
+//  writer laps the reader, the overruns should be detected and every sentence
+//  which got through should still be an intact line of the stream.
+//      Every sentence framed is also parsed by NMEAparse (gpstime/nmea.h), the
+//  lat, lon & unix time decoded are checked against libc reference, so is the
+//  validity of ZDA, which has no status.
+//
+//  USAGE
+//      nmeafeed [-n passes] [-s seed] [-S] file.nmea
+//      nmeafeed -B [-n passes] file.nmea ...
+//
+//      -n  Count of passes of the stream, 100 by default.
+//      -s  Seed of chunk sizes, 1 by default.
+//      -S  Slow reader, the writer laps it from time to time.
+//      -B  Benchmark NMEAparse over the corpus of files given, sentences per
+//          second, against the former strnstr & atof parsing of RMC.
+//
+//  PLATFORM
+//      Linux host.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//      Rev 0.2   16 Oct 2026   NMEA parser check & benchmark.
+//      Rev 0.3   17 Oct 2026   ZDA validity check, sentences of no fix yet.
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <math.h>
+
+#include "../gpstime/gpsrx.h"
+#include "../gpstime/nmea.h"
+
+typedef struct
+{
+    char **_ppsz_lines;                         /* The sentences of the stream. */
+    uint32_t _u32_nlines;
+    uint32_t _u32_ix;                           /* The sentence expected next. */
+    uint32_t _u32_framed;
+    uint32_t _u32_skipped;                      /* Skipped owing to overruns. */
+    uint32_t _u32_bad;
+    uint32_t _u32_parsed[eNMEA_ZDA + 1];        /* Sentences decoded by type. */
+    uint32_t _u32_parse_bad;                    /* Parse errors or mismatches of reference. */
+    int _is_slow;
+
+} FeedContext;
+
+static uint8_t su8Ring[eGPSrxRingLen];
+
+static int CheckSum(const char *psz);
+
+static void Usage(void)
+{
+    fprintf(stderr, "Usage: nmeafeed [-n passes] [-s seed] [-S] file.nmea\n"
+                    "       nmeafeed -B [-n passes] file.nmea ...\n");
+}
+
+/// @brief Loads the file, 0 terminated.
+static char *LoadFile(const char *pfname, long *plsize)
+{
+    FILE *pfs = fopen(pfname, "rb");
+    if(!pfs)
+    {
+        perror(pfname);
+        return NULL;
+    }
+    fseek(pfs, 0, SEEK_END);
+    *plsize = ftell(pfs);
+    fseek(pfs, 0, SEEK_SET);
+    char *pbuf = malloc(*plsize + 1);
+    if(!pbuf || *plsize != (long)fread(pbuf, 1, *plsize, pfs))
+    {
+        fprintf(stderr, "Can't read %s\n", pfname);
+        fclose(pfs);
+        free(pbuf);
+        return NULL;
+    }
+    fclose(pfs);
+    pbuf[*plsize] = 0;
+
+    return pbuf;
+}
+
+/// @brief Splits the stream into the sentences in place, w/o line endings.
+/// @return The count of sentences appended, 0 on error.
+static uint32_t SplitLines(char *pstream, char **ppsz_lines, uint32_t *pu32nlines)
+{
+    const uint32_t u32n0 = *pu32nlines;
+    for(char *ptok = strtok(pstream, "\r\n"); ptok; ptok = strtok(NULL, "\r\n"))
+    {
+        if(CheckSum(ptok))
+        {
+            fprintf(stderr, "Bad sentence in the stream: %s\n", ptok);
+            return 0;
+        }
+        ppsz_lines[(*pu32nlines)++] = ptok;
+    }
+    if(u32n0 == *pu32nlines)
+    {
+        fprintf(stderr, "No sentences in the stream\n");
+    }
+
+    return *pu32nlines - u32n0;
+}
+
+/// @brief Obtains the monotonic time, ns.
+static uint64_t NowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/// @brief Copies the field #ix of the sentence to the buffer of 32 chars.
+static const char *RefField(const char *psz, int ix, char *pbuf)
+{
+    for(; ix && *psz; ++psz)
+    {
+        ix -= ',' == *psz;
+    }
+    int i = 0;
+    for(; i < 31 && psz[i] && ',' != psz[i] && '*' != psz[i]; ++i)
+    {
+        pbuf[i] = psz[i];
+    }
+    pbuf[i] = 0;
+
+    return pbuf;
+}
+
+/// @brief The reference of lat & lon, degrees * 1e7, by libc floating point.
+static double RefDeg1e7(const char *psz, int ix)
+{
+    char buf[32], hemi[32];
+    const double v = atof(RefField(psz, ix, buf));
+    const double deg = (double)(int)(v / 100.) + (v - 100. * (int)(v / 100.)) / 60.;
+    RefField(psz, ix + 1, hemi);
+
+    return ('S' == *hemi || 'W' == *hemi ? -1e7 : 1e7) * deg;
+}
+
+/// @brief Checks the sentence decoded against libc reference.
+/// @return 0 if OK.
+static int CheckParsed(const char *psz, const NMEAsentence *ps)
+{
+    char buf[32];
+    int ipos = -1, itm = -1;
+    struct tm ltm = {0};
+    switch(ps->_type)
+    {
+        case eNMEA_RMC:
+            ipos = 3;
+            itm = 1;
+            ltm.tm_mday = atoi(RefField(psz, 9, buf)) / 10000;
+            ltm.tm_mon = atoi(buf) / 100 % 100 - 1;
+            ltm.tm_year = 100 + atoi(buf) % 100;
+            break;
+
+        case eNMEA_GGA:
+            ipos = 2;
+            break;
+
+        case eNMEA_ZDA:
+        {
+            /* RPix: ZDA has no status, it is valid with both time & date only. */
+            const int ivalid = *RefField(psz, 1, buf) && *RefField(psz, 2, buf)
+                               && *RefField(psz, 3, buf) && *RefField(psz, 4, buf);
+            if(ivalid != ps->_u8_is_valid)
+            {
+                return -1;
+            }
+            itm = 1;
+            ltm.tm_mday = atoi(RefField(psz, 2, buf));
+            ltm.tm_mon = atoi(RefField(psz, 3, buf)) - 1;
+            ltm.tm_year = atoi(RefField(psz, 4, buf)) - 1900;
+            break;
+        }
+
+        default:
+            return 0;
+    }
+
+    if(ipos > 0 && ps->_u8_has_pos)
+    {
+        if(fabs(RefDeg1e7(psz, ipos) - ps->_i32_lat_1e7) > 1.
+           || fabs(RefDeg1e7(psz, ipos + 2) - ps->_i32_lon_1e7) > 1.)
+        {
+            return -1;
+        }
+    }
+
+    if(itm > 0 && ps->_u8_has_date)
+    {
+        const int hhmmss = atoi(RefField(psz, itm, buf));
+        ltm.tm_hour = hhmmss / 10000;
+        ltm.tm_min = hhmmss / 100 % 100;
+        ltm.tm_sec = hhmmss % 100;
+        if((time_t)ps->_u32_unixtime != timegm(&ltm))
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/// @brief The former GPRMC parsing, for the benchmark: strnstr over the line
+/// @brief buffer, commas overwritten over all 256 bytes, atof for lat & lon.
+static int LegacyRMC(uint8_t *pbuff, int64_t *pi64lat_100k, int64_t *pi64lon_100k)
+{
+    uint8_t *prmc = (uint8_t *)strstr((char *)pbuff, "$GPRMC,");
+    if(!prmc)
+    {
+        prmc = (uint8_t *)strstr((char *)pbuff, "$GNRMC,");
+    }
+    if(!prmc)
+    {
+        return 0;
+    }
+
+    uint8_t u8ixcollector[16] = {0};
+    uint8_t chksum = 0;
+    for(uint32_t u8ix = 0, i = 0; u8ix != eGPSrxLineLen; ++u8ix)
+    {
+        uint8_t *p = pbuff + u8ix;
+        chksum ^= *p;
+        if(',' == *p)
+        {
+            *p = 0;
+            u8ixcollector[i++] = u8ix + 1;
+            if(12 == i)
+            {
+                break;
+            }
+        }
+    }
+
+    if('A' == prmc[u8ixcollector[1]])
+    {
+        *pi64lat_100k = (int64_t)(.5f + 1e5 * atof((const char *)prmc + u8ixcollector[2]));
+        *pi64lon_100k = (int64_t)(.5f + 1e5 * atof((const char *)prmc + u8ixcollector[4]));
+    }
+
+    return 1;
+}
+
+/// @brief Times NMEAparse & LegacyRMC over the corpus.
+/// @return The count of parse errors.
+static uint32_t Benchmark(char **ppsz_lines, uint32_t u32nlines, uint32_t u32passes)
+{
+    uint32_t *pu32len = calloc(u32nlines, sizeof(uint32_t));
+    uint64_t u64chars = 0;
+    for(uint32_t i = 0; i < u32nlines; ++i)
+    {
+        pu32len[i] = strlen(ppsz_lines[i]);
+        u64chars += pu32len[i];
+    }
+
+    uint32_t u32types[eNMEA_ZDA + 1] = {0}, u32errors = 0;
+    volatile int64_t i64sink = 0;
+    NMEAsentence snt;
+    uint64_t tm0 = NowNs();
+    for(uint32_t pass = 0; pass < u32passes; ++pass)
+    {
+        for(uint32_t i = 0; i < u32nlines; ++i)
+        {
+            const int itype = NMEAparse(ppsz_lines[i], pu32len[i], &snt);
+            if(itype < 0)
+            {
+                ++u32errors;
+            }
+            else
+            {
+                ++u32types[itype];
+            }
+            i64sink += snt._i32_lat_1e7;
+        }
+    }
+    const uint64_t u64ns = NowNs() - tm0;
+
+    /* RMC only, both parsers. */
+    uint32_t u32rmc = 0;
+    for(uint32_t i = 0; i < u32nlines; ++i)
+    {
+        if(pu32len[i] > 6 && !memcmp(ppsz_lines[i] + 3, "RMC", 3))
+        {
+            ppsz_lines[u32rmc] = ppsz_lines[i];
+            pu32len[u32rmc++] = pu32len[i];
+        }
+    }
+
+    tm0 = NowNs();
+    for(uint32_t pass = 0; pass < u32passes; ++pass)
+    {
+        for(uint32_t i = 0; i < u32rmc; ++i)
+        {
+            NMEAparse(ppsz_lines[i], pu32len[i], &snt);
+            i64sink += snt._i32_lat_1e7;
+        }
+    }
+    const uint64_t u64rmc_ns = NowNs() - tm0;
+
+    uint8_t buff[eGPSrxLineLen];
+    int64_t i64lat = 0, i64lon = 0;
+    tm0 = NowNs();
+    for(uint32_t pass = 0; pass < u32passes; ++pass)
+    {
+        for(uint32_t i = 0; i < u32rmc; ++i)
+        {
+            memcpy(buff, ppsz_lines[i], pu32len[i] + 1); /* As the framer, 0 terminated. */
+            LegacyRMC(buff, &i64lat, &i64lon);
+            i64sink += i64lat;
+        }
+    }
+    const uint64_t u64legacy_ns = NowNs() - tm0;
+
+    const double dsent = (double)u32nlines * u32passes;
+    const double drmc = (double)u32rmc * u32passes;
+    printf("Corpus:     %u sentences x %u passes, %.1f MB\n", u32nlines, u32passes,
+           1e-6 * u64chars * u32passes);
+    printf("Decoded:    RMC %u GGA %u GSA %u ZDA %u other %u, errors %u\n",
+           u32types[eNMEA_RMC], u32types[eNMEA_GGA], u32types[eNMEA_GSA], u32types[eNMEA_ZDA],
+           u32types[eNMEA_UNKNOWN], u32errors);
+    printf("NMEAparse:  %.0f sentences/s, %.1f MB/s\n", 1e9 * dsent / u64ns,
+           1e3 * u64chars * u32passes / u64ns);
+    printf("RMC only:   NMEAparse %.0f sentences/s, former %.0f sentences/s\n",
+           1e9 * drmc / u64rmc_ns, 1e9 * drmc / u64legacy_ns);
+
+    free(pu32len);
+
+    return u32errors;
+}
+
+/// @brief Validates the checksum of NMEA sentence.
+/// @return 0 if OK.
+static int CheckSum(const char *psz)
+{
+    const char *pstar = strrchr(psz, '*');
+    if('$' != *psz || !pstar)
+    {
+        return -1;
+    }
+
+    uint8_t chksum = 0;
+    for(const char *p = psz + 1; p != pstar; ++p)
+    {
+        chksum ^= *p;
+    }
+
+    return strtoul(pstar + 1, NULL, 16) == chksum ? 0 : -1;
+}
+
+/// @brief The sink of sentences framed, it matches them against the stream.
+static int OnSentence(void *pctx, uint8_t *pline, uint32_t u32len)
+{
+    FeedContext *pf = pctx;
+    ++pf->_u32_framed;
+
+    if(strlen((const char *)pline) != u32len || CheckSum((const char *)pline))
+    {
+        ++pf->_u32_bad;
+        return -1;
+    }
+
+    /* The slow reader may lose sentences, but not garble them. */
+    for(uint32_t i = 0; i < (pf->_is_slow ? pf->_u32_nlines : 1); ++i)
+    {
+        const uint32_t ix = (pf->_u32_ix + i) % pf->_u32_nlines;
+        if(!strcmp((const char *)pline, pf->_ppsz_lines[ix]))
+        {
+            pf->_u32_skipped += i;
+            pf->_u32_ix = ix + 1;
+
+            NMEAsentence snt;
+            const int itype = NMEAparse((const char *)pline, u32len, &snt);
+            if(itype < 0 || CheckParsed((const char *)pline, &snt))
+            {
+                if(++pf->_u32_parse_bad < 4)
+                {
+                    fprintf(stderr, "Parse error %d: %s\n", itype, pline);
+                }
+                return -1;
+            }
+            ++pf->_u32_parsed[itype];
+
+            return 0;
+        }
+    }
+
+    ++pf->_u32_bad;
+    if(pf->_u32_bad < 4)
+    {
+        fprintf(stderr, "Mismatch: %s\n", pline);
+    }
+
+    return -1;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t u32passes = 100;
+    unsigned seed = 1;
+    int is_slow = 0;
+    int is_bench = 0;
+
+    int opt;
+    while(-1 != (opt = getopt(argc, argv, "n:s:SB")))
+    {
+        switch(opt)
+        {
+            case 'n': u32passes = strtoul(optarg, NULL, 10); break;
+            case 's': seed = strtoul(optarg, NULL, 10); break;
+            case 'S': is_slow = 1; break;
+            case 'B': is_bench = 1; break;
+            default: Usage(); return 1;
+        }
+    }
+
+    if(optind >= argc)
+    {
+        Usage();
+        return 1;
+    }
+
+    if(is_bench)
+    {
+        char **ppsz_lines = NULL;
+        uint32_t u32nlines = 0;
+        for(int i = optind; i < argc; ++i)
+        {
+            long lfsize;
+            char *pfile = LoadFile(argv[i], &lfsize);
+            if(!pfile || !(ppsz_lines = realloc(ppsz_lines, (u32nlines + lfsize) * sizeof(char *)))
+               || !SplitLines(pfile, ppsz_lines, &u32nlines))
+            {
+                return 1;
+            }
+        }
+
+        return Benchmark(ppsz_lines, u32nlines, u32passes) ? 1 : 0;
+    }
+
+    long lsize;
+    char *pstream = LoadFile(argv[optind], &lsize);
+    char *plines = pstream ? strdup(pstream) : NULL;
+    if(!plines)
+    {
+        return 1;
+    }
+
+    /* The sentences expected, w/o line endings. */
+    FeedContext feed = { ._is_slow = is_slow };
+    feed._ppsz_lines = calloc(lsize, sizeof(char *));
+    if(!SplitLines(plines, feed._ppsz_lines, &feed._u32_nlines))
+    {
+        return 1;
+    }
+
+    /* The count of chars received starts close to its wrap. */
+    srand(seed);
+    uint32_t u32rcvd = 0u - (uint32_t)lsize / 2;
+    GPSrxRing rx;
+    GPSrxInit(&rx, su8Ring, u32rcvd);
+
+    const uint32_t u32chunk_max = is_slow ? 3 * eGPSrxRingLen : eGPSrxLagMax;
+    const uint64_t u64total = (uint64_t)u32passes * lsize;
+    uint64_t u64sent = 0;
+    while(u64sent < u64total)
+    {
+        uint32_t u32chunk = 1 + rand() % u32chunk_max;
+        if(u32chunk > u64total - u64sent)
+        {
+            u32chunk = u64total - u64sent;
+        }
+        for(uint32_t i = 0; i < u32chunk; ++i, ++u64sent)
+        {
+            su8Ring[u32rcvd++ & (eGPSrxRingLen - 1)] = pstream[u64sent % lsize];
+        }
+        GPSrxFrame(&rx, u32rcvd, OnSentence, NULL, &feed);
+    }
+
+    /* Any single char corrupted must be caught by the checksum. */
+    for(uint32_t i = 0; i < feed._u32_nlines; ++i)
+    {
+        char buf[eGPSrxLineLen];
+        const uint32_t u32len = strlen(feed._ppsz_lines[i]);
+        memcpy(buf, feed._ppsz_lines[i], u32len + 1);
+        buf[1 + rand() % (strchr(buf, '*') - buf - 1)] ^= 1 << (rand() % 7);
+
+        NMEAsentence snt;
+        if(NMEAparse(buf, u32len, &snt) >= 0)
+        {
+            if(++feed._u32_parse_bad < 4)
+            {
+                fprintf(stderr, "Corruption missed: %s\n", buf);
+            }
+        }
+    }
+
+    const uint32_t u32expected = u32passes * feed._u32_nlines;
+    printf("Stream:     %u sentences x %u passes, %llu chars\n", feed._u32_nlines, u32passes,
+           (unsigned long long)u64total);
+    printf("Framed:     %u, skipped %u, bad %u, overruns %u\n", feed._u32_framed,
+           feed._u32_skipped, feed._u32_bad, rx._u32_overruns);
+    printf("Parsed:     RMC %u GGA %u GSA %u ZDA %u other %u, errors %u\n",
+           feed._u32_parsed[eNMEA_RMC], feed._u32_parsed[eNMEA_GGA], feed._u32_parsed[eNMEA_GSA],
+           feed._u32_parsed[eNMEA_ZDA], feed._u32_parsed[eNMEA_UNKNOWN], feed._u32_parse_bad);
+
+    int ifail = feed._u32_bad != 0 || feed._u32_parse_bad != 0;
+    if(is_slow)
+    {
+        ifail |= !rx._u32_overruns;
+        ifail |= feed._u32_framed >= u32expected;
+    }
+    else
+    {
+        ifail |= rx._u32_overruns != 0;
+        ifail |= feed._u32_framed != u32expected || rx._u32_sentences != u32expected;
+    }
+    printf("%s\n", ifail ? "FAILED" : "OK");
+
+    free(feed._ppsz_lines);
+    free(plines);
+    free(pstream);
+
+    return ifail;
+}
@@ -0,0 +1,193 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  piosim.c - Cycle accurate model of dco PIO program.
+//
+//
+//  DESCRIPTION
+//
+//      The model reproduces the timing of `dco` program of dco2.pio and
+//  accumulates the statistics of rising edges: mean frequency, period jitter
+//  and time interval error (TIE) against the ideal clock. It counts the edges
+//  within the gate as `dco_count` program does.
+//
+//  PLATFORM
+//      Linux host.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//      Rev 0.2   16 Oct 2026   Edge counter of `dco_count`.
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "piosim.h"
+
+#include <math.h>
+#include <string.h>
+
+/// @brief Initializes the model.
+/// @param ps Ptr to model context.
+/// @param bits Bits per count pulled by `out y, bits`, 32 or 8.
+/// @param ideal_period The ideal period of output, CPU CLK ticks.
+/// @param pfedges Stream to dump rising edge ticks to, NULL if not needed.
+void PioSimInit(PioSim *ps, int bits, double ideal_period, FILE *pfedges)
+{
+    memset(ps, 0, sizeof(PioSim));
+
+    ps->_bits = bits;
+    ps->_delay = eSimDelayCycles;
+    ps->_ideal_period = ideal_period;
+    ps->_pfedges = pfedges;
+}
+
+/// @brief Accounts the next edge of output.
+/// @param ps Ptr to model context.
+/// @param u64tick The sysclk tick of the edge.
+static void PioSimEdge(PioSim *ps, uint64_t u64tick)
+{
+    ps->_level ^= 1;
+    if(!ps->_level)
+    {
+        if(ps->_u64_edges)
+        {
+            ps->_u64_high_ticks += u64tick - ps->_u64_edge_last;
+        }
+        return;
+    }
+
+    if(ps->_pfedges)
+    {
+        fprintf(ps->_pfedges, "%llu\n", (unsigned long long)u64tick);
+    }
+
+    /* RPix: `dco_count` samples the pin every 3 ticks, the half period is 4
+       ticks at least, so every edge is seen by the first sample after it. */
+    if(u64tick > ps->_u64_gate_open && u64tick <= ps->_u64_gate_close)
+    {
+        ++ps->_u64_gate_edges;
+    }
+
+    if(ps->_u64_edges)
+    {
+        const double dp = (double)(u64tick - ps->_u64_edge_last) - ps->_ideal_period;
+        ps->_sum_dp += dp;
+        ps->_sum_dp2 += dp * dp;
+        if(1 == ps->_u64_edges || dp < ps->_dp_min) ps->_dp_min = dp;
+        if(1 == ps->_u64_edges || dp > ps->_dp_max) ps->_dp_max = dp;
+
+        const double tie = (double)(u64tick - ps->_u64_edge0)
+                           - (double)ps->_u64_edges * ps->_ideal_period;
+        const double i = (double)ps->_u64_edges;
+        ps->_sum_tie += tie;
+        ps->_sum_tie2 += tie * tie;
+        ps->_sum_itie += i * tie;
+        ps->_sum_i2 += i * i;
+        if(fabs(tie) > ps->_tie_max) ps->_tie_max = fabs(tie);
+    }
+    else
+    {
+        ps->_u64_edge0 = u64tick;
+    }
+
+    ps->_u64_edge_last = u64tick;
+    ++ps->_u64_edges;
+}
+
+/// @brief Feeds the word to the model as `out y, bits` of PIO would pull it.
+/// @brief Every count yields half periods of (count + PIO delay) ticks.
+/// @param ps Ptr to model context.
+/// @param ui32word The word pushed to PIO TX FIFO.
+void PioSimPut(PioSim *ps, uint32_t ui32word)
+{
+    if(32 == ps->_bits)
+    {
+        /* RPix: out y, 32; then four `mov x, y; jmp x-- LOOPn; set pins`. */
+        for(int i = 0; i < 4; ++i)
+        {
+            ps->_u64_tick += (uint64_t)ui32word + ps->_delay;
+            PioSimEdge(ps, ps->_u64_tick);
+        }
+    }
+    else
+    {
+        for(int i = 0; i < 32; i += ps->_bits)
+        {
+            const uint32_t y = (ui32word >> i) & ((1U << ps->_bits) - 1U);
+            ps->_u64_tick += (uint64_t)y + ps->_delay;
+            PioSimEdge(ps, ps->_u64_tick);
+        }
+    }
+}
+
+/// @brief Prints the statistics of output.
+/// @param ps Ptr to model context.
+/// @param ui32clk_hz The CPU CLK freq., Hz.
+/// @param pf Output stream.
+void PioSimReport(const PioSim *ps, uint32_t ui32clk_hz, FILE *pf)
+{
+    if(ps->_u64_edges < 2)
+    {
+        fprintf(pf, "Not enough edges\n");
+        return;
+    }
+
+    /* RPix: The mean period is the ideal one plus the slope of TIE, which is
+       fitted by least squares over all edges, so the result is not limited
+       by the jitter of the first and the last edge. */
+    const double n = (double)(ps->_u64_edges - 1);
+    const double sum_i = n * (n + 1.) / 2.;
+    const double slope = (n * ps->_sum_itie - sum_i * ps->_sum_tie)
+                         / (n * ps->_sum_i2 - sum_i * sum_i);
+    const double mean_period = ps->_ideal_period + slope;
+    const double ideal_frq = ui32clk_hz / ps->_ideal_period;
+    const double mean_frq = ui32clk_hz / mean_period;
+    const double dp_mean = ps->_sum_dp / n;
+    const double dp_var = ps->_sum_dp2 / n - dp_mean * dp_mean;
+    const double dp_rms = dp_var > 0. ? sqrt(dp_var) : 0.;
+    const double tick_ns = 1e9 / ui32clk_hz;
+
+    fprintf(pf, "Rising edges:          %llu\n", (unsigned long long)ps->_u64_edges);
+    fprintf(pf, "Ideal frequency:       %.6f Hz\n", ideal_frq);
+    fprintf(pf, "Mean frequency:        %.6f Hz\n", mean_frq);
+    fprintf(pf, "Mean frequency error:  %.6f Hz (%.3f ppb)\n",
+            mean_frq - ideal_frq, 1e9 * (mean_frq - ideal_frq) / ideal_frq);
+    fprintf(pf, "Period jitter RMS:     %.4f ticks (%.3f ns)\n", dp_rms, tick_ns * dp_rms);
+    fprintf(pf, "Period jitter p-p:     %.4f ticks (%.3f ns)\n",
+            ps->_dp_max - ps->_dp_min, tick_ns * (ps->_dp_max - ps->_dp_min));
+    fprintf(pf, "TIE RMS:               %.4f ticks (%.3f ns)\n",
+            sqrt(ps->_sum_tie2 / n), tick_ns * sqrt(ps->_sum_tie2 / n));
+    fprintf(pf, "TIE max:               %.4f ticks (%.3f ns)\n",
+            ps->_tie_max, tick_ns * ps->_tie_max);
+    fprintf(pf, "Duty cycle:            %.4f %%\n",
+            100. * ps->_u64_high_ticks / (double)(ps->_u64_edge_last - ps->_u64_edge0));
+}
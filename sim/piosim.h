@@ -0,0 +1,97 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  piosim.h - Cycle accurate model of dco PIO program.
+//
+//
+//  DESCRIPTION
+//
+//      The model reproduces the timing of `dco` program of dco2.pio: every
+//  word pulled by `out y, 32` yields four half periods of y + PIOASM_DELAY_CYCLES
+//  CPU CLK cycles each. The `dco_duty` program of PioDCOWorkerDuty is modelled
+//  by the byte wide flavour of the same loop, which yields one level per byte.
+//
+//  PLATFORM
+//      Linux host.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//      Rev 0.2   16 Oct 2026   Edge counter of `dco_count`.
+//      Rev 0.3   17 Oct 2026   Byte wide flavour is of `dco_duty` only.
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef PIOSIM_H_
+#define PIOSIM_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+enum
+{
+    eSimDelayCycles = 4,        /* Must match PIOASM_DELAY_CYCLES of dco2.pio. */
+    eSimDutyDelayCycles = 3     /* Must match PIOASM_DUTY_DELAY_CYCLES of dco2.pio. */
+};
+
+typedef struct
+{
+    uint64_t _u64_tick;         /* Sysclk tick of the last edge. */
+    int _level;                 /* Output pin level. */
+    int _bits;                  /* Bits per count: 32 for dco, 8 for dco_duty. */
+    int _delay;                 /* PIO delay per level, cycles. */
+    uint64_t _u64_high_ticks;   /* Sum of high level durations. */
+
+    uint64_t _u64_edges;        /* Count of rising edges emitted. */
+    uint64_t _u64_edge0;        /* Tick of the first rising edge. */
+    uint64_t _u64_edge_last;    /* Tick of the last rising edge. */
+
+    double _ideal_period;       /* Ideal period of output, ticks. */
+    double _sum_dp, _sum_dp2;   /* Sum of period deviation and its square. */
+    double _dp_min, _dp_max;    /* Extremes of period deviation, ticks. */
+    double _sum_tie, _sum_tie2; /* Sum of time interval error and its square. */
+    double _sum_itie, _sum_i2;  /* Sums of linear regression of TIE vs edge index. */
+    double _tie_max;            /* Max abs time interval error, ticks. */
+
+    uint64_t _u64_gate_open;    /* Gate of `dco_count` model, rising edges in */
+    uint64_t _u64_gate_close;   /* (open, close] ticks are counted. */
+    uint64_t _u64_gate_edges;   /* Rising edges counted. */
+
+    FILE *_pfedges;             /* Stream to dump rising edge ticks, or NULL. */
+
+} PioSim;
+
+void PioSimInit(PioSim *ps, int bits, double ideal_period, FILE *pfedges);
+void PioSimPut(PioSim *ps, uint32_t ui32word);
+void PioSimReport(const PioSim *ps, uint32_t ui32clk_hz, FILE *pf);
+
+#endif
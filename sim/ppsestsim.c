@@ -0,0 +1,250 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  ppsestsim.c - Off-target comparison of estimators of CPU CLK error of PPS.
+//
+//
+//  DESCRIPTION
+//
+//      The tool makes synthetic PPS timestamps of a CPU CLK which is off by some
+//  ppm, drifts and wanders; the timestamps are taken by the 1 us timer of PPS IRQ
+//  (with IRQ latency jitter) or by PIO capture of 2 CPU CLK cycles resolution, the
+//  GPS pulses themselves jitter a bit. Some pulses are glitched (off by tens to
+//  hundreds of us, within the bound of the legacy window) & some are missed. Each
+//  estimator of gpstime/ppsest.h is fed the intervals as GPStimeProcess does, the
+//  error of its estimate against the true CLK error is tracked.
+//      Reported by source, scenario & estimator: the pulses to converge (the error
+//  stays within the bound for 10 pulses), the RMS & max error over the second
+//  half of the run, the mean 1 sigma reported & the rejects. The run fails unless
+//  the Kalman one converges faster than the legacy window, its steady error is
+//  within 10% of the window's on clean pulses (the drift lag of the memory) and
+//  lower & bounded with glitches.
+//
+//  USAGE
+//      ppsestsim [-n pulses] [-s seed] [-d drift_ppb_per_s] [-v]
+//
+//      -n  Pulses per run, 3600 by default.
+//      -s  Seed, 1 by default.
+//      -d  CLK drift, ppb per s, 0.01 by default.
+//      -v  Dumps the error of each pulse, `pulse source scenario kind err_ppb`.
+//
+//  PLATFORM
+//      Linux host.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+
+#include "../gpstime/ppsest.h"
+
+enum
+{
+    eStaySpan = 10,                             /* Pulses within the bound to converge. */
+    eSources = 2,
+    eScenarios = 2
+};
+
+typedef struct
+{
+    const char *_pname;
+    double _dres_ps;                            /* Timestamp resolution. */
+    double _dlat_ps;                            /* Max IRQ latency jitter, uniform. */
+    uint32_t _u32_sigma_ps;                     /* Fed to the estimator, as GPStime.h. */
+    uint32_t _u32_memory;
+    double _dbound_ppb;                         /* Convergence bound. */
+
+} Source;
+
+static const Source sSources[eSources] =
+{
+    { "TIMER", 1e6, 5e5, 500000, 128, 20. },    /* eGPSppsSigmaTimerPs, eGPSppsMemoryTimer. */
+    { "PIO", 2e12 / 270e6, 0., 3000, 24, 2. }   /* eGPSppsSigmaPIOps, eGPSppsMemoryPIO. */
+};
+
+static const char *spScenario[eScenarios] = { "clean", "glitch" };
+
+typedef struct
+{
+    uint32_t _u32_converged;                    /* The pulse, 0 if never. */
+    double _drms, _dmax;                        /* Over the second half. */
+    double _dsigma;                             /* The mean reported. */
+    uint32_t _u32_rejects;
+
+} Result;
+
+static double Gauss(void)
+{
+    return sqrt(-2. * log(1. - drand48())) * cos(2. * M_PI * drand48());
+}
+
+/// @brief Runs a pulse train through an estimator.
+static void Run(const Source *ps, int iscenario, PPSestKind kind, uint32_t u32n, double ddrift,
+                long lseed, int is_verbose, Result *pr)
+{
+    srand48(lseed);
+    memset(pr, 0, sizeof(Result));
+
+    PPSestimator est;
+    PPSestInit(&est, kind, ps->_u32_sigma_ps, ps->_u32_memory);
+
+    /* CLK error, ppb: the offset, the drift & random walk. */
+    double dppb = 2345.6, dphase_ps = 1234567.;
+    double dts_last = 0.;
+    int is_first = 1;
+    uint32_t u32stay = 0, nsteady = 0;
+    double dsum = 0., dsigma = 0.;
+    for(uint32_t k = 1; k <= u32n; ++k)
+    {
+        dppb += ddrift + .005 * Gauss();
+        dphase_ps += 1e3 * dppb;                /* ps per s. */
+
+        /* The GPS pulse jitters by 1 ns, the timestamp is taken by the source. */
+        double dt_ps = 1e12 * k + dphase_ps + 1e3 * Gauss() + ps->_dlat_ps * drand48();
+        if(1 == iscenario && 0 == lrand48() % 300 && k > 1)
+        {
+            dt_ps += (drand48() < .5 ? -1. : 1.) * (2e7 + 1.8e8 * drand48());
+        }
+        if(1 == iscenario && 0 == lrand48() % 500)
+        {
+            continue;                           /* Missed. */
+        }
+        const double dts = floor(dt_ps / ps->_dres_ps) * ps->_dres_ps;
+        if(is_first)
+        {
+            dts_last = dts;
+            is_first = 0;
+            continue;
+        }
+
+        const int64_t i64dt_ps = (int64_t)llround(dts - dts_last);
+        dts_last = dts;
+        PPSestInterval(&est, i64dt_ps);
+        if(!est._u8_is_valid)
+        {
+            continue;
+        }
+
+        const double derr = est._i64_ppb_1k * 1e-3 - dppb;
+        if(is_verbose)
+        {
+            printf("%u %s %s %s %.3f\n", k, ps->_pname, spScenario[iscenario], PPSestKindName(kind), derr);
+        }
+        if(fabs(derr) < ps->_dbound_ppb)
+        {
+            if(++u32stay == eStaySpan && !pr->_u32_converged)
+            {
+                pr->_u32_converged = k - eStaySpan + 1;
+            }
+        }
+        else
+        {
+            u32stay = 0;
+        }
+
+        if(k > u32n / 2)
+        {
+            dsum += derr * derr;
+            pr->_dmax = fabs(derr) > pr->_dmax ? fabs(derr) : pr->_dmax;
+            dsigma += est._i64_sigma_ppb_1k * 1e-3;
+            ++nsteady;
+        }
+    }
+
+    pr->_drms = sqrt(dsum / nsteady);
+    pr->_dsigma = dsigma / nsteady;
+    pr->_u32_rejects = est._u32_rejects;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t u32n = 3600;
+    long lseed = 1;
+    double ddrift = .01;
+    int is_verbose = 0;
+
+    int opt;
+    while(-1 != (opt = getopt(argc, argv, "n:s:d:v")))
+    {
+        switch(opt)
+        {
+            case 'n': u32n = strtoul(optarg, NULL, 10); break;
+            case 's': lseed = atol(optarg); break;
+            case 'd': ddrift = atof(optarg); break;
+            case 'v': is_verbose = 1; break;
+            default:
+                fprintf(stderr, "Usage: ppsestsim [-n pulses] [-s seed] [-d drift_ppb_per_s] [-v]\n");
+                return 1;
+        }
+    }
+
+    int ifail = 0;
+    if(!is_verbose)
+    {
+        printf("%-6s %-7s %-7s %9s %10s %10s %10s %8s\n", "source", "case", "kind", "converge",
+               "RMS ppb", "max ppb", "sigma ppb", "rejects");
+    }
+    for(int isrc = 0; isrc < eSources; ++isrc)
+    {
+        for(int isc = 0; isc < eScenarios; ++isc)
+        {
+            Result r[ePPSestKinds];
+            for(int kind = 0; kind < ePPSestKinds; ++kind)
+            {
+                Run(&sSources[isrc], isc, kind, u32n, ddrift, lseed, is_verbose, &r[kind]);
+                if(!is_verbose)
+                {
+                    printf("%-6s %-7s %-7s %9u %10.3f %10.3f %10.3f %8u\n", sSources[isrc]._pname,
+                           spScenario[isc], PPSestKindName(kind), r[kind]._u32_converged, r[kind]._drms,
+                           r[kind]._dmax, r[kind]._dsigma, r[kind]._u32_rejects);
+                }
+            }
+
+            const Result *pk = &r[ePPSestKalman], *pw = &r[ePPSestWindow];
+            ifail |= !pk->_u32_converged || (pw->_u32_converged && pk->_u32_converged >= pw->_u32_converged);
+            ifail |= pk->_drms > (isc ? 1. : 1.1) * pw->_drms || pk->_dmax > 2 * sSources[isrc]._dbound_ppb;
+        }
+    }
+    if(!is_verbose)
+    {
+        printf("%s\n", ifail ? "FAILED" : "OK");
+    }
+
+    return ifail;
+}
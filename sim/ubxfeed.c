@@ -0,0 +1,488 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  ubxfeed.c - Off-target check of UBX decoding & TIM-TP qErr correction.
+//
+//
+//  DESCRIPTION
+//
+//      The tool feeds a canned capture of u-blox receiver (NMEA interleaved with
+//  UBX NAV-STATUS, NAV-TIMEUTC & TIM-TP) to GPSrxFrame in random size chunks, as
+//  GPStimeProcess does, and checks the frames decoded: the counts, the checksum
+//  error planted, TIM-TP time of week against NAV-TIMEUTC. Then it timestamps
+//  the PPS by a timer of the frequency given, the pulses being off the ideal time
+//  by qErr of TIM-TP, and reports the ppb noise of the PPS period, per second and
+//  per the sliding window of GPStime, as is and corrected by qErr.
+//      -P runs the pulses through an instruction level model of `pps_capture`
+//  PIO program (dco2.pio) clocked by CPU CLK, its count wrapping every ~32 s, and
+//  feeds the intervals of PPScapPulse to the Kalman estimator (ppsest.h): the
+//  pulses it takes to converge within 2 ppb and the steady state ppb error are
+//  reported.
+//
+//  USAGE
+//      ubxfeed [-s seed] [-c timer_Hz] [-P] file.ubx
+//
+//      -s  Seed of chunk sizes, 1 by default.
+//      -c  The PPS timer freq., Hz; by default 1 MHz (GetUptime64) & 270 MHz
+//          (CPU CLK) are both reported, the latter must gain from qErr.
+//      -P  Check of PIO capture of PPS at 270 MHz CPU CLK.
+//
+//  PLATFORM
+//      Linux host.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//      Rev 0.2   17 Oct 2026   Outage longer than the wrap of PIO count.
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+
+#include "../gpstime/gpsrx.h"
+#include "../gpstime/nmea.h"
+#include "../gpstime/ubx.h"
+#include "../gpstime/ppscap.h"
+#include "../gpstime/ppsest.h"
+
+enum
+{
+    eMaxPulses = 4096,
+    eWindow = 32,                               /* The sliding window of GPStime, s. */
+    eGPSepochUNIX = 315964800,                  /* 1980-01-06. */
+    eConvergePPB = 2                            /* PIO capture converged, ppb. */
+};
+
+/* `pps_capture` of dco2.pio, instruction by instruction. */
+typedef enum
+{
+    ePioMovXnot, ePioJmpPin, ePioJmpXdec, ePioJmp, ePioInX
+} PioOp;
+
+typedef struct
+{
+    PioOp _op;
+    uint8_t _u8_target;
+} PioInstr;
+
+static const PioInstr sPPScapture[] =
+{
+    { ePioMovXnot, 0 },                         /*  0     mov x, ~null */
+    { ePioJmpPin, 7 },                          /*  1 HIGH: jmp pin HIGH1 */
+    { ePioJmpXdec, 3 },                         /*  2     jmp x-- LOW */
+    { ePioJmpPin, 10 },                         /*  3 LOW: jmp pin RISE */
+    { ePioJmpXdec, 3 },                         /*  4     jmp x-- LOW */
+    { ePioJmpXdec, 6 },                         /*  5     jmp x-- LOWW */
+    { ePioJmp, 3 },                             /*  6 LOWW: jmp LOW */
+    { ePioJmpXdec, 1 },                         /*  7 HIGH1: jmp x-- HIGH */
+    { ePioJmpXdec, 9 },                         /*  8     jmp x-- HIGHW */
+    { ePioJmp, 1 },                             /*  9 HIGHW: jmp HIGH */
+    { ePioJmpXdec, 11 },                        /* 10 RISE: jmp x-- RISE1 */
+    { ePioInX, 0 },                             /* 11 RISE1: in x, 32 */
+    { ePioJmpXdec, 1 }                          /* 12     jmp x-- HIGH */
+};
+
+enum
+{
+    ePioWrapTop = 12,
+    ePioWrapBottom = 1
+};
+
+typedef struct
+{
+    uint64_t _u64_cycle;                        /* CPU CLK cycles since the start. */
+    uint32_t _u32_pc;
+    uint32_t _u32_x;
+
+} PioSM;
+
+typedef struct
+{
+    uint32_t _u32_sentences, _u32_nmea_bad;
+    uint32_t _u32_status, _u32_timeutc, _u32_timtp, _u32_other;
+    uint32_t _u32_mismatch;                     /* TIM-TP tow vs NAV-TIMEUTC. */
+    uint32_t _u32_utc_last;                     /* Unix time of the last NAV-TIMEUTC. */
+
+    uint32_t _u32_npulses;                      /* The pulses seen, a NAV-TIMEUTC per each. */
+    int32_t _pi32_qerr_ps[eMaxPulses];          /* qErr by pulse. */
+    uint8_t _pu8_has_qerr[eMaxPulses];
+
+} FeedContext;
+
+static uint8_t su8Ring[eGPSrxRingLen];
+
+static void Usage(void)
+{
+    fprintf(stderr, "Usage: ubxfeed [-s seed] [-c timer_Hz] [-P] file.ubx\n");
+}
+
+/// @brief The sink of NMEA sentences, they should parse.
+static int OnSentence(void *pctx, uint8_t *pline, uint32_t u32len)
+{
+    FeedContext *pf = pctx;
+    ++pf->_u32_sentences;
+
+    NMEAsentence snt;
+    if(NMEAparse((const char *)pline, u32len, &snt) < 0)
+    {
+        ++pf->_u32_nmea_bad;
+        return -1;
+    }
+
+    return 0;
+}
+
+/// @brief The sink of UBX frames.
+static int OnUBX(void *pctx, const UBXparser *pu)
+{
+    FeedContext *pf = pctx;
+
+    UBXnavStatus sts;
+    UBXnavTimeUTC utc;
+    UBXtimTP tp;
+    if(!UBXdecodeNavStatus(pu, &sts))
+    {
+        ++pf->_u32_status;
+        pf->_u32_mismatch += !(sts._u8_flags & 1) || 3 != sts._u8_gps_fix;
+    }
+    else if(!UBXdecodeNavTimeUTC(pu, &utc))
+    {
+        /* A solution per pulse. */
+        ++pf->_u32_timeutc;
+        pf->_u32_utc_last = UBXtimeUTC2UNIX(&utc);
+        pf->_u32_mismatch += !pf->_u32_utc_last;
+        if(pf->_u32_npulses < eMaxPulses - 1)
+        {
+            ++pf->_u32_npulses;
+        }
+    }
+    else if(!UBXdecodeTimTP(pu, &tp))
+    {
+        /* It describes the next pulse, which is 1 s past the last solution. */
+        ++pf->_u32_timtp;
+        const uint32_t u32gps = eGPSepochUNIX + 604800u * tp._u16_week + tp._u32_tow_ms / 1000;
+        pf->_u32_mismatch += u32gps - eUBXgpsUTCleapS != pf->_u32_utc_last + 1 || tp._u32_tow_ms % 1000;
+
+        pf->_pi32_qerr_ps[pf->_u32_npulses] = tp._i32_qerr_ps;
+        pf->_pu8_has_qerr[pf->_u32_npulses] = 1;
+    }
+    else
+    {
+        ++pf->_u32_other;
+    }
+
+    return 0;
+}
+
+/// @brief Timestamps the pulses by a timer, reports ppb noise of the period.
+/// @param pf The pulses & their qErr.
+/// @param dclk_hz The timer freq., Hz.
+/// @param pdrms_raw, pdrms_cor Ptr to RMS of ppb per second, as is & corrected.
+static void PPSnoise(const FeedContext *pf, double dclk_hz, double *pdrms_raw, double *pdrms_cor)
+{
+    const double dclk_err = 2.3456e-6;          /* The timer is off by 2.3456 ppm. */
+    const double dps_per_tick = 1e12 / dclk_hz;
+    const double doffset_ps = 123456789.;
+
+    static double dts[eMaxPulses], dtc[eMaxPulses];
+    for(uint32_t k = 1; k <= pf->_u32_npulses; ++k)
+    {
+        /* The actual pulse = ideal + qErr, it's caught by the next tick. */
+        const double dactual_ps = 1e12 * k + pf->_pi32_qerr_ps[k] + doffset_ps;
+        const double dticks = ceil(dactual_ps * (1. + dclk_err) / dps_per_tick);
+        dts[k] = dticks * dps_per_tick / (1. + dclk_err);
+        dtc[k] = dts[k] - (pf->_pu8_has_qerr[k] ? pf->_pi32_qerr_ps[k] : 0);
+    }
+
+    double dsum_raw = 0., dsum_cor = 0., dwsum_raw = 0., dwsum_cor = 0.;
+    uint32_t n = 0, nw = 0;
+    for(uint32_t k = 2; k <= pf->_u32_npulses; ++k)
+    {
+        const double draw = (dts[k] - dts[k - 1] - 1e12) * 1e-3;
+        const double dcor = (dtc[k] - dtc[k - 1] - 1e12) * 1e-3;
+        dsum_raw += draw * draw;
+        dsum_cor += dcor * dcor;
+        ++n;
+
+        if(k > eWindow)
+        {
+            const double dwraw = (dts[k] - dts[k - eWindow] - eWindow * 1e12) * 1e-3 / eWindow;
+            const double dwcor = (dtc[k] - dtc[k - eWindow] - eWindow * 1e12) * 1e-3 / eWindow;
+            dwsum_raw += dwraw * dwraw;
+            dwsum_cor += dwcor * dwcor;
+            ++nw;
+        }
+    }
+
+    *pdrms_raw = sqrt(dsum_raw / n);
+    *pdrms_cor = sqrt(dsum_cor / n);
+    printf("Timer %9.0f Hz: ppb RMS per second %6.2f, corrected %6.2f; per %u s window %5.3f, corrected %5.3f\n",
+           dclk_hz, *pdrms_raw, *pdrms_cor, eWindow, sqrt(dwsum_raw / nw), sqrt(dwsum_cor / nw));
+}
+
+/// @brief Runs `pps_capture` until the next count is pushed.
+/// @param psm The state machine.
+/// @param u64rise, u64fall The cycle the pin rises at & falls at after.
+/// @return The count pushed.
+static uint32_t PioRunToPush(PioSM *psm, uint64_t u64rise, uint64_t u64fall)
+{
+    for(;;)
+    {
+        const uint64_t c = psm->_u64_cycle;
+        const int ipin = c >= u64rise && c < u64fall;
+
+        /* The idle loops are fast forwarded while far from an edge & X wrap. */
+        const uint64_t u64edge = c < u64rise ? u64rise : u64fall;
+        if((3 == psm->_u32_pc && !ipin) || (1 == psm->_u32_pc && ipin))
+        {
+            const uint64_t u64n = (u64edge - c) / 2;
+            const uint64_t u64skip = u64n < psm->_u32_x ? u64n : psm->_u32_x;
+            if(u64skip > 4)
+            {
+                psm->_u32_x -= u64skip - 4;
+                psm->_u64_cycle += 2 * (u64skip - 4);
+                continue;
+            }
+        }
+
+        const PioInstr *pi = &sPPScapture[psm->_u32_pc];
+        uint32_t u32next = psm->_u32_pc == ePioWrapTop ? ePioWrapBottom : psm->_u32_pc + 1;
+        int ipushed = 0;
+        switch(pi->_op)
+        {
+            case ePioMovXnot:
+                psm->_u32_x = ~0u;
+            break;
+
+            case ePioJmpPin:
+                if(ipin)
+                {
+                    u32next = pi->_u8_target;
+                }
+            break;
+
+            case ePioJmpXdec:
+                if(psm->_u32_x--)
+                {
+                    u32next = pi->_u8_target;
+                }
+            break;
+
+            case ePioJmp:
+                u32next = pi->_u8_target;
+            break;
+
+            case ePioInX:
+                ipushed = 1;
+            break;
+        }
+        ++psm->_u64_cycle;
+        psm->_u32_pc = u32next;
+
+        if(ipushed)
+        {
+            return psm->_u32_x;
+        }
+    }
+}
+
+/// @brief Captures the pulses by `pps_capture`, feeds them to PPScapPulse & the estimator.
+/// @param pf The pulses & their qErr.
+/// @return 0 if converged within eConvergePPB & steady.
+static int PPScapCheck(const FeedContext *pf)
+{
+    const double dclk_hz = 270e6;
+    const double dclk_err = 2.3456e-6;
+    const double dtrue_ppb = dclk_err * 1e9;
+    const double doffset_ps = 123456789.;
+
+    PioSM sm = { 0, 0, 0 };
+    PPScapture cap;
+    PPScapInit(&cap, (uint32_t)dclk_hz);
+    PPSestimator est;
+    PPSestInit(&est, ePPSestKalman, 3000, 24);   /* eGPSppsSigmaPIOps, eGPSppsMemoryPIO. */
+
+    uint32_t u32converged = 0, n = 0, nwraps = 0;
+    uint32_t u32count_last = ~0u;
+    double dsum = 0., dmax = 0.;
+    for(uint32_t k = 1; k <= pf->_u32_npulses; ++k)
+    {
+        /* The actual pulse = ideal + qErr, 100 ms long, on the timeline of CPU CLK. */
+        const double dactual_s = k + (pf->_pi32_qerr_ps[k] + doffset_ps) * 1e-12;
+        const uint64_t u64rise = (uint64_t)ceil(dactual_s * dclk_hz * (1. + dclk_err));
+        const uint64_t u64fall = u64rise + (uint64_t)(.1 * dclk_hz);
+
+        const uint32_t u32count = PioRunToPush(&sm, u64rise, u64fall);
+        nwraps += u32count > u32count_last;
+        u32count_last = u32count;
+
+        int64_t i64dt_ps;
+        if(!PPScapPulse(&cap, u32count, (uint64_t)(dactual_s * 1e6),
+                        pf->_pu8_has_qerr[k] ? pf->_pi32_qerr_ps[k] : 0, &i64dt_ps)
+           || PPSestInterval(&est, i64dt_ps) <= 0)
+        {
+            continue;
+        }
+
+        const double derr = est._i64_ppb_1k * 1e-3 - dtrue_ppb;
+        if(!u32converged && fabs(derr) < eConvergePPB)
+        {
+            u32converged = k;
+        }
+        if(k > 16)
+        {
+            dsum += derr * derr;
+            dmax = fabs(derr) > dmax ? fabs(derr) : dmax;
+            ++n;
+        }
+    }
+
+    /* RPix: The pulse after an outage longer than the wrap of count gives no interval,
+       the next one gives the right one. */
+    int iouts = 0;
+    for(uint32_t k = pf->_u32_npulses + 40; k <= pf->_u32_npulses + 41; ++k)
+    {
+        const uint64_t u64rise = (uint64_t)ceil(k * dclk_hz * (1. + dclk_err));
+        const uint32_t u32count = PioRunToPush(&sm, u64rise, u64rise + (uint64_t)(.1 * dclk_hz));
+        int64_t i64dt_ps;
+        const int is_dt = PPScapPulse(&cap, u32count, k * 1000000ULL, 0, &i64dt_ps);
+        iouts += k == pf->_u32_npulses + 40 ? is_dt
+                 : !is_dt || fabs(i64dt_ps * 1e-3 - 1e9 * (1. + dclk_err)) > 10.;
+    }
+
+    const double drms = sqrt(dsum / n);
+    printf("PIO capture: %u pulses, %u rejects, count wraps %u; within %d ppb at pulse %u, "
+           "steady ppb error RMS %5.3f max %5.3f, 40 s outage %s\n", cap._u32_pulses,
+           est._u32_rejects, nwraps, eConvergePPB, u32converged, drms, dmax,
+           iouts ? "FAILED" : "OK");
+
+    return !u32converged || u32converged > 8 || est._u32_rejects || !nwraps || dmax > eConvergePPB
+           || iouts;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned seed = 1;
+    double dclk_hz = 0.;
+    int is_pio = 0;
+
+    int opt;
+    while(-1 != (opt = getopt(argc, argv, "s:c:P")))
+    {
+        switch(opt)
+        {
+            case 's': seed = strtoul(optarg, NULL, 10); break;
+            case 'c': dclk_hz = atof(optarg); break;
+            case 'P': is_pio = 1; break;
+            default: Usage(); return 1;
+        }
+    }
+
+    if(optind >= argc)
+    {
+        Usage();
+        return 1;
+    }
+
+    FILE *pfs = fopen(argv[optind], "rb");
+    if(!pfs)
+    {
+        perror(argv[optind]);
+        return 1;
+    }
+    fseek(pfs, 0, SEEK_END);
+    const long lsize = ftell(pfs);
+    fseek(pfs, 0, SEEK_SET);
+    uint8_t *pstream = malloc(lsize);
+    if(!pstream || lsize != (long)fread(pstream, 1, lsize, pfs))
+    {
+        fprintf(stderr, "Can't read %s\n", argv[optind]);
+        return 1;
+    }
+    fclose(pfs);
+
+    static FeedContext feed;
+    GPSrxRing rx;
+    uint32_t u32rcvd = 0u - (uint32_t)lsize / 2;
+    GPSrxInit(&rx, su8Ring, u32rcvd);
+
+    srand(seed);
+    int isum = 0;
+    for(long lsent = 0; lsent < lsize;)
+    {
+        long lchunk = 1 + rand() % eGPSrxLagMax;
+        if(lchunk > lsize - lsent)
+        {
+            lchunk = lsize - lsent;
+        }
+        for(long i = 0; i < lchunk; ++i)
+        {
+            su8Ring[u32rcvd++ & (eGPSrxRingLen - 1)] = pstream[lsent++];
+        }
+        isum += GPSrxFrame(&rx, u32rcvd, OnSentence, OnUBX, &feed);
+    }
+
+    printf("NMEA:       %u sentences, %u bad\n", feed._u32_sentences, feed._u32_nmea_bad);
+    printf("UBX:        %u frames, %u errors; NAV-STATUS %u NAV-TIMEUTC %u TIM-TP %u other %u\n",
+           rx._ubx._u32_frames, rx._ubx._u32_errors, feed._u32_status, feed._u32_timeutc,
+           feed._u32_timtp, feed._u32_other);
+    printf("Mismatches: %u, overruns %u, errors counted %d\n", feed._u32_mismatch, rx._u32_overruns, -isum);
+
+    int ifail = feed._u32_nmea_bad || feed._u32_mismatch || rx._u32_overruns;
+    ifail |= !feed._u32_timtp || feed._u32_timeutc != feed._u32_status;
+    ifail |= (int)rx._ubx._u32_errors != -isum - (int)feed._u32_nmea_bad;
+
+    double drms_raw, drms_cor;
+    if(is_pio)
+    {
+        ifail |= PPScapCheck(&feed);
+    }
+    else if(dclk_hz > 0.)
+    {
+        PPSnoise(&feed, dclk_hz, &drms_raw, &drms_cor);
+    }
+    else
+    {
+        PPSnoise(&feed, 1e6, &drms_raw, &drms_cor);
+        PPSnoise(&feed, 270e6, &drms_raw, &drms_cor);
+        ifail |= drms_cor > .5 * drms_raw;
+    }
+    printf("%s\n", ifail ? "FAILED" : "OK");
+
+    free(pstream);
+
+    return ifail;
+}
@@ -0,0 +1,318 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Roman Piksaykin [piksaykin@gmail.com], R2BDY
+//  https://www.qrz.com/db/r2bdy
+//
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//  utcsim.c - Off-target check of UTC aligned to PPS.
+//
+//
+//  DESCRIPTION
+//
+//      The first part checks the civil date conversions of gpstime/nmea.h for
+//  every day of 1980...2100 at several times of day against a reference which
+//  counts the days of years & months one by one, and the round trip back.
+//      The second part makes a GPS receiver on a CPU CLK which is off by some ppm
+//  & drifts: PPS is timestamped by the 1 us timer with IRQ latency, the RMC of
+//  each second is processed some hundreds of ms later, now & then a single one
+//  after the next pulse. PPS drops out for a while, a pulse is glitched, the
+//  NMEA rate is 5 Hz for some time & a leap second is inserted. The UTC of
+//  random instants by gpstime/utcpps.h is compared to the true one, as well as
+//  the whole second of NMEA arrival used before. The run fails if an instant
+//  is off by more than the bound, but those of the leap second & 2 s after it.
+//
+//  USAGE
+//      utcsim [-n seconds] [-s seed] [-v]
+//
+//      -n  Seconds of the run, 86400 by default.
+//      -s  Seed, 1 by default.
+//      -v  Dumps the error of each instant, `s err_us`.
+//
+//  PLATFORM
+//      Linux host.
+//
+//  REVISION HISTORY
+//
+//      Rev 0.1   16 Oct 2026   Initial release
+//
+//  PROJECT PAGE
+//      https://github.com/RPiks/pico-hf-oscillator
+//
+//  LICENCE
+//      MIT License (http://www.opensource.org/licenses/mit-license.php)
+//
+//  Copyright (c) 2023 by Roman Piksaykin
+//
+//  Permission is hereby granted, free of charge,to any person obtaining a copy
+//  of this software and associated documentation files (the Software), to deal
+//  in the Software without restriction,including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY,WHETHER IN AN ACTION OF CONTRACT,TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+
+#include "../gpstime/nmea.h"
+#include "../gpstime/utcpps.h"
+
+enum
+{
+    eBoundUs = 5,                               /* Timer resolution & IRQ latency. */
+    eLatencyUs = 2,                             /* Max IRQ latency, uniform. */
+    eDropoutS = 20,                             /* PPS lost for. */
+    eFastS = 120                                /* 5 Hz NMEA for. */
+};
+
+typedef enum
+{
+    eEvPPS = 0,
+    eEvSentence,
+    eEvQuery
+
+} EventKind;
+
+typedef struct
+{
+    double _dt;                                 /* True time since the start, s. */
+    EventKind _kind;
+    int64_t _i64_second;                        /* The second the event belongs to. */
+    uint32_t _u32_frac_ms;                      /* Of the sentence. */
+
+} Event;
+
+static int IsLeap(uint32_t y)
+{
+    return (0 == y % 4 && 0 != y % 100) || 0 == y % 400;
+}
+
+/// @brief Checks the civil conversions over 1980...2100 against the day count.
+static int CheckCivil(void)
+{
+    static const uint32_t su32mdays[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    static const uint32_t su32tod[] = { 0, 1, 43200, 45296, 86399 };
+
+    uint32_t u32days = 0, u32checked = 0, u32errors = 0;
+    for(uint32_t y = 1970; y <= 2100; ++y)
+    {
+        for(uint32_t m = 1; m <= 12; ++m)
+        {
+            const uint32_t u32md = su32mdays[m - 1] + (2 == m && IsLeap(y));
+            for(uint32_t d = 1; d <= u32md; ++d, ++u32days)
+            {
+                if(y < 1980)
+                {
+                    continue;
+                }
+                for(uint32_t i = 0; i < sizeof(su32tod) / sizeof(su32tod[0]); ++i)
+                {
+                    const uint32_t u32ref = u32days * 86400 + su32tod[i];
+                    const uint32_t u32unix = NMEAcivil2UNIX(y, m, d, su32tod[i]);
+
+                    NMEAcivil cv;
+                    NMEAunix2civil(u32ref, &cv);
+                    const int is_bad = u32unix != u32ref || cv._u16_year != y || cv._u8_month != m
+                                    || cv._u8_day != d
+                                    || (uint32_t)(cv._u8_hour * 3600 + cv._u8_min * 60 + cv._u8_sec) != su32tod[i];
+                    if(is_bad && u32errors++ < 10)
+                    {
+                        printf("%04u-%02u-%02u %5u: %u, expected %u, back %04u-%02u-%02u %02u:%02u:%02u\n",
+                               y, m, d, su32tod[i], u32unix, u32ref, cv._u16_year, cv._u8_month, cv._u8_day,
+                               cv._u8_hour, cv._u8_min, cv._u8_sec);
+                    }
+                    ++u32checked;
+                }
+            }
+        }
+    }
+
+    /* 23:59:60 of a leap second is the next midnight. */
+    u32errors += NMEAcivil2UNIX(2016, 12, 31, 86400) != NMEAcivil2UNIX(2017, 1, 1, 0);
+
+    printf("civil 1980...2100: %u checked, %u errors\n", u32checked, u32errors);
+
+    return u32errors ? 1 : 0;
+}
+
+static int EventCmp(const void *pa, const void *pb)
+{
+    const double d = ((const Event *)pa)->_dt - ((const Event *)pb)->_dt;
+    return d < 0. ? -1 : d > 0.;
+}
+
+static double Gauss(void)
+{
+    return sqrt(-2. * log(1. - drand48())) * cos(2. * M_PI * drand48());
+}
+
+/// @brief The uptime of the true time by the timer, us fractional.
+static double Uptime(double dt)
+{
+    /* 2345.6 ppb fast, drifts by 0.01 ppb per s; started 1234.567 s ere the run. */
+    return 1e6 * (1234.567 + dt * (1. + 2345.6e-9) + .5e-11 * dt * dt);
+}
+
+static int32_t TruePPB(double dt)
+{
+    return (int32_t)lround(2345.6 + .01 * dt);
+}
+
+/// @brief Runs the receiver, the PPS ISR & the main loop.
+static int CheckPPS(uint32_t u32n, long lseed, int is_verbose)
+{
+    srand48(lseed);
+
+    /* The run ends a day: the leap second is 23:59:60 at u32n / 2. */
+    const int64_t i64leap = u32n / 2;
+    const uint32_t u32unix0 = NMEAcivil2UNIX(2016, 12, 31, 86400) - (uint32_t)i64leap;
+    const int64_t i64dropout = u32n / 4, i64glitch = u32n / 8, i64fast = 3 * (int64_t)u32n / 4;
+
+    Event *pev = calloc(8 * (size_t)u32n, sizeof(Event));
+    size_t nev = 0;
+    int was_late = 0;
+    for(int64_t k = 1; k < u32n; ++k)
+    {
+        if(k < i64dropout || k >= i64dropout + eDropoutS)
+        {
+            pev[nev++] = (Event){ k + 1e-9 * Gauss(), eEvPPS, k, 0 };
+        }
+        if(k == i64glitch)
+        {
+            pev[nev++] = (Event){ k + .3, eEvPPS, k, 0 };
+        }
+
+        const int is_fast = k >= i64fast && k < i64fast + eFastS;
+        for(uint32_t i = 0; i < (is_fast ? 5u : 1u); ++i)
+        {
+            const int is_late = !was_late && !i && drand48() < .01;
+            was_late = is_late ? 1 : (i ? was_late : 0);
+            const double ddelay = is_late ? 1.05 + .3 * drand48() : .08 + .6 * drand48();
+            pev[nev++] = (Event){ k + .2 * i + (is_fast ? .05 * drand48() : ddelay), eEvSentence, k, 200 * i };
+        }
+
+        pev[nev++] = (Event){ k + drand48(), eEvQuery, k, 0 };
+    }
+    qsort(pev, nev, sizeof(Event), EventCmp);
+
+    UTCpps utc;
+    UTCppsInit(&utc);
+    uint64_t u64pps_us = 0;
+    uint32_t u32nmea_unix = 0;
+    uint64_t u64nmea_us = 0;
+    uint32_t u32queries = 0, u32bad = 0, u32none = 0, u32skipped = 0;
+    double dmax = 0., dsum = 0., dlegacy_sum = 0., dlegacy_max = 0.;
+    for(size_t i = 0; i < nev; ++i)
+    {
+        const Event *pe = &pev[i];
+        const uint64_t u64now_us = (uint64_t)Uptime(pe->_dt);
+        const int32_t i32ppb = TruePPB(pe->_dt) + (int32_t)lround(2. * Gauss());
+        switch(pe->_kind)
+        {
+            case eEvPPS:
+                u64pps_us = (uint64_t)(Uptime(pe->_dt) + eLatencyUs * drand48());
+                break;
+
+            case eEvSentence:
+            {
+                /* The leap second reads 23:59:60, the same unix time as the next. */
+                const int64_t k = pe->_i64_second;
+                const uint32_t u32unix = u32unix0 + (uint32_t)(k - (k > i64leap));
+                if(!pe->_u32_frac_ms)
+                {
+                    u32nmea_unix = u32unix;
+                    u64nmea_us = u64now_us;
+                }
+                UTCppsLabel(&utc, u32unix, pe->_u32_frac_ms * 1000, u64pps_us, i32ppb, u64now_us);
+                break;
+            }
+
+            case eEvQuery:
+            {
+                ++u32queries;
+                if(pe->_dt >= i64leap && pe->_dt < i64leap + 3)
+                {
+                    ++u32skipped;
+                    break;
+                }
+                uint64_t u64utc_us;
+                if(UTCppsGet(&utc, u64pps_us, i32ppb, u64now_us, &u64utc_us))
+                {
+                    ++u32none;
+                    break;
+                }
+                const double dtrue_us = 1e6 * (u32unix0 + pe->_dt - (pe->_dt >= i64leap + 1));
+                const double derr = (double)u64utc_us - dtrue_us;
+                const double dlegacy = 1e6 * (u32nmea_unix + floor((u64now_us - u64nmea_us) * 1e-6)) - dtrue_us;
+                if(is_verbose)
+                {
+                    printf("%.6f %.3f\n", pe->_dt, derr);
+                }
+                if(fabs(derr) > eBoundUs && u32bad++ < 10)
+                {
+                    printf("t %.6f: off by %.1f us\n", pe->_dt, derr);
+                }
+                dmax = fabs(derr) > dmax ? fabs(derr) : dmax;
+                dsum += derr * derr;
+                dlegacy_max = fabs(dlegacy) > dlegacy_max ? fabs(dlegacy) : dlegacy_max;
+                dlegacy_sum += dlegacy * dlegacy;
+                break;
+            }
+        }
+    }
+    free(pev);
+
+    const uint32_t u32n_ok = u32queries - u32skipped - u32none;
+    printf("PPS: %u queries, %u ere the first label, %u at the leap second, labels %u, mismatches %u\n",
+           u32queries, u32none, u32skipped, utc._u32_labels, utc._u32_mismatches);
+    printf("PPS aligned:  RMS %10.3f us, max %10.3f us\n", sqrt(dsum / u32n_ok), dmax);
+    printf("NMEA arrival: RMS %10.3f us, max %10.3f us\n", sqrt(dlegacy_sum / u32n_ok), dlegacy_max);
+
+    return u32bad || u32none > 3 ? 1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t u32n = 86400;
+    long lseed = 1;
+    int is_verbose = 0;
+
+    int opt;
+    while(-1 != (opt = getopt(argc, argv, "n:s:v")))
+    {
+        switch(opt)
+        {
+            case 'n': u32n = strtoul(optarg, NULL, 10); break;
+            case 's': lseed = atol(optarg); break;
+            case 'v': is_verbose = 1; break;
+            default:
+                fprintf(stderr, "Usage: utcsim [-n seconds] [-s seed] [-v]\n");
+                return 1;
+        }
+    }
+    if(u32n < 1000)
+    {
+        fprintf(stderr, "At least 1000 seconds.\n");
+        return 1;
+    }
+
+    const int ifail = CheckCivil() | CheckPPS(u32n, lseed, is_verbose);
+    printf("%s\n", ifail ? "FAILED" : "OK");
+
+    return ifail;
+}
@@ -90,6 +90,7 @@
 #include "hardware/clocks.h"
 #include "hardware/vreg.h"
 #include "pico/multicore.h"
+#include "pico/flash.h"
 #include "pico/stdio/driver.h"
 #include "piodco/piodco.h"
 
@@ -107,6 +108,7 @@
 #define GEN_FRQ_HZ 28074000L  // 10m FT8
 
 PioDco DCO; /* External in order to access in both cores. */
+static volatile int siCore1Ready; /* DCO is set up by core1. */
 
 int main() {
   const uint32_t clkhz = PLL_SYS_MHZ * 1000000L;
@@ -122,12 +124,25 @@ int main() {
   gpio_init(PICO_DEFAULT_LED_PIN);
   gpio_set_dir(PICO_DEFAULT_LED_PIN, GPIO_OUT);
 
+  /* Load the configuration & calibration saved, core1 takes the freq. of it. */
+  ConfigLoad();
   multicore_launch_core1(core1_entry);
+  while (!siCore1Ready) {
+    tight_loop_contents();
+  }
+  ConfigRestore(&DCO);
 
   for (;;) {
     gpio_put(PICO_DEFAULT_LED_PIN, 0);
     sleep_ms(5);
     int r = HFconsoleProcess(phfc, 10);
+    PioDCOStatsPoll(&DCO);
+    if (DCO._pGPStime) {
+      GPStimeProcess(DCO._pGPStime);
+    }
+    PioDCOGpsdoPoll(&DCO);
+    ConsoleMeasurePoll();
+    ConfigPoll(&DCO);
     gpio_put(PICO_DEFAULT_LED_PIN, 1);
     sleep_ms(1);
   }
@@ -155,15 +170,42 @@ int main() {
 void core1_entry() {
   const uint32_t clkhz = PLL_SYS_MHZ * 1000000L;
 
+  /* Let core0 write flash, this core is parked in RAM meanwhile. */
+  flash_safe_execute_core_init();
+
   /* Initialize DCO */
+#ifdef DCO_DUTY_ENGINE
+  assert_(0 == PioDCOInitDuty(&DCO, 6, clkhz));
+#else
   assert_(0 == PioDCOInit(&DCO, 6, clkhz));
+#endif
 
-  /* Run DCO. */
-  PioDCOStart(&DCO);
+  /* Run DCO, core0 switches GPS disciplining on if it's saved so. */
+  PioDCOSetMode(&DCO, eDCOMODE_RUNNING);
 
-  /* Set initial freq. */
+  /* Set initial freq., the one saved if any. */
   assert_(0 == PioDCOSetFreq(&DCO, GEN_FRQ_HZ, 0u));
-
+  ConfigRestoreDCO(&DCO);
+  siCore1Ready = 1;
+
+#if defined(DCO_DUTY_ENGINE)
+  /* Run the DCO of 1/3 duty cycle, the strongest 3rd harmonic. It spins forever. */
+  PioDCOSetDuty(&DCO, 65536 / 3);
+  PioDCOWorkerDuty(&DCO);
+#elif defined(DCO_REPLAY_ENGINE)
+  /* Run the DCO replayed by DMA while the freq. has a short period. It spins forever. */
+  PioDCOWorkerReplay(&DCO);
+#elif defined(DCO_DMA_ENGINE)
+  /* Run the DCO fed by DMA, the core only wakes to refill its buffers. Above
+     CLK/16 the refill can't keep up, so the worker is run instead. */
+  if (PioDCOStartDMA(&DCO)) {
+    PioDCOWorker2(&DCO);
+  }
+  for (;;) {
+    __wfi();
+  }
+#else
   /* Run the main DCO algorithm. It spins forever. */
   PioDCOWorker2(&DCO);
+#endif
 }